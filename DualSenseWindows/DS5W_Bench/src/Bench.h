@@ -0,0 +1,40 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+namespace DS5WBench {
+	typedef void (*BenchmarkFunction)();
+
+	/// <summary>
+	/// Benchmark registered by DS5W_BENCHMARK, run by main() when its name contains the command line filter
+	/// </summary>
+	struct Benchmark {
+		const char* name;
+		BenchmarkFunction function;
+		Benchmark* next;
+
+		Benchmark(const char* name, BenchmarkFunction function);
+	};
+
+	/// <summary>
+	/// QueryPerformanceCounter time in seconds
+	/// </summary>
+	double seconds();
+
+	/// <summary>
+	/// Print one result line of the running benchmark
+	/// </summary>
+	void report(const char* label, double value, const char* unit);
+}
+
+/// <summary>
+/// Define and register a benchmark
+/// </summary>
+#define DS5W_BENCHMARK(name) \
+	static void name(); \
+	static DS5WBench::Benchmark name##_benchmark(#name, name); \
+	static void name()
@@ -0,0 +1,89 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Bench.h"
+
+#include <DualSenseWindows/DS_CRC32.h>
+#include <DualSenseWindows/DS5_Cpu.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace {
+	typedef UINT32 (*CrcKernel)(const unsigned char* buffer, size_t len);
+
+	const unsigned int ITERATIONS = 2000000;
+
+	// Hashes a changing buffer, as every output report differs in at least its sequence byte
+	double nanosecondsPerHash(CrcKernel kernel, unsigned char* buffer, size_t len)
+	{
+		volatile UINT32 sink = 0;
+		const double start = DS5WBench::seconds();
+		for (unsigned int i = 0; i < ITERATIONS; i++) {
+			buffer[0] = (unsigned char)i;
+			sink = sink + kernel(buffer, len);
+		}
+		return (DS5WBench::seconds() - start) * 1e9 / ITERATIONS;
+	}
+
+	void benchmarkKernels(const char* report, size_t len)
+	{
+		unsigned char buffer[DS_OUTPUT_REPORT_BT_HAPTICS_SIZE];
+		srand(3);
+		for (unsigned char& value : buffer)
+			value = (unsigned char)rand();
+
+		const int kernelCount = __DS5W::Cpu::hasPCLMUL() ? 4 : 3;
+		const CrcKernel kernels[4] = { __DS5W::CRC32::computeBytewise, __DS5W::CRC32::computeSlicing8, __DS5W::CRC32::computeSlicing16, __DS5W::CRC32::computeCarryless };
+		const char* names[4] = { "bytewise", "slicing-by-8", "slicing-by-16", "carry-less" };
+
+		for (int i = 0; i < kernelCount; i++) {
+			char label[64];
+			snprintf(label, sizeof(label), "%s, %s", report, names[i]);
+			DS5WBench::report(label, nanosecondsPerHash(kernels[i], buffer, len), "ns/report");
+		}
+	}
+}
+
+DS5W_BENCHMARK(crc32Kernels)
+{
+	// Hashed part of the Bluetooth output report and of the haptics report
+	benchmarkKernels("output report", DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32));
+	benchmarkKernels("haptics report", DS_OUTPUT_REPORT_BT_HAPTICS_SIZE - sizeof(UINT32));
+}
+
+DS5W_BENCHMARK(crc32Update)
+{
+	// Typical output change: sequence byte and one field of the report body
+	const size_t len = __DS5W::CRC32::MAX_UPDATE_LENGTH;
+	unsigned char previous[__DS5W::CRC32::MAX_UPDATE_LENGTH];
+	unsigned char buffer[__DS5W::CRC32::MAX_UPDATE_LENGTH];
+	srand(7);
+	for (size_t i = 0; i < len; i++)
+		previous[i] = buffer[i] = (unsigned char)rand();
+
+	volatile UINT32 sink = 0;
+	double start = DS5WBench::seconds();
+	for (unsigned int i = 0; i < ITERATIONS; i++) {
+		buffer[2] = (unsigned char)i;
+		buffer[45] = (unsigned char)(i >> 3);
+		sink = sink + __DS5W::CRC32::compute(buffer, len);
+	}
+	DS5WBench::report("full hash, 2 bytes changed", (DS5WBench::seconds() - start) * 1e9 / ITERATIONS, "ns/report");
+
+	UINT32 crc = __DS5W::CRC32::computeBytewise(previous, len);
+	start = DS5WBench::seconds();
+	for (unsigned int i = 0; i < ITERATIONS; i++) {
+		buffer[2] = (unsigned char)i;
+		buffer[45] = (unsigned char)(i >> 3);
+		crc = __DS5W::CRC32::update(crc, previous, buffer, len);
+		previous[2] = buffer[2];
+		previous[45] = buffer[45];
+	}
+	sink = sink + crc;
+	DS5WBench::report("incremental update, 2 bytes changed", (DS5WBench::seconds() - start) * 1e9 / ITERATIONS, "ns/report");
+}
@@ -0,0 +1,95 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Bench.h"
+
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+	const unsigned int REPORT_COUNT = 4096;
+	const unsigned int REPORT_STRIDE = 64;
+
+	// Decode the same reports for this long per variant
+	const double RUN_SECONDS = 0.5;
+
+	short calibrationReport[17] = { -3, 5, 2, 8700, -8650, 8690, -8710, 8720, -8680, 540, 540, 8200, -8180, 8210, -8170, 8190, -8200 };
+
+	DS5W::DeviceContext context;
+
+	std::vector<unsigned char> makeReports()
+	{
+		std::vector<unsigned char> reports(REPORT_COUNT * REPORT_STRIDE);
+		srand(1);
+		for (unsigned char& value : reports)
+			value = (unsigned char)rand();
+
+		unsigned int time = 0;
+		for (unsigned int i = 0; i < REPORT_COUNT; i++) {
+			time += 3000;
+			memcpy(&reports[i * REPORT_STRIDE + 0x1B], &time, sizeof(time));
+		}
+
+		return reports;
+	}
+}
+
+DS5W_BENCHMARK(inputBatchDecode)
+{
+	std::vector<unsigned char> reports = makeReports();
+	memset(&context, 0, sizeof(context));
+	__DS5W::Input::parseCalibrationData(&context._internal.calibrationData, calibrationReport);
+
+	// One report at a time, as getDeviceInputState() decodes
+	std::vector<DS5W::DS5InputState> states(REPORT_COUNT);
+	unsigned long long decoded = 0;
+	double start = DS5WBench::seconds();
+	double elapsed;
+	do {
+		for (unsigned int i = 0; i < REPORT_COUNT; i++)
+			__DS5W::Input::evaluateHidInputBuffer(&reports[i * REPORT_STRIDE], &states[i], &context);
+		decoded += REPORT_COUNT;
+		elapsed = DS5WBench::seconds() - start;
+	} while (elapsed < RUN_SECONDS);
+
+	const double scalarNs = elapsed * 1e9 / (double)decoded;
+	DS5WBench::report("scalar decode", scalarNs, "ns/report");
+	DS5WBench::report("scalar decode", (double)decoded / elapsed / 1e6, "Mreports/s");
+
+	// Column arrays, as decodeInputReportBatch() decodes
+	std::vector<char> leftX(REPORT_COUNT), leftY(REPORT_COUNT), rightX(REPORT_COUNT), rightY(REPORT_COUNT);
+	std::vector<unsigned char> leftTrigger(REPORT_COUNT), rightTrigger(REPORT_COUNT);
+	std::vector<unsigned int> buttons(REPORT_COUNT), currentTime(REPORT_COUNT), deltaTime(REPORT_COUNT);
+	std::vector<int> gyro[3], accel[3];
+	std::vector<DS5W::Touch> touch1(REPORT_COUNT), touch2(REPORT_COUNT);
+	for (int axis = 0; axis < 3; axis++) {
+		gyro[axis].resize(REPORT_COUNT);
+		accel[axis].resize(REPORT_COUNT);
+	}
+
+	DS5W::DS5InputBatch batch = {
+		leftX.data(), leftY.data(), rightX.data(), rightY.data(), leftTrigger.data(), rightTrigger.data(), buttons.data(),
+		gyro[0].data(), gyro[1].data(), gyro[2].data(), accel[0].data(), accel[1].data(), accel[2].data(),
+		touch1.data(), touch2.data(), currentTime.data(), deltaTime.data()
+	};
+
+	decoded = 0;
+	start = DS5WBench::seconds();
+	do {
+		__DS5W::Input::evaluateHidInputBatch(reports.data(), REPORT_STRIDE, REPORT_COUNT, &batch, &context);
+		decoded += REPORT_COUNT;
+		elapsed = DS5WBench::seconds() - start;
+	} while (elapsed < RUN_SECONDS);
+
+	const double batchNs = elapsed * 1e9 / (double)decoded;
+	DS5WBench::report("batch decode", batchNs, "ns/report");
+	DS5WBench::report("batch decode", (double)decoded / elapsed / 1e6, "Mreports/s");
+	DS5WBench::report("batch speedup", scalarNs / batchNs, "x");
+}
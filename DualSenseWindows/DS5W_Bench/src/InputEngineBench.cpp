@@ -0,0 +1,242 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Bench.h"
+
+#include <DualSenseWindows/InputEngine.h>
+#include <DualSenseWindows/DS5_Input.h>
+#include <DualSenseWindows/DS5_Clock.h>
+
+#include <Windows.h>
+#include <stdio.h>
+#include <string.h>
+#include <wchar.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace {
+	// Every simulated device sends at the USB report rate
+	const unsigned int REPORTS_PER_SECOND = 1000;
+
+	// Measured per device count
+	const double RUN_SECONDS = 2.0;
+
+	short calibrationReport[17] = { -3, 5, 2, 8700, -8650, 8690, -8710, 8720, -8680, 540, 540, 8200, -8180, 8210, -8170, 8190, -8200 };
+
+	// Controller replaced by a named pipe the engine opens through the context's device path
+	struct SimulatedDevice {
+		HANDLE pipe;
+		DS5W::DeviceContext context;
+	};
+
+	SimulatedDevice devices[DS5W_INPUT_ENGINE_MAX_DEVICES];
+
+	// Written by the callback on any worker
+	volatile LONG64 delivered;
+	volatile LONG64 latencyTotal;
+	volatile LONG64 latencyMax;
+
+	long long hostFrequency()
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		return frequency.QuadPart;
+	}
+
+	// Sensor timestamp ticks in microseconds
+	double sensorMicroseconds(double ticks)
+	{
+		return ticks * 1000000.0 / DS_SENSOR_TIMESTAMP_PER_SECOND;
+	}
+
+	// Host time as a sensor timestamp, so the callback can tell how long a report took
+	unsigned int sensorNow()
+	{
+		static const double ticksPerHostTick = (double)DS_SENSOR_TIMESTAMP_PER_SECOND / (double)hostFrequency();
+
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return (unsigned int)(unsigned long long)((double)now.QuadPart * ticksPerHostTick);
+	}
+
+	void onReport(DS5W::DeviceContext* ptrContext, const DS5W::DS5InputState* ptrInputState, void* userData)
+	{
+		if (!ptrInputState)
+			return;
+
+		const LONG64 latency = (LONG64)(unsigned int)(sensorNow() - ptrInputState->currentTime);
+		InterlockedIncrement64(&delivered);
+		InterlockedExchangeAdd64(&latencyTotal, latency);
+
+		LONG64 current = InterlockedExchangeAdd64(&latencyMax, 0);
+		while (latency > current) {
+			const LONG64 previous = InterlockedCompareExchange64(&latencyMax, latency, current);
+			if (previous == current)
+				break;
+			current = previous;
+		}
+	}
+
+	// Context set up as initDeviceContext() would, with fixed calibration as the pipe has no feature reports
+	bool openDevice(SimulatedDevice& device, unsigned int index)
+	{
+		DS5W::DeviceContext& context = device.context;
+		memset(&context, 0, sizeof(context));
+		swprintf(context._internal.devicePath, 260, L"\\\\.\\pipe\\ds5w_bench_%lu_%u", GetCurrentProcessId(), index);
+
+		device.pipe = CreateNamedPipeW(context._internal.devicePath, PIPE_ACCESS_DUPLEX, PIPE_TYPE_MESSAGE | PIPE_WAIT,
+			1, DS_INPUT_REPORT_USB_SIZE * 64, 0, 0, NULL);
+		if (device.pipe == INVALID_HANDLE_VALUE)
+			return false;
+
+		context._internal.connected = true;
+		context._internal.connectionType = DS5W::DeviceConnection::USB;
+		__DS5W::Input::parseCalibrationData(&context._internal.calibrationData, calibrationReport);
+		__DS5W::Clock::reset(&context);
+		__DS5W::Input::resetReportStatistics(&context);
+		__DS5W::Input::restartReportSequence(&context);
+
+		return true;
+	}
+
+	void closeDevice(SimulatedDevice& device)
+	{
+		CloseHandle(device.pipe);
+		device.pipe = NULL;
+	}
+
+	// Send one report to every device each millisecond until stopped
+	struct Producer {
+		unsigned int deviceCount;
+		volatile LONG stop;
+		unsigned long long written;
+	};
+
+	DWORD WINAPI producerThread(LPVOID param)
+	{
+		Producer* ptrProducer = (Producer*)param;
+
+		HANDLE timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (!timer)
+			timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = 0;
+		SetWaitableTimer(timer, &dueTime, 1000 / REPORTS_PER_SECOND, NULL, NULL, FALSE);
+
+		unsigned char report[DS_INPUT_REPORT_USB_SIZE] = { DS_INPUT_REPORT_USB };
+		while (!InterlockedCompareExchange(&ptrProducer->stop, 0, 0)) {
+			WaitForSingleObject(timer, INFINITE);
+
+			for (unsigned int i = 0; i < ptrProducer->deviceCount; i++) {
+				const unsigned int timestamp = sensorNow();
+				memcpy(&report[1 + 0x1B], &timestamp, sizeof(timestamp));
+				report[1 + 0x00] = (unsigned char)timestamp;
+
+				DWORD written;
+				if (WriteFile(devices[i].pipe, report, sizeof(report), &written, NULL))
+					ptrProducer->written++;
+			}
+		}
+
+		CloseHandle(timer);
+		return 0;
+	}
+
+	unsigned long long fileTime(const FILETIME& time)
+	{
+		return ((unsigned long long)time.dwHighDateTime << 32) | time.dwLowDateTime;
+	}
+
+	// Kernel and user time of a process or thread in seconds
+	double processSeconds()
+	{
+		FILETIME creation, exit, kernel, user;
+		GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+		return (double)(fileTime(kernel) + fileTime(user)) / 10000000.0;
+	}
+
+	double threadSeconds(HANDLE thread)
+	{
+		FILETIME creation, exit, kernel, user;
+		GetThreadTimes(thread, &creation, &exit, &kernel, &user);
+		return (double)(fileTime(kernel) + fileTime(user)) / 10000000.0;
+	}
+
+	void measureDevices(unsigned int deviceCount)
+	{
+		DS5W::DS5InputEngine engine;
+		if (DS5W_FAILED(DS5W::startInputEngine(&engine, 0, onReport, NULL))) {
+			printf("  engine could not be started\n");
+			return;
+		}
+
+		unsigned int opened = 0;
+		bool connected = true;
+		while (connected && opened < deviceCount && openDevice(devices[opened], opened)) {
+			if (DS5W_FAILED(DS5W::registerInputEngineDevice(&engine, &devices[opened].context))) {
+				closeDevice(devices[opened]);
+				break;
+			}
+
+			// Engine opened the client end already
+			connected = ConnectNamedPipe(devices[opened].pipe, NULL) || GetLastError() == ERROR_PIPE_CONNECTED;
+			opened++;
+		}
+
+		if (connected && opened == deviceCount) {
+			InterlockedExchange64(&delivered, 0);
+			InterlockedExchange64(&latencyTotal, 0);
+			InterlockedExchange64(&latencyMax, 0);
+
+			Producer producer = { deviceCount, FALSE, 0 };
+			HANDLE thread = CreateThread(NULL, 0, producerThread, &producer, 0, NULL);
+
+			const double cpuStart = processSeconds();
+			const double start = DS5WBench::seconds();
+			Sleep((DWORD)(RUN_SECONDS * 1000.0));
+			const double elapsed = DS5WBench::seconds() - start;
+
+			InterlockedExchange(&producer.stop, TRUE);
+			WaitForSingleObject(thread, INFINITE);
+
+			// Time spent writing the reports is not the engine's
+			const double cpu = processSeconds() - cpuStart - threadSeconds(thread);
+			CloseHandle(thread);
+
+			DS5W::DS5InputEngineStatistics statistics;
+			DS5W::getInputEngineStatistics(&engine, &statistics);
+
+			const LONG64 reports = InterlockedExchangeAdd64(&delivered, 0);
+			printf("  %u devices, %u workers\n", deviceCount, statistics.workers);
+			DS5WBench::report("reports written", (double)producer.written / elapsed, "reports/s");
+			DS5WBench::report("reports delivered", (double)reports / elapsed, "reports/s");
+			DS5WBench::report("delivery latency, average", reports ? sensorMicroseconds((double)latencyTotal / (double)reports) : 0.0, "us");
+			DS5WBench::report("delivery latency, max", sensorMicroseconds((double)latencyMax), "us");
+			DS5WBench::report("dispatch, average", statistics.averageDispatchMicroseconds, "us");
+			DS5WBench::report("engine CPU", cpu / elapsed * 100.0, "% of one core");
+			DS5WBench::report("engine CPU per report", reports ? cpu / (double)reports * 1000000.0 : 0.0, "us");
+		}
+		else {
+			printf("  %u devices could not be simulated\n", deviceCount);
+		}
+
+		// Reads are cancelled before the pipes go away
+		DS5W::stopInputEngine(&engine);
+		for (unsigned int i = 0; i < opened; i++)
+			closeDevice(devices[i]);
+	}
+}
+
+DS5W_BENCHMARK(inputEngineScaling)
+{
+	const unsigned int deviceCounts[] = { 1, 2, 4, 8, 16, 32, DS5W_INPUT_ENGINE_MAX_DEVICES };
+	for (unsigned int deviceCount : deviceCounts)
+		measureDevices(deviceCount);
+}
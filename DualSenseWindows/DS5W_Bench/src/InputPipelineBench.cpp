@@ -0,0 +1,105 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Bench.h"
+
+#include <DualSenseWindows/IO.h>
+
+#include <Windows.h>
+#include <stdio.h>
+
+namespace {
+	// Reads per pipeline depth, a few seconds of reports
+	const unsigned int READ_COUNT = 2000;
+
+	// Read as a game loop would and measure how long a read blocks and how old its report is
+	void measureDepth(DS5W::DeviceContext* ptrContext, unsigned int depth)
+	{
+		if (DS5W_FAILED(DS5W::setInputPipelineDepth(ptrContext, depth))) {
+			printf("  depth %u not supported\n", depth);
+			return;
+		}
+
+		DS5W::DS5InputState state;
+
+		// Fill the pipeline and settle the clock mapping
+		for (unsigned int i = 0; i < 100; i++)
+			DS5W::getDeviceInputState(ptrContext, &state);
+		DS5W::resetReportStatistics(ptrContext);
+
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		const double microsecondsPerTick = 1000000.0 / (double)frequency.QuadPart;
+
+		double blockedTotal = 0.0;
+		double blockedMax = 0.0;
+		double ageTotal = 0.0;
+		double ageMax = 0.0;
+		unsigned int aged = 0;
+		for (unsigned int i = 0; i < READ_COUNT; i++) {
+			LARGE_INTEGER start, end;
+			QueryPerformanceCounter(&start);
+			if (DS5W_FAILED(DS5W::getDeviceInputState(ptrContext, &state))) {
+				printf("  read failed\n");
+				return;
+			}
+			QueryPerformanceCounter(&end);
+
+			const double blocked = (double)(end.QuadPart - start.QuadPart) * microsecondsPerTick;
+			blockedTotal += blocked;
+			if (blocked > blockedMax)
+				blockedMax = blocked;
+
+			// Age of the report when the read returned it
+			long long received;
+			if (DS5W_SUCCESS(DS5W::deviceToHostTime(ptrContext, state.currentTime, &received))) {
+				const double age = (double)(end.QuadPart - received) * microsecondsPerTick;
+				ageTotal += age;
+				if (age > ageMax)
+					ageMax = age;
+				aged++;
+			}
+		}
+
+		DS5W::DS5ReportStatistics reports;
+		DS5W::getReportStatistics(ptrContext, &reports);
+
+		printf("  depth %u\n", depth);
+		DS5WBench::report("read blocked, average", blockedTotal / READ_COUNT, "us");
+		DS5WBench::report("read blocked, max", blockedMax, "us");
+		DS5WBench::report("report age, average", aged ? ageTotal / aged : 0.0, "us");
+		DS5WBench::report("report age, max", ageMax, "us");
+		DS5WBench::report("reports lost", (double)reports.lost, "");
+		DS5WBench::report("report interval", (double)reports.reportInterval * 1000000.0 / DS_SENSOR_TIMESTAMP_PER_SECOND, "us");
+	}
+}
+
+DS5W_BENCHMARK(inputPipelineLatency)
+{
+	DS5W::DeviceEnumInfo infos[16];
+	unsigned int controllersCount = 0;
+	DS5W::enumDevices(infos, 16, &controllersCount);
+	if (controllersCount == 0) {
+		printf("  skipped, no controller connected\n");
+		return;
+	}
+
+	DS5W::DeviceContext context;
+	if (DS5W_FAILED(DS5W::initDeviceContext(&infos[0], &context))) {
+		printf("  skipped, controller could not be opened\n");
+		return;
+	}
+
+	printf("  %s\n", context._internal.connectionType == DS5W::DeviceConnection::BT ? "Bluetooth" : "USB");
+
+	// 0 is the single read path, flush then one read per call
+	const unsigned int depths[] = { 0, 1, 2, 4, DS5W_INPUT_PIPELINE_MAX_DEPTH };
+	for (unsigned int depth : depths)
+		measureDepth(&context, depth);
+
+	DS5W::freeDeviceContext(&context);
+}
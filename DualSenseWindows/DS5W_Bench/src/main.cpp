@@ -0,0 +1,62 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Bench.h"
+
+#include <Windows.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+	DS5WBench::Benchmark*& firstBenchmark()
+	{
+		static DS5WBench::Benchmark* first = nullptr;
+		return first;
+	}
+}
+
+DS5WBench::Benchmark::Benchmark(const char* name, BenchmarkFunction function) :
+	name(name), function(function), next(nullptr)
+{
+	// Keep the order the benchmarks were defined in
+	Benchmark** link = &firstBenchmark();
+	while (*link)
+		link = &(*link)->next;
+	*link = this;
+}
+
+double DS5WBench::seconds()
+{
+	static LARGE_INTEGER frequency = {};
+	if (!frequency.QuadPart)
+		QueryPerformanceFrequency(&frequency);
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return (double)now.QuadPart / (double)frequency.QuadPart;
+}
+
+void DS5WBench::report(const char* label, double value, const char* unit)
+{
+	printf("  %-40s %12.2f %s\n", label, value, unit);
+}
+
+int main(int argc, char** argv)
+{
+	// Optional filter on benchmark names
+	const char* filter = argc > 1 ? argv[1] : "";
+
+	for (DS5WBench::Benchmark* benchmark = firstBenchmark(); benchmark; benchmark = benchmark->next) {
+		if (!strstr(benchmark->name, filter))
+			continue;
+
+		printf("%s\n", benchmark->name);
+		benchmark->function();
+	}
+
+	return 0;
+}
@@ -7,6 +7,7 @@
 #include <DualSenseWindows/IO.h>
 #include <DualSenseWindows/Device.h>
 #include <DualSenseWindows/Helpers.h>
+#include <DualSenseWindows/Animation.h>
 
 typedef std::wstringstream wstrBuilder;
 
@@ -110,16 +111,46 @@ INT WINAPI wWinMain(HINSTANCE _In_ hInstance, HINSTANCE _In_opt_ hPrevInstance,
 	ZeroMemory(&inState, sizeof(DS5W::DS5InputState));
 	ZeroMemory(&outState, sizeof(DS5W::DS5OutputState));
 
-	// Color intentsity
-	float intensity = 1.0f;
-	uint16_t lrmbl = 0.0;
-	uint16_t rrmbl = 0.0;
+	// Lightbar fades out while the rumble decays, then everything restarts
+	const DS5W::AnimationKeyframe lightbarKeys[] = {
+		{ 0.0f, DS5W::AnimationInterpolation::Linear, { 1.0f, 0.0f, 0.0f, 1.0f } },
+		{ 2.0f, DS5W::AnimationInterpolation::Step, { 1.0f, 0.0f, 0.0f, 0.0f } },
+	};
+	const DS5W::AnimationKeyframe leftRumbleKeys[] = {
+		{ 0.0f, DS5W::AnimationInterpolation::Linear, { 1.0f } },
+		{ 0.64f, DS5W::AnimationInterpolation::Step, { 0.0f } },
+		{ 2.0f, DS5W::AnimationInterpolation::Step, { 0.0f } },
+	};
+	const DS5W::AnimationKeyframe rightRumbleKeys[] = {
+		{ 0.0f, DS5W::AnimationInterpolation::Linear, { 1.0f } },
+		{ 1.28f, DS5W::AnimationInterpolation::Step, { 0.0f } },
+		{ 2.0f, DS5W::AnimationInterpolation::Step, { 0.0f } },
+	};
+
+	// Player led is lit while the right motor runs
+	const DS5W::AnimationKeyframe playerLedKeys[] = {
+		{ 0.0f, DS5W::AnimationInterpolation::Step, {}, { DS5W_OSTATE_PLAYER_LED_MIDDLE, true, DS5W::LedBrightness::HIGH } },
+		{ 1.28f, DS5W::AnimationInterpolation::Step, {}, { 0, true, DS5W::LedBrightness::HIGH } },
+		{ 2.0f, DS5W::AnimationInterpolation::Step, {}, { 0, true, DS5W::LedBrightness::HIGH } },
+	};
+
+	const DS5W::DS5AnimationTrack tracks[] = {
+		{ DS5W::AnimationChannel::Lightbar, lightbarKeys, 2, true },
+		{ DS5W::AnimationChannel::LeftRumble, leftRumbleKeys, 3, true },
+		{ DS5W::AnimationChannel::RightRumble, rightRumbleKeys, 3, true },
+		{ DS5W::AnimationChannel::PlayerLeds, playerLedKeys, 3, true },
+	};
+
+	DS5W::DS5AnimationEngine animations;
+	DS5W::initAnimationEngine(&animations);
+	DS5W::bindAnimationOutput(&animations, 0, &outState);
+	for (const DS5W::DS5AnimationTrack& track : tracks) {
+		DS5W::playAnimation(&animations, 0, &track);
+	}
 
 	// Force
 	DS5W::TriggerEffectType rType = DS5W::TriggerEffectType::NoResitance;
 
-	int btMul = con._internal.connectionType == DS5W::DeviceConnection::BT ? 10 : 1;
-
 	// Application infinity loop
 	while (!(inState.buttonMap & DS5W_ISTATE_BTN_SELECT && inState.buttonMap & DS5W_ISTATE_BTN_MENU)) {
 		// Get input state
@@ -162,32 +193,8 @@ INT WINAPI wWinMain(HINSTANCE _In_ hInstance, HINSTANCE _In_opt_ hPrevInstance,
 			console.writeLine(builder);
 
 			// === Write Output ===
-			// Rumble
-			lrmbl = max(lrmbl - 0x200 / btMul, 0);
-			rrmbl = max(rrmbl - 0x100 / btMul, 0);
-
-			outState.leftRumble = (lrmbl & 0xFF00) >> 8UL;
-			outState.rightRumble = (rrmbl & 0xFF00) >> 8UL;
-
-			// Lightbar
-			outState.lightbar = DS5W::color_R8G8B8_UCHAR_A32_FLOAT(255, 0, 0, intensity);
-			intensity -= 0.0025f / btMul;
-			if (intensity <= 0.0f) {
-				intensity = 1.0f;
-
-				lrmbl = 0xFF00;
-				rrmbl = 0xFF00;
-			}
-
-			// Player led
-			if (outState.rightRumble) {
-				outState.playerLeds.playerLedFade = true;
-				outState.playerLeds.bitmask = DS5W_OSTATE_PLAYER_LED_MIDDLE;
-				outState.playerLeds.brightness = DS5W::LedBrightness::HIGH;
-			}
-			else {
-				outState.playerLeds.bitmask = 0;
-			}
+			// Rumble, lightbar and player led
+			DS5W::tickAnimations(&animations, inState.deltaTime / (float)DS_SENSOR_TIMESTAMP_PER_SECOND, NULL);
 
 			// Set force
 			if (inState.rightTrigger == 0xFF) {
@@ -0,0 +1,209 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+
+#include <DualSenseWindows/Animation.h>
+
+#include <string.h>
+
+namespace {
+	DS5W::DS5AnimationEngine engine;
+	DS5W::DS5OutputState outputs[2];
+
+	// Rumble is the value times 255 rounded, so samples are easy to work out by hand
+	DS5W::AnimationKeyframe keyframe(float time, float value, DS5W::AnimationInterpolation interpolation)
+	{
+		DS5W::AnimationKeyframe frame;
+		memset(&frame, 0, sizeof(frame));
+		frame.time = time;
+		frame.interpolation = interpolation;
+		frame.value[0] = value;
+		return frame;
+	}
+
+	DS5W::DS5AnimationTrack track(DS5W::AnimationChannel channel, const DS5W::AnimationKeyframe* keyframes, unsigned int keyframeCount, bool loop)
+	{
+		DS5W::DS5AnimationTrack result;
+		result.channel = channel;
+		result.keyframes = keyframes;
+		result.keyframeCount = keyframeCount;
+		result.loop = loop;
+		return result;
+	}
+
+	void start()
+	{
+		memset(outputs, 0, sizeof(outputs));
+		DS5W::initAnimationEngine(&engine);
+		DS5W::bindAnimationOutput(&engine, 0, &outputs[0]);
+		DS5W::bindAnimationOutput(&engine, 1, &outputs[1]);
+	}
+
+	// Rumble of slot 0 after advancing the engine
+	unsigned char tickRumble(float deltaSeconds)
+	{
+		DS5W::tickAnimations(&engine, deltaSeconds, nullptr);
+		return outputs[0].leftRumble;
+	}
+}
+
+DS5W_TEST(animationLinearInterpolatesKeyframes)
+{
+	start();
+
+	const DS5W::AnimationKeyframe keyframes[] = {
+		keyframe(0.0f, 0.0f, DS5W::AnimationInterpolation::Linear),
+		keyframe(1.0f, 1.0f, DS5W::AnimationInterpolation::Linear),
+		keyframe(2.0f, 0.0f, DS5W::AnimationInterpolation::Linear),
+	};
+	const DS5W::DS5AnimationTrack linear = track(DS5W::AnimationChannel::LeftRumble, keyframes, 3, false);
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::playAnimation(&engine, 0, &linear)));
+
+	DS5W_CHECK(tickRumble(0.25f) == 64);
+	DS5W_CHECK(tickRumble(0.75f) == 255);
+	DS5W_CHECK(tickRumble(0.5f) == 128);
+	DS5W_CHECK(tickRumble(0.25f) == 64);
+}
+
+DS5W_TEST(animationStepHoldsUntilNextKeyframe)
+{
+	start();
+
+	const DS5W::AnimationKeyframe keyframes[] = {
+		keyframe(0.0f, 0.2f, DS5W::AnimationInterpolation::Step),
+		keyframe(1.0f, 0.8f, DS5W::AnimationInterpolation::Step),
+		keyframe(2.0f, 0.8f, DS5W::AnimationInterpolation::Step),
+	};
+	const DS5W::DS5AnimationTrack step = track(DS5W::AnimationChannel::LeftRumble, keyframes, 3, false);
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::playAnimation(&engine, 0, &step)));
+
+	DS5W_CHECK(tickRumble(0.0f) == 51);
+	DS5W_CHECK(tickRumble(0.75f) == 51);
+	DS5W_CHECK(tickRumble(0.25f) == 204);
+}
+
+DS5W_TEST(animationSmoothEasesBlend)
+{
+	start();
+
+	const DS5W::AnimationKeyframe keyframes[] = {
+		keyframe(0.0f, 0.0f, DS5W::AnimationInterpolation::Smooth),
+		keyframe(1.0f, 1.0f, DS5W::AnimationInterpolation::Smooth),
+	};
+	const DS5W::DS5AnimationTrack smooth = track(DS5W::AnimationChannel::LeftRumble, keyframes, 2, false);
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::playAnimation(&engine, 0, &smooth)));
+
+	// 3t^2 - 2t^3, slower than linear near keyframes and equal halfway
+	DS5W_CHECK(tickRumble(0.25f) == 40);
+	DS5W_CHECK(tickRumble(0.25f) == 128);
+	DS5W_CHECK(tickRumble(0.25f) == 215);
+}
+
+DS5W_TEST(animationLoopWrapsAround)
+{
+	start();
+
+	const DS5W::AnimationKeyframe keyframes[] = {
+		keyframe(0.0f, 0.0f, DS5W::AnimationInterpolation::Linear),
+		keyframe(1.0f, 1.0f, DS5W::AnimationInterpolation::Linear),
+		keyframe(2.0f, 0.0f, DS5W::AnimationInterpolation::Linear),
+	};
+	const DS5W::DS5AnimationTrack looping = track(DS5W::AnimationChannel::LeftRumble, keyframes, 3, true);
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::playAnimation(&engine, 0, &looping)));
+
+	DS5W_CHECK(tickRumble(1.5f) == 128);
+
+	// The cursor is past the first keyframe when the track wraps
+	DS5W_CHECK(tickRumble(0.75f) == 64);
+	DS5W_CHECK(engine._internal.tracks[(int)DS5W::AnimationChannel::LeftRumble][0].active);
+
+	// Several loops in one tick
+	DS5W_CHECK(tickRumble(4.25f) == 128);
+	DS5W_CHECK(engine._internal.tracks[(int)DS5W::AnimationChannel::LeftRumble][0].active);
+}
+
+DS5W_TEST(animationEndHoldsLastKeyframe)
+{
+	start();
+
+	const DS5W::AnimationKeyframe keyframes[] = {
+		keyframe(0.0f, 1.0f, DS5W::AnimationInterpolation::Linear),
+		keyframe(1.0f, 0.2f, DS5W::AnimationInterpolation::Linear),
+	};
+	const DS5W::DS5AnimationTrack once = track(DS5W::AnimationChannel::LeftRumble, keyframes, 2, false);
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::playAnimation(&engine, 0, &once)));
+
+	DS5W_CHECK(tickRumble(3.0f) == 51);
+	DS5W_CHECK(!engine._internal.tracks[(int)DS5W::AnimationChannel::LeftRumble][0].active);
+
+	// Finished tracks leave the output alone
+	outputs[0].leftRumble = 99;
+	unsigned int dirty[DS5W_ANIMATION_MAX_DEVICES];
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::tickAnimations(&engine, 0.5f, dirty)));
+	DS5W_CHECK(outputs[0].leftRumble == 99);
+	DS5W_CHECK(dirty[0] == 0);
+}
+
+DS5W_TEST(animationDirtyMasksFollowChanges)
+{
+	start();
+
+	DS5W::AnimationKeyframe keyframes[] = {
+		keyframe(0.0f, 1.0f, DS5W::AnimationInterpolation::Step),
+		keyframe(1.0f, 0.0f, DS5W::AnimationInterpolation::Step),
+	};
+	keyframes[0].value[3] = 1.0f;
+	keyframes[1].value[3] = 1.0f;
+	const DS5W::DS5AnimationTrack lightbar = track(DS5W::AnimationChannel::Lightbar, keyframes, 2, false);
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::playAnimation(&engine, 1, &lightbar)));
+
+	unsigned int dirty[DS5W_ANIMATION_MAX_DEVICES];
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::tickAnimations(&engine, 0.25f, dirty)));
+	DS5W_CHECK(dirty[0] == 0);
+	DS5W_CHECK(dirty[1] == DS5W_OSTATE_SUBSYSTEM_LIGHTBAR);
+	DS5W_CHECK(outputs[1].lightbar.r == 255);
+
+	// Same sample again is not a change
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::tickAnimations(&engine, 0.25f, dirty)));
+	DS5W_CHECK(dirty[1] == 0);
+
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::tickAnimations(&engine, 0.5f, dirty)));
+	DS5W_CHECK(dirty[1] == DS5W_OSTATE_SUBSYSTEM_LIGHTBAR);
+	DS5W_CHECK(outputs[1].lightbar.r == 0);
+
+	// Stopped tracks are not sampled
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::playAnimation(&engine, 1, &lightbar)));
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::stopAnimation(&engine, 1, DS5W::AnimationChannel::Lightbar)));
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::tickAnimations(&engine, 0.0f, dirty)));
+	DS5W_CHECK(dirty[1] == 0);
+	DS5W_CHECK(outputs[1].lightbar.r == 0);
+}
+
+DS5W_TEST(animationRejectsInvalidTracks)
+{
+	start();
+
+	const DS5W::AnimationKeyframe keyframes[] = {
+		keyframe(0.0f, 0.0f, DS5W::AnimationInterpolation::Linear),
+		keyframe(1.0f, 1.0f, DS5W::AnimationInterpolation::Linear),
+		keyframe(0.5f, 0.0f, DS5W::AnimationInterpolation::Linear),
+	};
+
+	const DS5W::DS5AnimationTrack unordered = track(DS5W::AnimationChannel::LeftRumble, keyframes, 3, false);
+	DS5W_CHECK(DS5W::playAnimation(&engine, 0, &unordered) == DS5W_E_INVALID_ARGS);
+
+	const DS5W::DS5AnimationTrack empty = track(DS5W::AnimationChannel::LeftRumble, keyframes, 0, false);
+	DS5W_CHECK(DS5W::playAnimation(&engine, 0, &empty) == DS5W_E_INVALID_ARGS);
+
+	const DS5W::DS5AnimationTrack valid = track(DS5W::AnimationChannel::LeftRumble, keyframes, 2, false);
+	DS5W_CHECK(DS5W::playAnimation(&engine, DS5W_ANIMATION_MAX_DEVICES, &valid) == DS5W_E_INVALID_ARGS);
+
+	// Slots need an output state bound first
+	DS5W::bindAnimationOutput(&engine, 0, nullptr);
+	DS5W_CHECK(DS5W::playAnimation(&engine, 0, &valid) == DS5W_E_INVALID_ARGS);
+}
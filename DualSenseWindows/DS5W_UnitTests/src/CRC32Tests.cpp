@@ -0,0 +1,81 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+
+#include <DualSenseWindows/DS_CRC32.h>
+#include <DualSenseWindows/DS5_Cpu.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+DS5W_TEST(crc32MatchesSeededStandardCrc)
+{
+	// Standard CRC32 over the 0xA2 output report prefix followed by the buffer
+	const unsigned char check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	DS5W_CHECK(__DS5W::CRC32::computeBytewise(check, sizeof(check)) == 0x63DA9F12);
+	DS5W_CHECK(__DS5W::CRC32::computeBytewise(check, 0) == 0xEADA2D49);
+}
+
+DS5W_TEST(crc32KernelsMatchBytewise)
+{
+	const bool carryless = __DS5W::Cpu::hasPCLMUL();
+	unsigned char buffer[640];
+
+	srand(3);
+	for (int i = 0; i < 20000; i++) {
+		// Every short length and alignment, longer buffers now and then for the 64 byte folding
+		const size_t len = i < 2048 ? (size_t)(i / 16) : (size_t)(rand() % 600);
+		const size_t offset = i < 2048 ? (size_t)(i % 16) : (size_t)(rand() % 16);
+		for (size_t j = 0; j < len + offset; j++)
+			buffer[j] = (unsigned char)rand();
+
+		const unsigned char* data = buffer + offset;
+		const UINT32 expected = __DS5W::CRC32::computeBytewise(data, len);
+		DS5W_CHECK(__DS5W::CRC32::computeSlicing8(data, len) == expected);
+		DS5W_CHECK(__DS5W::CRC32::computeSlicing16(data, len) == expected);
+		if (carryless)
+			DS5W_CHECK(__DS5W::CRC32::computeCarryless(data, len) == expected);
+		DS5W_CHECK(__DS5W::CRC32::compute(buffer + offset, len) == expected);
+	}
+}
+
+DS5W_TEST(crc32UpdateMatchesFullRecompute)
+{
+	unsigned char previous[__DS5W::CRC32::MAX_UPDATE_LENGTH];
+	unsigned char buffer[__DS5W::CRC32::MAX_UPDATE_LENGTH];
+
+	srand(7);
+	for (size_t len = 1; len <= __DS5W::CRC32::MAX_UPDATE_LENGTH; len++) {
+		for (size_t i = 0; i < len; i++)
+			previous[i] = (unsigned char)rand();
+		UINT32 crc = __DS5W::CRC32::computeBytewise(previous, len);
+
+		// Chains of random edits, sometimes none and sometimes every byte
+		for (int step = 0; step < 500; step++) {
+			memcpy(buffer, previous, len);
+			const size_t edits = step % 100 == 0 ? len : (size_t)(rand() % 6);
+			for (size_t e = 0; e < edits; e++)
+				buffer[step % 100 == 0 ? e : rand() % len] = (unsigned char)rand();
+
+			crc = __DS5W::CRC32::update(crc, previous, buffer, len);
+			DS5W_CHECK(crc == __DS5W::CRC32::computeBytewise(buffer, len));
+			memcpy(previous, buffer, len);
+		}
+	}
+}
+
+DS5W_TEST(crc32UpdateHashesLongBuffersInFull)
+{
+	unsigned char previous[2 * DS_OUTPUT_REPORT_BT_SIZE] = {};
+	unsigned char buffer[2 * DS_OUTPUT_REPORT_BT_SIZE];
+	for (size_t i = 0; i < sizeof(buffer); i++)
+		buffer[i] = (unsigned char)i;
+
+	// The previous hash does not matter past MAX_UPDATE_LENGTH
+	DS5W_CHECK(__DS5W::CRC32::update(0, previous, buffer, sizeof(buffer)) == __DS5W::CRC32::computeBytewise(buffer, sizeof(buffer)));
+}
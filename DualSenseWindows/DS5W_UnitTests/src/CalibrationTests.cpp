@@ -0,0 +1,97 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+
+#include <DualSenseWindows/Device.h>
+
+#include <stdlib.h>
+
+namespace {
+	// Compares calibrate() with mult_frac() for every raw sensor value, returns the first mismatching value or 0x10000
+	int firstMismatch(DS5W::AxisCalibrationData axis)
+	{
+		axis.precompute();
+
+		for (int raw = -32768; raw <= 32767; raw++) {
+			const long long x = raw - axis.bias;
+
+			// mult_frac itself overflows int here, there is nothing to match
+			const long long quot = axis.sens_numer / axis.sens_denom;
+			const long long rem = axis.sens_numer % axis.sens_denom;
+			if (llabs(quot * x) > 0x7FFFFFFF || llabs(rem * x) > 0x7FFFFFFF || llabs(rem * x / axis.sens_denom + quot * x) > 0x7FFFFFFF)
+				continue;
+
+			if (axis.calibrate(raw) != mult_frac(axis.sens_numer, raw - axis.bias, axis.sens_denom))
+				return raw;
+		}
+
+		return 0x10000;
+	}
+
+	DS5W::AxisCalibrationData makeAxis(short bias, int numer, int denom)
+	{
+		DS5W::AxisCalibrationData axis = {};
+		axis.bias = bias;
+		axis.sens_numer = numer;
+		axis.sens_denom = denom;
+		return axis;
+	}
+}
+
+DS5W_TEST(calibrationMatchesMultFracForDeviceValues)
+{
+	// Gyroscope: (speed plus + speed minus) * 1024 over plus - minus, accelerometer: 2 * 8192 over the 2g range
+	const DS5W::AxisCalibrationData axes[] = {
+		makeAxis(-3, (540 + 540) * 1024, 8700 + 8650),
+		makeAxis(5, (540 + 540) * 1024, 8690 + 8710),
+		makeAxis(2, (540 + 540) * 1024, 8720 + 8680),
+		makeAxis(12, 2 * 8192, 8190 + 8200),
+		makeAxis(0, 2 * 8192, 16412),
+		makeAxis(0, 2 * 8192, 1),
+	};
+
+	for (const DS5W::AxisCalibrationData& axis : axes) {
+		DS5W::AxisCalibrationData precomputed = axis;
+		precomputed.precompute();
+		DS5W_CHECK(precomputed.sens_magic != 0);
+		DS5W_CHECK(firstMismatch(axis) == 0x10000);
+	}
+}
+
+DS5W_TEST(calibrationMatchesMultFracForRandomValues)
+{
+	srand(4);
+	for (int i = 0; i < 200; i++) {
+		// Powers of two and their neighbours, then any 15 bit denominator
+		int denom = i < 48 ? (1 << (i % 16)) + (i / 16) - 1 : 1 + rand() % 0x7FFF;
+		if (denom <= 0)
+			denom = 1;
+
+		const short bias = (short)(rand() % 0x10000 - 0x8000);
+		const int numer = 1 + (int)((((unsigned int)rand() << 15) ^ (unsigned int)rand()) % 2200000);
+		DS5W_CHECK(firstMismatch(makeAxis(bias, numer, denom)) == 0x10000);
+	}
+}
+
+DS5W_TEST(calibrationFallsBackOutsideReciprocalRange)
+{
+	// Denominators above 15 bits and non positive values keep using mult_frac
+	const DS5W::AxisCalibrationData axes[] = {
+		makeAxis(0, 2 * 8192, 0x8000),
+		makeAxis(7, (540 + 540) * 1024, 65000),
+		makeAxis(0, -2 * 8192, 16400),
+		makeAxis(0, 2 * 8192, -16400),
+	};
+
+	for (const DS5W::AxisCalibrationData& axis : axes) {
+		DS5W::AxisCalibrationData precomputed = axis;
+		precomputed.precompute();
+		DS5W_CHECK(precomputed.sens_magic == 0);
+		DS5W_CHECK(firstMismatch(axis) == 0x10000);
+	}
+}
@@ -0,0 +1,141 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Clock.h>
+#include <DualSenseWindows/DS5_Input.h>
+#include <DualSenseWindows/DeviceSpecs.h>
+
+#include <math.h>
+
+namespace {
+	using DS5WTest::context;
+	using DS5WTest::REPORT_TICKS;
+
+	// Fixed host clock so host times are exact
+	const long long HOST_FREQUENCY = 10000000;
+
+	// Shortest transport delay, in host ticks
+	const long long MIN_LATENCY = 1500;
+
+	unsigned int timestamp;
+	double hostTime;
+	unsigned int noise;
+
+	void start(unsigned int firstTimestamp)
+	{
+		DS5WTest::resetContext(&context);
+		__DS5W::Clock::reset(&context);
+		context._internal.clockSync.hostFrequency = HOST_FREQUENCY;
+		context._internal.clockSync.rate = (double)HOST_FREQUENCY / DS_SENSOR_TIMESTAMP_PER_SECOND;
+
+		timestamp = firstTimestamp;
+		hostTime = 1e9;
+		noise = 1;
+	}
+
+	// Delay between the minimum and five times it, from a fixed sequence
+	long long latency(bool jitter)
+	{
+		if (!jitter)
+			return MIN_LATENCY;
+
+		noise = noise * 1103515245u + 12345u;
+		return MIN_LATENCY + (long long)((noise >> 16) % (4 * MIN_LATENCY));
+	}
+
+	// Device sends the next report, its clock running fast by driftPpm
+	void receive(double driftPpm, bool jitter)
+	{
+		timestamp += REPORT_TICKS;
+		hostTime += REPORT_TICKS * (double)HOST_FREQUENCY / DS_SENSOR_TIMESTAMP_PER_SECOND / (1.0 + driftPpm * 1e-6);
+
+		DS5WTest::setReportTimestamp(__DS5W::Input::heldReportBody(&context), timestamp);
+		__DS5W::Clock::onInputReport(&context, (long long)hostTime + latency(jitter));
+	}
+
+	DS5W::DS5ClockSyncInfo info()
+	{
+		DS5W::DS5ClockSyncInfo result;
+		__DS5W::Clock::getInfo(&context, &result);
+		return result;
+	}
+}
+
+DS5W_TEST(clockFollowsFastestReports)
+{
+	start(1000);
+	for (int i = 0; i < 5000; i++)
+		receive(0.0, true);
+
+	// Host time of the last report, the delay of its fastest neighbours included
+	const long long error = __DS5W::Clock::deviceToHost(&context, timestamp) - (long long)hostTime;
+	DS5W_CHECK(error >= 0 && error < 3 * MIN_LATENCY);
+
+	const DS5W::DS5ClockSyncInfo result = info();
+	DS5W_CHECK(result.sampleCount == 5000);
+	DS5W_CHECK(result.anchorCount == 1);
+	DS5W_CHECK(fabs(result.driftPpm) < 20.0);
+}
+
+DS5W_TEST(clockEstimatesDrift)
+{
+	start(1000);
+	for (int i = 0; i < 30000; i++)
+		receive(100.0, false);
+
+	DS5W_CHECK(fabs(info().driftPpm - 100.0) < 10.0);
+
+	// Steady delay once the drift is known
+	const long long error = __DS5W::Clock::deviceToHost(&context, timestamp) - (long long)hostTime;
+	DS5W_CHECK(error > MIN_LATENCY - 100 && error < MIN_LATENCY + 100);
+}
+
+DS5W_TEST(clockMapsTimestampsAcrossWrap)
+{
+	// Counter wraps after a few hundred reports
+	start(0xFFFFFFFFu - 300 * REPORT_TICKS);
+	for (int i = 0; i < 1000; i++) {
+		receive(0.0, false);
+
+		// Report just received maps to its receive time
+		const long long mapped = __DS5W::Clock::deviceToHost(&context, timestamp);
+		DS5W_CHECK(mapped - (long long)hostTime == MIN_LATENCY || i < 2);
+	}
+
+	// Earlier and later timestamps are a whole number of reports away, across the wrap
+	const long long now = __DS5W::Clock::deviceToHost(&context, timestamp);
+	const long long reportHostTicks = REPORT_TICKS * HOST_FREQUENCY / (long long)DS_SENSOR_TIMESTAMP_PER_SECOND;
+	DS5W_CHECK(llabs(now - __DS5W::Clock::deviceToHost(&context, timestamp - 800 * REPORT_TICKS) - 800 * reportHostTicks) <= 1);
+	DS5W_CHECK(llabs(__DS5W::Clock::deviceToHost(&context, timestamp + 10 * REPORT_TICKS) - now - 10 * reportHostTicks) <= 1);
+
+	DS5W_CHECK(info().deviceTime == 0xFFFFFFFFu - 300 * REPORT_TICKS + 1000ull * REPORT_TICKS);
+}
+
+DS5W_TEST(clockKeepsDeviceTimeWhenReanchored)
+{
+	start(1000);
+	for (int i = 0; i < 100; i++)
+		receive(0.0, false);
+	const unsigned long long before = info().deviceTime;
+
+	// Device clock restarted while reconnecting
+	__DS5W::Clock::reanchor(&context);
+	timestamp = 50;
+	receive(0.0, false);
+
+	const DS5W::DS5ClockSyncInfo result = info();
+	DS5W_CHECK(result.anchorCount == 2);
+	DS5W_CHECK(result.deviceTime > before);
+	DS5W_CHECK(__DS5W::Clock::deviceToHost(&context, timestamp) - (long long)hostTime == MIN_LATENCY);
+
+	// Same report seen again is ignored
+	__DS5W::Clock::onInputReport(&context, (long long)hostTime + 5 * MIN_LATENCY);
+	DS5W_CHECK(info().sampleCount == result.sampleCount);
+}
@@ -0,0 +1,211 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Conditioning.h>
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+	using DS5WTest::context;
+
+	unsigned char report[DS_INPUT_REPORT_USB_SIZE];
+
+	DS5W::AnalogResponse linear(float deadzone = 0.0f, float antiDeadzone = 0.0f)
+	{
+		DS5W::AnalogResponse response = { deadzone, antiDeadzone, 1.0f, 1.0f, nullptr, 0 };
+		return response;
+	}
+
+	DS5W::DS5AnalogConditioning makeConditioning(DS5W::StickDeadzoneShape shape, DS5W::AnalogResponse stickResponse)
+	{
+		DS5W::DS5AnalogConditioning conditioning;
+		memset(&conditioning, 0, sizeof(conditioning));
+		conditioning.leftStick.response = stickResponse;
+		conditioning.leftStick.shape = shape;
+		conditioning.rightStick.response = stickResponse;
+		conditioning.rightStick.shape = shape;
+		conditioning.leftTrigger.response = linear();
+		conditioning.rightTrigger.response = linear();
+		conditioning.leftTrigger.pressThreshold = conditioning.leftTrigger.releaseThreshold = 1;
+		conditioning.rightTrigger.pressThreshold = conditioning.rightTrigger.releaseThreshold = 1;
+		return conditioning;
+	}
+
+	void apply(const DS5W::DS5AnalogConditioning& conditioning)
+	{
+		DS5WTest::resetContext(&context);
+		memset(report, 0, sizeof(report));
+
+		// The float decoder also calibrates the motion sensors
+		DS5WTest::calibrate(&context);
+		__DS5W::Conditioning::compile(&conditioning, &context._internal.conditioning);
+	}
+
+	DS5W::DS5InputState decode(unsigned char leftX, unsigned char leftY, unsigned char leftTrigger = 0, unsigned char rightTrigger = 0)
+	{
+		report[0x00] = leftX;
+		report[0x01] = leftY;
+		report[0x04] = leftTrigger;
+		report[0x05] = rightTrigger;
+
+		DS5W::DS5InputState state;
+		__DS5W::Input::evaluateHidInputBufferMasked(report, &state, &context, DS5W_ISTATE_FIELD_STICKS | DS5W_ISTATE_FIELD_TRIGGERS | DS5W_ISTATE_FIELD_BUTTONS);
+		return state;
+	}
+}
+
+DS5W_TEST(conditioningLinearResponseKeepsRawValues)
+{
+	apply(makeConditioning(DS5W::StickDeadzoneShape::Axial, linear()));
+
+	DS5W::DeviceContext rawContext;
+	memset(&rawContext, 0, sizeof(rawContext));
+
+	for (int raw = 0; raw < 256; raw++) {
+		const DS5W::DS5InputState state = decode((unsigned char)raw, (unsigned char)raw, (unsigned char)raw, (unsigned char)raw);
+
+		DS5W::DS5InputState rawState;
+		__DS5W::Input::evaluateHidInputBufferMasked(report, &rawState, &rawContext, DS5W_ISTATE_FIELD_STICKS | DS5W_ISTATE_FIELD_TRIGGERS);
+
+		// Conditioned axes are symmetric, -128 becomes -127
+		DS5W_CHECK(state.leftStick.x == (rawState.leftStick.x == -128 ? -127 : rawState.leftStick.x));
+		DS5W_CHECK(state.leftStick.y == (rawState.leftStick.y == -128 ? -127 : rawState.leftStick.y));
+		DS5W_CHECK(state.leftTrigger == rawState.leftTrigger && state.rightTrigger == rawState.rightTrigger);
+	}
+}
+
+DS5W_TEST(conditioningAxialDeadzoneAndAntiDeadzone)
+{
+	apply(makeConditioning(DS5W::StickDeadzoneShape::Axial, linear(0.1f, 0.2f)));
+
+	// 12 / 127 is inside the deadzone, 14 / 127 just outside
+	DS5W_CHECK(decode(128 + 12, 127).leftStick.x == 0);
+	DS5W_CHECK(decode(128 - 12, 127).leftStick.x == 0);
+	DS5W_CHECK(decode(128 + 14, 127).leftStick.x >= 25);
+	DS5W_CHECK(decode(128 - 14, 127).leftStick.x <= -25);
+	DS5W_CHECK(decode(255, 127).leftStick.x == 127);
+
+	// Output never decreases as the stick moves out
+	int previous = -128;
+	for (int raw = 0; raw < 256; raw++) {
+		const int x = decode((unsigned char)raw, 127).leftStick.x;
+		DS5W_CHECK(x >= previous);
+		previous = x;
+	}
+}
+
+DS5W_TEST(conditioningRadialDeadzoneUsesMagnitude)
+{
+	// Both axes at 10 / 127 are inside an axial deadzone of 0.1, their magnitude is not
+	apply(makeConditioning(DS5W::StickDeadzoneShape::Axial, linear(0.1f)));
+	DS5W::DS5InputState state = decode(128 + 10, 127 - 10);
+	DS5W_CHECK(state.leftStick.x == 0 && state.leftStick.y == 0);
+
+	apply(makeConditioning(DS5W::StickDeadzoneShape::Radial, linear(0.1f)));
+	state = decode(128 + 10, 127 - 10);
+	DS5W_CHECK(state.leftStick.x > 0 && state.leftStick.y > 0);
+
+	// Radial scaling keeps the direction
+	state = decode(128 + 60, 127 - 60);
+	DS5W_CHECK(state.leftStick.x == state.leftStick.y);
+	state = decode(128 + 5, 127 - 5);
+	DS5W_CHECK(state.leftStick.x == 0 && state.leftStick.y == 0);
+}
+
+DS5W_TEST(conditioningFloatDecodeMatchesInteger)
+{
+	DS5W::AnalogResponse response = linear(0.05f, 0.1f);
+	response.exponent = 2.0f;
+	apply(makeConditioning(DS5W::StickDeadzoneShape::Radial, response));
+
+	for (int raw = 0; raw < 256; raw += 5) {
+		report[0x00] = (unsigned char)raw;
+		report[0x01] = (unsigned char)(255 - raw);
+		report[0x04] = (unsigned char)raw;
+
+		DS5W::DS5InputState state;
+		__DS5W::Input::evaluateHidInputBufferMasked(report, &state, &context, DS5W_ISTATE_FIELD_STICKS | DS5W_ISTATE_FIELD_TRIGGERS);
+		DS5W::DS5InputStateF stateF;
+		__DS5W::Input::evaluateHidInputBufferF(report, &stateF, &context);
+
+		DS5W_CHECK(fabsf(stateF.leftStick.x * 127.0f - (float)state.leftStick.x) <= 0.5f);
+		DS5W_CHECK(fabsf(stateF.leftStick.y * 127.0f - (float)state.leftStick.y) <= 0.5f);
+		DS5W_CHECK(fabsf(stateF.leftTrigger * 255.0f - (float)state.leftTrigger) <= 0.5f);
+	}
+}
+
+DS5W_TEST(conditioningTriggerCurvePoints)
+{
+	const float points[3] = { 0.0f, 0.8f, 1.0f };
+	DS5W::DS5AnalogConditioning conditioning = makeConditioning(DS5W::StickDeadzoneShape::Axial, linear());
+	conditioning.leftTrigger.response.curvePoints = points;
+	conditioning.leftTrigger.response.curvePointCount = 3;
+	apply(conditioning);
+
+	DS5W_CHECK(decode(128, 127, 0).leftTrigger == 0);
+	DS5W_CHECK(abs(decode(128, 127, 128).leftTrigger - 204) <= 1);
+	DS5W_CHECK(abs(decode(128, 127, 64).leftTrigger - 102) <= 1);
+	DS5W_CHECK(decode(128, 127, 255).leftTrigger == 255);
+}
+
+DS5W_TEST(conditioningTriggerButtonHysteresis)
+{
+	DS5W::DS5AnalogConditioning conditioning = makeConditioning(DS5W::StickDeadzoneShape::Axial, linear());
+	conditioning.leftTrigger.pressThreshold = 200;
+	conditioning.leftTrigger.releaseThreshold = 100;
+	conditioning.rightTrigger.pressThreshold = 128;
+	conditioning.rightTrigger.releaseThreshold = 128;
+	apply(conditioning);
+
+	const unsigned char travel[] = { 0, 150, 210, 150, 100, 99, 150 };
+	const bool leftPressed[] = { false, false, true, true, true, false, false };
+	const bool rightPressed[] = { false, true, true, true, false, false, true };
+
+	for (int i = 0; i < 7; i++) {
+		const unsigned int buttons = decode(128, 127, travel[i], travel[i]).buttonMap;
+		DS5W_CHECK(((buttons & DS5W_ISTATE_BTN_TRIGGER_LEFT) != 0) == leftPressed[i]);
+		DS5W_CHECK(((buttons & DS5W_ISTATE_BTN_TRIGGER_RIGHT) != 0) == rightPressed[i]);
+	}
+}
+
+DS5W_TEST(conditioningRejectsInvalidConfiguration)
+{
+	const float points[1] = { 1.0f };
+	const DS5W::DS5AnalogConditioning valid = makeConditioning(DS5W::StickDeadzoneShape::Radial, linear(0.1f));
+	DS5W_CHECK(__DS5W::Conditioning::isValid(&valid));
+
+	DS5W::DS5AnalogConditioning invalid = valid;
+	invalid.leftStick.response.saturation = 0.1f;
+	DS5W_CHECK(!__DS5W::Conditioning::isValid(&invalid));
+
+	invalid = valid;
+	invalid.rightStick.response.deadzone = NAN;
+	DS5W_CHECK(!__DS5W::Conditioning::isValid(&invalid));
+
+	invalid = valid;
+	invalid.leftTrigger.response.antiDeadzone = 1.0f;
+	DS5W_CHECK(!__DS5W::Conditioning::isValid(&invalid));
+
+	invalid = valid;
+	invalid.rightTrigger.response.exponent = 0.0f;
+	DS5W_CHECK(!__DS5W::Conditioning::isValid(&invalid));
+
+	invalid = valid;
+	invalid.leftStick.response.curvePoints = points;
+	invalid.leftStick.response.curvePointCount = 1;
+	DS5W_CHECK(!__DS5W::Conditioning::isValid(&invalid));
+
+	invalid = valid;
+	invalid.rightTrigger.releaseThreshold = 2;
+	DS5W_CHECK(!__DS5W::Conditioning::isValid(&invalid));
+}
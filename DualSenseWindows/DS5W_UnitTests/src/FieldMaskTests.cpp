@@ -0,0 +1,115 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+	const unsigned int FIELDS[] = {
+		DS5W_ISTATE_FIELD_STICKS, DS5W_ISTATE_FIELD_TRIGGERS, DS5W_ISTATE_FIELD_BUTTONS, DS5W_ISTATE_FIELD_ACCELEROMETER, DS5W_ISTATE_FIELD_GYROSCOPE,
+		DS5W_ISTATE_FIELD_TOUCH, DS5W_ISTATE_FIELD_TIME, DS5W_ISTATE_FIELD_BATTERY, DS5W_ISTATE_FIELD_HEADPHONE, DS5W_ISTATE_FIELD_TRIGGER_FEEDBACK,
+	};
+
+	using DS5WTest::context;
+
+	unsigned char report[64];
+
+	// Random report body, same for every test
+	void makeReport()
+	{
+		srand(7);
+		for (unsigned char& value : report)
+			value = (unsigned char)rand();
+	}
+
+	// Decode the report with a fresh context into a state filled with a marker byte
+	DS5W::DS5InputState decode(unsigned int fieldMask)
+	{
+		DS5WTest::resetContext(&context);
+		DS5WTest::calibrate(&context);
+
+		DS5W::DS5InputState state;
+		memset(&state, 0xCD, sizeof(state));
+		__DS5W::Input::evaluateHidInputBufferMasked(report, &state, &context, fieldMask);
+		return state;
+	}
+
+	template <typename T>
+	bool same(const T& a, const T& b)
+	{
+		return memcmp(&a, &b, sizeof(T)) == 0;
+	}
+
+	// Whether the fields of one DS5W_ISTATE_FIELD_ flag are equal
+	bool fieldsMatch(const DS5W::DS5InputState& a, const DS5W::DS5InputState& b, unsigned int field)
+	{
+		switch (field) {
+		case DS5W_ISTATE_FIELD_STICKS: return same(a.leftStick, b.leftStick) && same(a.rightStick, b.rightStick);
+		case DS5W_ISTATE_FIELD_TRIGGERS: return a.leftTrigger == b.leftTrigger && a.rightTrigger == b.rightTrigger;
+		case DS5W_ISTATE_FIELD_BUTTONS: return a.buttonMap == b.buttonMap;
+		case DS5W_ISTATE_FIELD_ACCELEROMETER: return same(a.accelerometer, b.accelerometer);
+		case DS5W_ISTATE_FIELD_GYROSCOPE: return same(a.gyroscope, b.gyroscope);
+		case DS5W_ISTATE_FIELD_TOUCH: return same(a.touchPoint1, b.touchPoint1) && same(a.touchPoint2, b.touchPoint2);
+		case DS5W_ISTATE_FIELD_TIME: return a.currentTime == b.currentTime && a.deltaTime == b.deltaTime && a.hostTimestamp == b.hostTimestamp && a.reportGap == b.reportGap;
+		case DS5W_ISTATE_FIELD_BATTERY: return same(a.battery, b.battery);
+		case DS5W_ISTATE_FIELD_HEADPHONE: return a.headPhoneConnected == b.headPhoneConnected;
+		case DS5W_ISTATE_FIELD_TRIGGER_FEEDBACK: return a.leftTriggerFeedback == b.leftTriggerFeedback && a.rightTriggerFeedback == b.rightTriggerFeedback;
+		}
+		return false;
+	}
+}
+
+DS5W_TEST(fieldMaskWritesOnlyRequestedFields)
+{
+	makeReport();
+	const DS5W::DS5InputState full = decode(DS5W_ISTATE_FIELD_ALL);
+	const DS5W::DS5InputState untouched = decode(0);
+
+	for (unsigned int field : FIELDS) {
+		const DS5W::DS5InputState state = decode(field);
+		for (unsigned int other : FIELDS)
+			DS5W_CHECK(fieldsMatch(state, other == field ? full : untouched, other));
+	}
+}
+
+DS5W_TEST(fieldMaskCombinesFields)
+{
+	makeReport();
+	const DS5W::DS5InputState full = decode(DS5W_ISTATE_FIELD_ALL);
+	const DS5W::DS5InputState untouched = decode(0);
+
+	const unsigned int mask = DS5W_ISTATE_FIELD_BUTTONS | DS5W_ISTATE_FIELD_GYROSCOPE | DS5W_ISTATE_FIELD_TIME;
+	const DS5W::DS5InputState state = decode(mask);
+	for (unsigned int field : FIELDS)
+		DS5W_CHECK(fieldsMatch(state, (mask & field) ? full : untouched, field));
+}
+
+DS5W_TEST(fieldMaskTracksTimeWithoutTimeField)
+{
+	makeReport();
+	decode(DS5W_ISTATE_FIELD_BUTTONS);
+
+	// Next report without the time field still moves the timestamp on
+	unsigned int timestamp = *(unsigned int*)&report[0x1B];
+	timestamp += 3000;
+	memcpy(&report[0x1B], &timestamp, sizeof(timestamp));
+
+	DS5W::DS5InputState state;
+	__DS5W::Input::evaluateHidInputBufferMasked(report, &state, &context, DS5W_ISTATE_FIELD_BUTTONS);
+	DS5W_CHECK(context._internal.timestamp == timestamp);
+	DS5W_CHECK(context._internal.deltaTime == 3000);
+
+	timestamp += 3000;
+	memcpy(&report[0x1B], &timestamp, sizeof(timestamp));
+	__DS5W::Input::evaluateHidInputBufferMasked(report, &state, &context, DS5W_ISTATE_FIELD_TIME);
+	DS5W_CHECK(state.currentTime == timestamp && state.deltaTime == 3000);
+}
@@ -0,0 +1,229 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Haptics.h>
+#include <DualSenseWindows/DS_CRC32.h>
+
+#include <string.h>
+
+// Expected header bytes and CRCs are regression values produced by this encoder, not packets captured from a device
+
+namespace {
+	const size_t HAPTICS_CRC_OFFSET = DS_OUTPUT_REPORT_BT_HAPTICS_SIZE - sizeof(UINT32);
+
+	// Report ID and sequence, control packet, then the header of the samples packet
+	const unsigned char SILENCE_HEADER[] = {
+		0x32, 0x00,
+		0x91, 0x07, 0xFE, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+		0x92, 0x40,
+	};
+
+	const unsigned char RAMP_HEADER[] = {
+		0x32, 0x30,
+		0x91, 0x07, 0xFE, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x03,
+		0x92, 0x40,
+	};
+
+	UINT32 reportCrc(const unsigned char* report)
+	{
+		UINT32 crc;
+		memcpy(&crc, &report[HAPTICS_CRC_OFFSET], sizeof(crc));
+		return crc;
+	}
+
+	// Samples packet ends at the CRC, the rest of the report is padding
+	bool paddingIsZero(const unsigned char* report)
+	{
+		for (size_t i = sizeof(SILENCE_HEADER) + DS_HAPTICS_FRAMES_PER_REPORT * 2; i < HAPTICS_CRC_OFFSET; i++) {
+			if (report[i] != 0)
+				return false;
+		}
+		return true;
+	}
+
+	using DS5WTest::context;
+
+	short input[(DS5W_HAPTICS_RING_FRAMES + 16) * 2];
+	signed char samples[DS_HAPTICS_FRAMES_PER_REPORT * 2];
+
+	void start()
+	{
+		DS5WTest::resetContext(&context);
+	}
+
+	// Queue frames of constant value, left and right in full 16 bit range
+	void queue(short left, short right, unsigned int frameCount, unsigned int sampleRate)
+	{
+		for (unsigned int i = 0; i < frameCount; i++) {
+			input[i * 2 + 0] = left;
+			input[i * 2 + 1] = right;
+		}
+		__DS5W::Haptics::queueFrames(&context, input, frameCount, sampleRate);
+	}
+
+	DS5W::DS5HapticsStreamStatistics statistics()
+	{
+		DS5W::DS5HapticsStreamStatistics result;
+		__DS5W::Haptics::getStatistics(&context, &result);
+		return result;
+	}
+
+	bool samplesAre(unsigned int from, unsigned int to, signed char left, signed char right)
+	{
+		for (unsigned int i = from; i < to; i++) {
+			if (samples[i * 2 + 0] != left || samples[i * 2 + 1] != right)
+				return false;
+		}
+		return true;
+	}
+}
+
+DS5W_TEST(hapticsEncodesSilence)
+{
+	const signed char samples[DS_HAPTICS_FRAMES_PER_REPORT * 2] = {};
+	unsigned char report[DS_OUTPUT_REPORT_BT_HAPTICS_SIZE];
+	memset(report, 0xCC, sizeof(report));
+
+	__DS5W::Haptics::encodeReport(report, 0, samples);
+
+	DS5W_CHECK(memcmp(report, SILENCE_HEADER, sizeof(SILENCE_HEADER)) == 0);
+	DS5W_CHECK(memcmp(&report[sizeof(SILENCE_HEADER)], samples, sizeof(samples)) == 0);
+	DS5W_CHECK(paddingIsZero(report));
+	DS5W_CHECK(reportCrc(report) == 0x34564A16);
+}
+
+DS5W_TEST(hapticsEncodesSamplesAndSequence)
+{
+	signed char samples[DS_HAPTICS_FRAMES_PER_REPORT * 2];
+	for (int i = 0; i < DS_HAPTICS_FRAMES_PER_REPORT * 2; i++)
+		samples[i] = (signed char)(i * 4 - 128);
+	unsigned char report[DS_OUTPUT_REPORT_BT_HAPTICS_SIZE];
+
+	// Only the lower 4 bits of the sequence are sent
+	__DS5W::Haptics::encodeReport(report, 0x13, samples);
+
+	DS5W_CHECK(memcmp(report, RAMP_HEADER, sizeof(RAMP_HEADER)) == 0);
+	DS5W_CHECK(memcmp(&report[sizeof(RAMP_HEADER)], samples, sizeof(samples)) == 0);
+	DS5W_CHECK(paddingIsZero(report));
+	DS5W_CHECK(reportCrc(report) == 0x1DC59C96);
+}
+
+DS5W_TEST(hapticsCrcMatchesFullHash)
+{
+	signed char samples[DS_HAPTICS_FRAMES_PER_REPORT * 2];
+	unsigned char report[DS_OUTPUT_REPORT_BT_HAPTICS_SIZE];
+
+	for (int sequence = 0; sequence < 64; sequence++) {
+		for (int i = 0; i < DS_HAPTICS_FRAMES_PER_REPORT * 2; i++)
+			samples[i] = (signed char)(i * sequence);
+
+		__DS5W::Haptics::encodeReport(report, (unsigned char)sequence, samples);
+		DS5W_CHECK(report[0x01] == (sequence & 0x0F) << 4 && report[0x0A] == (sequence & 0x0F));
+		DS5W_CHECK(reportCrc(report) == __DS5W::CRC32::computeBytewise(report, HAPTICS_CRC_OFFSET));
+	}
+}
+
+DS5W_TEST(hapticsDownsamplesByAveraging)
+{
+	start();
+
+	// 16 input frames per output frame, alternating values average out
+	for (unsigned int i = 0; i < DS_HAPTICS_FRAMES_PER_REPORT * 16; i++) {
+		input[i * 2 + 0] = (i & 1) ? 0x3000 : 0x1000;
+		input[i * 2 + 1] = -0x4000;
+	}
+	__DS5W::Haptics::queueFrames(&context, input, DS_HAPTICS_FRAMES_PER_REPORT * 16, 48000);
+
+	DS5W_CHECK(statistics().queuedFrames == DS_HAPTICS_FRAMES_PER_REPORT);
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == DS_HAPTICS_FRAMES_PER_REPORT);
+	DS5W_CHECK(samplesAre(0, DS_HAPTICS_FRAMES_PER_REPORT, 0x20, -0x40));
+	DS5W_CHECK(statistics().queuedFrames == 0 && statistics().underruns == 0);
+}
+
+DS5W_TEST(hapticsUpsamplesByRepeating)
+{
+	start();
+
+	for (unsigned int i = 0; i < DS_HAPTICS_FRAMES_PER_REPORT / 2; i++) {
+		input[i * 2 + 0] = (short)(i * 0x100);
+		input[i * 2 + 1] = (short)(i * -0x100);
+	}
+	__DS5W::Haptics::queueFrames(&context, input, DS_HAPTICS_FRAMES_PER_REPORT / 2, DS_HAPTICS_SAMPLE_RATE / 2);
+
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == DS_HAPTICS_FRAMES_PER_REPORT);
+	bool repeated = true;
+	for (unsigned int i = 0; i < DS_HAPTICS_FRAMES_PER_REPORT; i++) {
+		if (samples[i * 2 + 0] != (signed char)(i / 2) || samples[i * 2 + 1] != (signed char)-(int)(i / 2))
+			repeated = false;
+	}
+	DS5W_CHECK(repeated);
+}
+
+DS5W_TEST(hapticsRestartsResamplingOnRateChange)
+{
+	start();
+
+	// Half an output frame at 48 kHz is forgotten when the rate changes
+	queue(0x7F00, 0x7F00, 8, 48000);
+	DS5W_CHECK(statistics().queuedFrames == 0);
+	queue(0x0100, -0x0100, 1, DS_HAPTICS_SAMPLE_RATE);
+
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == 1);
+	DS5W_CHECK(samplesAre(0, 1, 1, -1));
+}
+
+DS5W_TEST(hapticsCountsOverruns)
+{
+	start();
+
+	// Frames past a full ring are dropped, one overrun per write
+	queue(0x100, 0x100, DS5W_HAPTICS_RING_FRAMES + 10, DS_HAPTICS_SAMPLE_RATE);
+	DS5W::DS5HapticsStreamStatistics result = statistics();
+	DS5W_CHECK(result.queuedFrames == DS5W_HAPTICS_RING_FRAMES);
+	DS5W_CHECK(result.overruns == 1 && result.droppedFrames == 10);
+
+	queue(0x100, 0x100, 5, DS_HAPTICS_SAMPLE_RATE);
+	result = statistics();
+	DS5W_CHECK(result.overruns == 2 && result.droppedFrames == 15);
+
+	// Taking a report makes room again
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == DS_HAPTICS_FRAMES_PER_REPORT);
+	queue(0x100, 0x100, DS_HAPTICS_FRAMES_PER_REPORT, DS_HAPTICS_SAMPLE_RATE);
+	result = statistics();
+	DS5W_CHECK(result.overruns == 2 && result.queuedFrames == DS5W_HAPTICS_RING_FRAMES);
+}
+
+DS5W_TEST(hapticsCountsUnderruns)
+{
+	start();
+
+	// Idle stream is not an underrun
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == 0);
+	DS5W_CHECK(statistics().underruns == 0);
+
+	queue(0x200, -0x200, DS_HAPTICS_FRAMES_PER_REPORT + 8, DS_HAPTICS_SAMPLE_RATE);
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == DS_HAPTICS_FRAMES_PER_REPORT);
+	DS5W_CHECK(statistics().underruns == 0);
+
+	// Short report is padded with silence
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == 8);
+	DS5W_CHECK(samplesAre(0, 8, 2, -2) && samplesAre(8, DS_HAPTICS_FRAMES_PER_REPORT, 0, 0));
+	DS5W_CHECK(statistics().underruns == 1);
+
+	// Already stopped streaming, running dry is not counted again
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == 0);
+	DS5W_CHECK(statistics().underruns == 1);
+
+	// Ring running dry right after a full report
+	queue(0x200, -0x200, DS_HAPTICS_FRAMES_PER_REPORT, DS_HAPTICS_SAMPLE_RATE);
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == DS_HAPTICS_FRAMES_PER_REPORT);
+	DS5W_CHECK(__DS5W::Haptics::takeReportFrames(&context, samples) == 0);
+	DS5W_CHECK(statistics().underruns == 2);
+}
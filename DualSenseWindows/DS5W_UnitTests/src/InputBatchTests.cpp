@@ -0,0 +1,181 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+	const unsigned int REPORT_COUNT = 10007;
+	const unsigned int REPORT_STRIDE = 64;
+
+	DS5W::DeviceContext scalarContext;
+	DS5W::DeviceContext batchContext;
+
+	// Random report bodies with sensor timestamps that mostly advance, sometimes stall, step back and wrap
+	std::vector<unsigned char> makeReports()
+	{
+		std::vector<unsigned char> reports(REPORT_COUNT * REPORT_STRIDE);
+		srand(1);
+		for (unsigned char& value : reports)
+			value = (unsigned char)rand();
+
+		unsigned int time = 0xFFFF0000u;
+		for (unsigned int i = 0; i < REPORT_COUNT; i++) {
+			if (rand() % 50 == 0)
+				time -= 100;
+			else if (rand() % 40 != 0)
+				time += 3000 + rand() % 50;
+			DS5WTest::setReportTimestamp(&reports[i * REPORT_STRIDE], time);
+		}
+
+		return reports;
+	}
+
+	void resetContext(DS5W::DeviceContext* ptrContext)
+	{
+		DS5WTest::resetContext(ptrContext);
+		DS5WTest::calibrate(ptrContext);
+		ptrContext->_internal.timestamp = 12345;
+	}
+
+	bool sameTouch(const DS5W::Touch& a, const DS5W::Touch& b)
+	{
+		return a.x == b.x && a.y == b.y && a.down == b.down && a.id == b.id;
+	}
+}
+
+DS5W_TEST(batchDecodeMatchesScalarDecode)
+{
+	std::vector<unsigned char> reports = makeReports();
+	resetContext(&scalarContext);
+	resetContext(&batchContext);
+
+	std::vector<char> leftX(REPORT_COUNT), leftY(REPORT_COUNT), rightX(REPORT_COUNT), rightY(REPORT_COUNT);
+	std::vector<unsigned char> leftTrigger(REPORT_COUNT), rightTrigger(REPORT_COUNT);
+	std::vector<unsigned int> buttons(REPORT_COUNT), currentTime(REPORT_COUNT), deltaTime(REPORT_COUNT);
+	std::vector<int> gyro[3], accel[3];
+	std::vector<DS5W::Touch> touch1(REPORT_COUNT), touch2(REPORT_COUNT);
+	for (int axis = 0; axis < 3; axis++) {
+		gyro[axis].resize(REPORT_COUNT);
+		accel[axis].resize(REPORT_COUNT);
+	}
+
+	DS5W::DS5InputBatch batch;
+	batch.leftStickX = leftX.data();
+	batch.leftStickY = leftY.data();
+	batch.rightStickX = rightX.data();
+	batch.rightStickY = rightY.data();
+	batch.leftTrigger = leftTrigger.data();
+	batch.rightTrigger = rightTrigger.data();
+	batch.buttonMap = buttons.data();
+	batch.gyroscopeX = gyro[0].data();
+	batch.gyroscopeY = gyro[1].data();
+	batch.gyroscopeZ = gyro[2].data();
+	batch.accelerometerX = accel[0].data();
+	batch.accelerometerY = accel[1].data();
+	batch.accelerometerZ = accel[2].data();
+	batch.touchPoint1 = touch1.data();
+	batch.touchPoint2 = touch2.data();
+	batch.currentTime = currentTime.data();
+	batch.deltaTime = deltaTime.data();
+
+	__DS5W::Input::evaluateHidInputBatch(reports.data(), REPORT_STRIDE, REPORT_COUNT, &batch, &batchContext);
+
+	for (unsigned int i = 0; i < REPORT_COUNT; i++) {
+		DS5W::DS5InputState state;
+		__DS5W::Input::evaluateHidInputBuffer(&reports[i * REPORT_STRIDE], &state, &scalarContext);
+
+		DS5W_CHECK(state.leftStick.x == leftX[i] && state.leftStick.y == leftY[i]);
+		DS5W_CHECK(state.rightStick.x == rightX[i] && state.rightStick.y == rightY[i]);
+		DS5W_CHECK(state.leftTrigger == leftTrigger[i] && state.rightTrigger == rightTrigger[i]);
+		DS5W_CHECK(state.buttonMap == buttons[i]);
+		DS5W_CHECK(state.gyroscope.x == gyro[0][i] && state.gyroscope.y == gyro[1][i] && state.gyroscope.z == gyro[2][i]);
+		DS5W_CHECK(state.accelerometer.x == accel[0][i] && state.accelerometer.y == accel[1][i] && state.accelerometer.z == accel[2][i]);
+		DS5W_CHECK(sameTouch(state.touchPoint1, touch1[i]) && sameTouch(state.touchPoint2, touch2[i]));
+		DS5W_CHECK(state.currentTime == currentTime[i] && state.deltaTime == deltaTime[i]);
+	}
+
+	DS5W_CHECK(scalarContext._internal.timestamp == batchContext._internal.timestamp);
+}
+
+DS5W_TEST(batchDecodeHandlesEveryTailLength)
+{
+	std::vector<unsigned char> reports = makeReports();
+
+	// Lengths around the SIMD width take the vector loop, the scalar tail or both
+	for (unsigned int count = 0; count <= 9; count++) {
+		resetContext(&scalarContext);
+		resetContext(&batchContext);
+
+		char leftX[9], leftY[9], rightX[9], rightY[9];
+		unsigned char leftTrigger[9], rightTrigger[9];
+		unsigned int buttons[9], currentTime[9], deltaTime[9];
+		int gyro[3][9], accel[3][9];
+		DS5W::Touch touch1[9], touch2[9];
+
+		DS5W::DS5InputBatch batch = {
+			leftX, leftY, rightX, rightY, leftTrigger, rightTrigger, buttons,
+			gyro[0], gyro[1], gyro[2], accel[0], accel[1], accel[2],
+			touch1, touch2, currentTime, deltaTime
+		};
+		__DS5W::Input::evaluateHidInputBatch(reports.data(), REPORT_STRIDE, count, &batch, &batchContext);
+
+		for (unsigned int i = 0; i < count; i++) {
+			DS5W::DS5InputState state;
+			__DS5W::Input::evaluateHidInputBuffer(&reports[i * REPORT_STRIDE], &state, &scalarContext);
+
+			DS5W_CHECK(state.leftStick.x == leftX[i] && state.rightTrigger == rightTrigger[i]);
+			DS5W_CHECK(state.buttonMap == buttons[i]);
+			DS5W_CHECK(state.gyroscope.z == gyro[2][i] && state.accelerometer.x == accel[0][i]);
+			DS5W_CHECK(sameTouch(state.touchPoint2, touch2[i]));
+			DS5W_CHECK(state.deltaTime == deltaTime[i]);
+		}
+
+		DS5W_CHECK(scalarContext._internal.timestamp == batchContext._internal.timestamp);
+	}
+}
+
+DS5W_TEST(batchDecodeLeavesConditioningAlone)
+{
+	std::vector<unsigned char> reports = makeReports();
+	resetContext(&scalarContext);
+	resetContext(&batchContext);
+
+	// Empty tables would zero every conditioned stick and trigger
+	batchContext._internal.conditioning.enabled = true;
+
+	char leftX[9], leftY[9], rightX[9], rightY[9];
+	unsigned char leftTrigger[9], rightTrigger[9];
+	unsigned int buttons[9], currentTime[9], deltaTime[9];
+	int gyro[3][9], accel[3][9];
+	DS5W::Touch touch1[9], touch2[9];
+
+	DS5W::DS5InputBatch batch = {
+		leftX, leftY, rightX, rightY, leftTrigger, rightTrigger, buttons,
+		gyro[0], gyro[1], gyro[2], accel[0], accel[1], accel[2],
+		touch1, touch2, currentTime, deltaTime
+	};
+	__DS5W::Input::evaluateHidInputBatch(reports.data(), REPORT_STRIDE, 9, &batch, &batchContext);
+
+	// Raw values in the SIMD blocks and the scalar tail
+	for (unsigned int i = 0; i < 9; i++) {
+		DS5W::DS5InputState state;
+		__DS5W::Input::evaluateHidInputBuffer(&reports[i * REPORT_STRIDE], &state, &scalarContext);
+
+		DS5W_CHECK(state.leftStick.x == leftX[i] && state.rightStick.y == rightY[i]);
+		DS5W_CHECK(state.leftTrigger == leftTrigger[i] && state.rightTrigger == rightTrigger[i]);
+		DS5W_CHECK(state.buttonMap == buttons[i]);
+	}
+
+	DS5W_CHECK(batchContext._internal.conditioning.enabled);
+}
@@ -0,0 +1,141 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <string.h>
+
+namespace {
+	using DS5WTest::context;
+	using DS5WTest::REPORT_TICKS;
+
+	unsigned char report[64];
+	DS5W::DS5InputEvent events[16];
+	unsigned int timestamp;
+
+	// Centered sticks, released triggers, buttons and touch points
+	void start(unsigned char stickThreshold, unsigned char triggerThreshold)
+	{
+		DS5WTest::resetContext(&context);
+		context._internal.inputEvents.stickThreshold = stickThreshold;
+		context._internal.inputEvents.triggerThreshold = triggerThreshold;
+
+		memset(report, 0, sizeof(report));
+		report[0x00] = 128;
+		report[0x01] = 127;
+		report[0x02] = 128;
+		report[0x03] = 127;
+		report[0x07] = 0x08;
+		report[0x23] = 0x80;
+		report[0x27] = 0x80;
+		timestamp = 1000;
+
+		__DS5W::Input::evaluateHidInputEvents(report, events, 16, &context);
+	}
+
+	// Events of the report as it is written, motion and time always change
+	unsigned int next(unsigned int maxEvents = 16)
+	{
+		timestamp += REPORT_TICKS;
+		DS5WTest::setReportTimestamp(report, timestamp);
+		report[0x0F]++;
+		report[0x15]--;
+		return __DS5W::Input::evaluateHidInputEvents(report, events, maxEvents, &context);
+	}
+}
+
+DS5W_TEST(inputEventsIgnoreMotionAndTime)
+{
+	start(0, 0);
+	DS5W_CHECK(next() == 0);
+	DS5W_CHECK(next() == 0);
+}
+
+DS5W_TEST(inputEventsReportButtonEdges)
+{
+	start(0, 0);
+
+	report[0x07] = 0x28;
+	DS5W_CHECK(next() == 1);
+	DS5W_CHECK(events[0].type == DS5W::InputEventType::ButtonDown && events[0].button == DS5W_ISTATE_BTN_CROSS);
+
+	// Held button is no news
+	DS5W_CHECK(next() == 0);
+
+	// Release and dpad press in one report
+	report[0x07] = 0x00;
+	DS5W_CHECK(next() == 2);
+	DS5W_CHECK(events[0].type == DS5W::InputEventType::ButtonDown && events[0].button == DS5W_ISTATE_BTN_DPAD_UP);
+	DS5W_CHECK(events[1].type == DS5W::InputEventType::ButtonUp && events[1].button == DS5W_ISTATE_BTN_CROSS);
+}
+
+DS5W_TEST(inputEventsWaitForStickThreshold)
+{
+	start(4, 0);
+
+	// Below the threshold from the last reported position
+	report[0x00] = 131;
+	DS5W_CHECK(next() == 0);
+
+	report[0x00] = 132;
+	DS5W_CHECK(next() == 1);
+	DS5W_CHECK(events[0].type == DS5W::InputEventType::LeftStickMoved && events[0].stick.x == 4 && events[0].stick.y == 0);
+
+	// Slow drift adds up against the last event, not the last report
+	unsigned int moved = 0;
+	for (int i = 1; i <= 4; i++) {
+		report[0x03] = (unsigned char)(127 - i);
+		moved += next();
+	}
+	DS5W_CHECK(moved == 1);
+	DS5W_CHECK(events[0].type == DS5W::InputEventType::RightStickMoved && events[0].stick.y == 4);
+}
+
+DS5W_TEST(inputEventsWaitForTriggerThreshold)
+{
+	start(0, 10);
+
+	report[0x04] = 9;
+	DS5W_CHECK(next() == 0);
+
+	report[0x04] = 10;
+	report[0x05] = 200;
+	DS5W_CHECK(next() == 2);
+	DS5W_CHECK(events[0].type == DS5W::InputEventType::LeftTriggerMoved && events[0].trigger == 10);
+	DS5W_CHECK(events[1].type == DS5W::InputEventType::RightTriggerMoved && events[1].trigger == 200);
+
+	// Back down by less than the threshold
+	report[0x05] = 191;
+	DS5W_CHECK(next() == 0);
+}
+
+DS5W_TEST(inputEventsThresholdZeroReportsEveryChange)
+{
+	start(0, 0);
+
+	report[0x02] = 129;
+	report[0x05] = 1;
+	DS5W_CHECK(next() == 2);
+	DS5W_CHECK(events[0].type == DS5W::InputEventType::RightStickMoved && events[0].stick.x == 1);
+	DS5W_CHECK(events[1].type == DS5W::InputEventType::RightTriggerMoved && events[1].trigger == 1);
+}
+
+DS5W_TEST(inputEventsCountEventsPastTheArray)
+{
+	start(0, 0);
+
+	report[0x07] = 0x38;
+	report[0x04] = 50;
+	DS5W_CHECK(next(1) == 3);
+	DS5W_CHECK(events[0].type == DS5W::InputEventType::ButtonDown && events[0].button == DS5W_ISTATE_BTN_SQUARE);
+
+	// Dropped events still moved the tracker on
+	DS5W_CHECK(next() == 0);
+}
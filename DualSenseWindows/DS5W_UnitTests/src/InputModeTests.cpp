@@ -0,0 +1,132 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_InputMode.h>
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <string.h>
+
+namespace {
+	using DS5WTest::context;
+
+	unsigned char report[DS_INPUT_REPORT_USB_SIZE];
+
+	// Not connected, the queue length is only applied on reconnect
+	void start()
+	{
+		DS5WTest::resetContext(&context);
+		memset(report, 0, sizeof(report));
+		__DS5W::InputMode::init(&context);
+	}
+
+	// Read the report with the given sequence number
+	void receive(unsigned char sequenceNumber)
+	{
+		DS5WTest::setReportSequence(report, sequenceNumber);
+		__DS5W::Input::trackReportSequence(report, &context);
+		__DS5W::InputMode::onInputReport(&context);
+	}
+
+	DS5W::DS5InputModeStatistics statistics()
+	{
+		DS5W::DS5InputModeStatistics result;
+		__DS5W::InputMode::getStatistics(&context, &result);
+		return result;
+	}
+}
+
+DS5W_TEST(inputModeStartsFlushingWithSystemQueue)
+{
+	start();
+
+	const DS5W::DS5InputModeStatistics result = statistics();
+	DS5W_CHECK(result.mode == DS5W::InputMode::Flush);
+	DS5W_CHECK(result.queueLength == __DS5W::InputMode::SYSTEM_QUEUE_LENGTH);
+	DS5W_CHECK(__DS5W::InputMode::flushesQueue(&context));
+}
+
+DS5W_TEST(inputModeValidatesQueueLength)
+{
+	start();
+
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::EveryReport, 0) == DS5W_OK);
+	DS5W_CHECK(statistics().queueLength == DS5W_INPUT_QUEUE_DEFAULT);
+
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::EveryReport, DS5W_INPUT_QUEUE_MAX) == DS5W_OK);
+	DS5W_CHECK(statistics().queueLength == DS5W_INPUT_QUEUE_MAX);
+
+	// Rejected lengths and modes keep the current mode
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::EveryReport, DS5W_INPUT_QUEUE_MIN - 1) == DS5W_E_INVALID_ARGS);
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::EveryReport, DS5W_INPUT_QUEUE_MAX + 1) == DS5W_E_INVALID_ARGS);
+	DS5W_CHECK(__DS5W::InputMode::set(&context, (DS5W::InputMode)7, 0) == DS5W_E_INVALID_ARGS);
+
+	const DS5W::DS5InputModeStatistics result = statistics();
+	DS5W_CHECK(result.mode == DS5W::InputMode::EveryReport);
+	DS5W_CHECK(result.queueLength == DS5W_INPUT_QUEUE_MAX);
+	DS5W_CHECK(!__DS5W::InputMode::flushesQueue(&context));
+}
+
+DS5W_TEST(inputModeIgnoresQueueLengthOfOtherModes)
+{
+	start();
+
+	// Flush restores the length Windows opens devices with
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::EveryReport, 64) == DS5W_OK);
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::Flush, 5) == DS5W_OK);
+	DS5W_CHECK(statistics().queueLength == __DS5W::InputMode::SYSTEM_QUEUE_LENGTH);
+	DS5W_CHECK(__DS5W::InputMode::flushesQueue(&context));
+
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::LatestOnly, 64) == DS5W_OK);
+	DS5W_CHECK(statistics().queueLength == DS5W_INPUT_QUEUE_MIN);
+	DS5W_CHECK(!__DS5W::InputMode::flushesQueue(&context));
+}
+
+DS5W_TEST(inputModeCountsDrains)
+{
+	start();
+
+	// Empty drains are not counted
+	__DS5W::InputMode::onDrain(&context, 0);
+	__DS5W::InputMode::onDrain(&context, 3);
+	__DS5W::InputMode::onDrain(&context, 7);
+	__DS5W::InputMode::onDrain(&context, 2);
+
+	const DS5W::DS5InputModeStatistics result = statistics();
+	DS5W_CHECK(result.drained == 12);
+	DS5W_CHECK(result.drains == 3);
+	DS5W_CHECK(result.largestDrain == 7);
+}
+
+DS5W_TEST(inputModeCountsSkippedReports)
+{
+	start();
+
+	receive(1);
+	receive(2);
+	DS5W_CHECK(statistics().skipped == 0);
+
+	// Two reports flushed before the read, then one more
+	receive(5);
+	receive(7);
+	DS5W_CHECK(statistics().skipped == 3);
+}
+
+DS5W_TEST(inputModeResetsCountersWhenSet)
+{
+	start();
+
+	receive(1);
+	receive(4);
+	__DS5W::InputMode::onDrain(&context, 3);
+	DS5W_CHECK(__DS5W::InputMode::set(&context, DS5W::InputMode::EveryReport, 0) == DS5W_OK);
+
+	const DS5W::DS5InputModeStatistics result = statistics();
+	DS5W_CHECK(result.skipped == 0 && result.drained == 0 && result.drains == 0 && result.largestDrain == 0);
+}
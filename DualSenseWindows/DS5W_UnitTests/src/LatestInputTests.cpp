@@ -0,0 +1,113 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_LatestInput.h>
+
+#include <thread>
+
+namespace {
+	using DS5WTest::context;
+
+	const unsigned int PUBLISHED = 200000;
+
+	void start()
+	{
+		DS5WTest::resetContext(&context);
+		__DS5W::LatestInput::reset(&context);
+	}
+
+	// Stands in for the thread decoding report number, every checked field is derived from the number
+	// A torn copy mixes fields of two reports
+	void publish(unsigned int number)
+	{
+		DS5W::DS5InputState state = {};
+		state.currentTime = number;
+		state.buttonMap = ~number;
+		state.leftTrigger = (unsigned char)number;
+
+		for (int i = 0; i < 4; i++)
+			context._internal.motionFusion.orientation[i] = (float)number;
+		context._internal.motionFusion.timestamp = number;
+		context._internal.touchTracker.contacts[1].id = (unsigned char)number;
+		context._internal.touchTracker.timestamp = number;
+
+		__DS5W::LatestInput::publish(&context, &state);
+	}
+}
+
+DS5W_TEST(latestInputPublishesWholeStates)
+{
+	start();
+
+	std::thread decoder([] {
+		for (unsigned int number = 1; number <= PUBLISHED; number++)
+			publish(number);
+	});
+
+	bool whole = true;
+	bool ordered = true;
+	unsigned int last = 0;
+	for (;;) {
+		DS5W::DS5InputState state;
+		unsigned int version;
+		if (!__DS5W::LatestInput::read(&context, &state, &version))
+			continue;
+
+		// The version counts publishes, so it names the report the copy came from
+		if (state.currentTime != version || state.buttonMap != ~version || state.leftTrigger != (unsigned char)version)
+			whole = false;
+		if (version < last)
+			ordered = false;
+
+		// Published after the input state was read, never older than it
+		DS5W::DS5MotionState motion;
+		__DS5W::LatestInput::readMotion(&context, &motion);
+		if (motion.orientation.w != (float)motion.currentTime || motion.orientation.z != (float)motion.currentTime || motion.currentTime < version)
+			whole = false;
+
+		DS5W::DS5TouchState touch;
+		__DS5W::LatestInput::readTouch(&context, &touch);
+		if (touch.contacts[1].id != (unsigned char)touch.currentTime || touch.currentTime < version)
+			whole = false;
+
+		last = version;
+		if (version == PUBLISHED)
+			break;
+	}
+
+	decoder.join();
+
+	DS5W_CHECK(whole);
+	DS5W_CHECK(ordered);
+}
+
+DS5W_TEST(latestInputResetCopiesTrackers)
+{
+	start();
+	publish(5);
+
+	// Reads taken over by another owner start from the trackers, before any report
+	context._internal.motionFusion.timestamp = 9;
+	context._internal.touchTracker.timestamp = 11;
+	__DS5W::LatestInput::reset(&context);
+
+	DS5W::DS5InputState state;
+	unsigned int version;
+	DS5W_CHECK(!__DS5W::LatestInput::read(&context, &state, &version));
+	DS5W_CHECK(version == 0);
+
+	DS5W::DS5MotionState motion;
+	__DS5W::LatestInput::readMotion(&context, &motion);
+	DS5W_CHECK(motion.currentTime == 9);
+
+	DS5W::DS5TouchState touch;
+	__DS5W::LatestInput::readTouch(&context, &touch);
+	DS5W_CHECK(touch.currentTime == 11);
+}
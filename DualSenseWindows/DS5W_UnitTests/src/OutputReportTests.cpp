@@ -0,0 +1,292 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Output.h>
+#include <DualSenseWindows/DS5_OutputTimeline.h>
+#include <DualSenseWindows/DS5_OutputWriter.h>
+#include <DualSenseWindows/IO.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+	using DS5WTest::context;
+
+	// Report body as written field by field before OutputReportView
+	void referenceBody(unsigned char* body, const DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems)
+	{
+		const unsigned short flags = __DS5W::Output::outputFlags(subsystems);
+		body[0x00] = flags & 0x00FF;
+		body[0x01] = (flags & 0xFF00) >> 8;
+
+		body[0x02] = ptrOutputState->rightRumble;
+		body[0x03] = ptrOutputState->leftRumble;
+		body[0x08] = (unsigned char)ptrOutputState->microphoneLed;
+		body[0x24] = ptrOutputState->rumbleStrength;
+
+		body[0x26] = ((subsystems & DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS) ? 0x01 : 0) |
+			((subsystems & DS5W_OSTATE_SUBSYSTEM_LIGHTBAR) ? 0x02 : 0);
+		body[0x29] = ptrOutputState->disableLeds ? 0x01 : 0x02;
+		body[0x2A] = ptrOutputState->playerLeds.brightness;
+		body[0x2B] = ptrOutputState->playerLeds.bitmask;
+		if (ptrOutputState->playerLeds.playerLedFade)
+			body[0x2B] &= ~(0x20);
+		else
+			body[0x2B] |= 0x20;
+
+		body[0x2C] = ptrOutputState->lightbar.r;
+		body[0x2D] = ptrOutputState->lightbar.g;
+		body[0x2E] = ptrOutputState->lightbar.b;
+
+		memcpy(&body[0x0A], &ptrOutputState->rightTriggerEffect, 11);
+		memcpy(&body[0x15], &ptrOutputState->leftTriggerEffect, 11);
+	}
+
+	void randomState(DS5W::DS5OutputState* ptrOutputState)
+	{
+		unsigned char* bytes = (unsigned char*)ptrOutputState;
+		for (size_t i = 0; i < sizeof(DS5W::DS5OutputState); i++)
+			bytes[i] = (unsigned char)rand();
+
+		// Keep bools valid
+		ptrOutputState->disableLeds = (rand() & 1) != 0;
+		ptrOutputState->playerLeds.playerLedFade = (rand() & 1) != 0;
+	}
+
+	// Fields of one DS5W_OSTATE_SUBSYSTEM_ bit are equal in both states
+	bool sameSubsystem(const DS5W::DS5OutputState& a, const DS5W::DS5OutputState& b, unsigned int subsystem)
+	{
+		switch (subsystem) {
+			case DS5W_OSTATE_SUBSYSTEM_RUMBLE:
+				return a.leftRumble == b.leftRumble && a.rightRumble == b.rightRumble;
+			case DS5W_OSTATE_SUBSYSTEM_LEFT_TRIGGER:
+				return memcmp(&a.leftTriggerEffect, &b.leftTriggerEffect, sizeof(DS5W::TriggerEffect)) == 0;
+			case DS5W_OSTATE_SUBSYSTEM_RIGHT_TRIGGER:
+				return memcmp(&a.rightTriggerEffect, &b.rightTriggerEffect, sizeof(DS5W::TriggerEffect)) == 0;
+			case DS5W_OSTATE_SUBSYSTEM_MIC_LED:
+				return a.microphoneLed == b.microphoneLed;
+			case DS5W_OSTATE_SUBSYSTEM_LIGHTBAR:
+				return a.lightbar.r == b.lightbar.r && a.lightbar.g == b.lightbar.g && a.lightbar.b == b.lightbar.b && a.disableLeds == b.disableLeds;
+			case DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS:
+				return a.playerLeds.bitmask == b.playerLeds.bitmask && a.playerLeds.playerLedFade == b.playerLeds.playerLedFade &&
+					a.playerLeds.brightness == b.playerLeds.brightness;
+			case DS5W_OSTATE_SUBSYSTEM_MOTOR_STRENGTH:
+				return a.rumbleStrength == b.rumbleStrength;
+			default:
+				return false;
+		}
+	}
+
+	void start(DS5W::DeviceConnection connection)
+	{
+		DS5WTest::resetContext(&context, connection);
+	}
+}
+
+DS5W_TEST(outputViewMatchesReferenceBody)
+{
+	srand(11);
+	for (int i = 0; i < 100000; i++) {
+		DS5W::DS5OutputState state;
+		randomState(&state);
+		const unsigned int subsystems = rand() & DS5W_OSTATE_SUBSYSTEM_ALL;
+
+		unsigned char expected[DS_OUTPUT_REPORT_BODY_SIZE] = {};
+		unsigned char body[DS_OUTPUT_REPORT_BODY_SIZE] = {};
+		referenceBody(expected, &state, subsystems);
+		__DS5W::Output::OutputReportView(body).writeState(&state, subsystems);
+		DS5W_CHECK(memcmp(body, expected, sizeof(body)) == 0);
+	}
+}
+
+DS5W_TEST(outputFlagsOfAllSubsystemsAreDefault)
+{
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_ALL) == DS5W::DefaultOutputFlags);
+}
+
+DS5W_TEST(outputFlagsFollowSubsystems)
+{
+	const unsigned short base = __DS5W::Output::outputFlags(0);
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_RUMBLE) ==
+		(base | (unsigned short)DS5W::OutputFlags::SetMainMotorsA | (unsigned short)DS5W::OutputFlags::SetMainMotorsB));
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_LEFT_TRIGGER) == (base | (unsigned short)DS5W::OutputFlags::SetTriggerMotorsB));
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_RIGHT_TRIGGER) == (base | (unsigned short)DS5W::OutputFlags::SetTriggerMotorsA));
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_MIC_LED) ==
+		(base | (unsigned short)DS5W::OutputFlags::SetMicrophoneLED | (unsigned short)DS5W::OutputFlags::SetAudioMicMute));
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_LIGHTBAR) == (base | (unsigned short)DS5W::OutputFlags::SetColorLED));
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS) == (base | (unsigned short)DS5W::OutputFlags::SetPlayerLED));
+	DS5W_CHECK(__DS5W::Output::outputFlags(DS5W_OSTATE_SUBSYSTEM_MOTOR_STRENGTH) == (base | (unsigned short)DS5W::OutputFlags::SetMotorStrength));
+
+	// Flags of a set are those of its subsystems
+	for (unsigned int subsystems = 0; subsystems <= DS5W_OSTATE_SUBSYSTEM_ALL; subsystems++) {
+		unsigned short expected = base;
+		for (unsigned int bit = 1; bit < DS5W_OSTATE_SUBSYSTEM_ALL; bit <<= 1) {
+			if (subsystems & bit)
+				expected |= __DS5W::Output::outputFlags(bit);
+		}
+		DS5W_CHECK(__DS5W::Output::outputFlags(subsystems) == expected);
+	}
+}
+
+DS5W_TEST(outputMergeCopiesOnlyGivenSubsystems)
+{
+	srand(17);
+	for (int i = 0; i < 10000; i++) {
+		DS5W::DS5OutputState target, source;
+		randomState(&target);
+		randomState(&source);
+		const unsigned int subsystems = rand() & DS5W_OSTATE_SUBSYSTEM_ALL;
+
+		DS5W::DS5OutputState merged = target;
+		__DS5W::Output::mergeOutputState(&merged, &source, subsystems);
+
+		for (unsigned int bit = 1; bit < DS5W_OSTATE_SUBSYSTEM_ALL; bit <<= 1)
+			DS5W_CHECK(sameSubsystem(merged, (subsystems & bit) ? source : target, bit));
+	}
+
+	// All subsystems copy every field the report encodes
+	start(DS5W::DeviceConnection::USB);
+	DS5W::DS5OutputState target, source;
+	randomState(&target);
+	randomState(&source);
+	__DS5W::Output::mergeOutputState(&target, &source, DS5W_OSTATE_SUBSYSTEM_ALL);
+	DS5W_CHECK(__DS5W::Output::createHIDOutputReport(&context, &source) > 0);
+	__DS5W::Output::rememberLastOutput(&context);
+	DS5W_CHECK(__DS5W::Output::matchesLastOutput(&context, &target));
+}
+
+DS5W_TEST(outputReportUsbLayout)
+{
+	start(DS5W::DeviceConnection::USB);
+
+	DS5W::DS5OutputState state = {};
+	state.leftRumble = 0x11;
+	state.rightRumble = 0x22;
+	state.lightbar.r = 0x33;
+	state.lightbar.g = 0x44;
+	state.lightbar.b = 0x55;
+
+	DS5W_CHECK(__DS5W::Output::createHIDOutputReport(&context, &state) == DS_OUTPUT_REPORT_USB_SIZE);
+
+	const unsigned char* report = context._internal.hidOutBuffer;
+	DS5W_CHECK(report[0] == DS_OUTPUT_REPORT_USB);
+	DS5W_CHECK(report[1 + 0x00] == (DS5W::DefaultOutputFlags & 0xFF));
+	DS5W_CHECK(report[1 + 0x01] == (DS5W::DefaultOutputFlags >> 8));
+	DS5W_CHECK(report[1 + 0x02] == 0x22);
+	DS5W_CHECK(report[1 + 0x03] == 0x11);
+	DS5W_CHECK(report[1 + 0x26] == 0x03);
+	DS5W_CHECK(report[1 + 0x2C] == 0x33 && report[1 + 0x2D] == 0x44 && report[1 + 0x2E] == 0x55);
+}
+
+DS5W_TEST(outputReportBtCrcMatchesFullHash)
+{
+	start(DS5W::DeviceConnection::BT);
+
+	// Consecutive reports take the incremental CRC path after the first
+	srand(12);
+	for (int i = 0; i < 2000; i++) {
+		DS5W::DS5OutputState state;
+		randomState(&state);
+		DS5W_CHECK(__DS5W::Output::createHIDOutputReport(&context, &state, rand() & DS5W_OSTATE_SUBSYSTEM_ALL) == DS_OUTPUT_REPORT_BT_SIZE);
+
+		const unsigned char* report = context._internal.hidOutBuffer;
+		DS5W_CHECK(report[0] == DS_OUTPUT_REPORT_BT && report[1] == 0x02);
+
+		UINT32 crc;
+		memcpy(&crc, &report[DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32)], sizeof(crc));
+		DS5W_CHECK(crc == __DS5W::CRC32::computeBytewise(report, DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32)));
+	}
+}
+
+DS5W_TEST(outputReportDisabled)
+{
+	start(DS5W::DeviceConnection::USB);
+
+	DS5W_CHECK(__DS5W::Output::createHIDOutputReportDisabled(&context) == DS_OUTPUT_REPORT_USB_SIZE);
+
+	const unsigned short flags = DS5W::DefaultOutputFlags | (unsigned short)DS5W::OutputFlags::DisableAllLED;
+	const unsigned char* body = &context._internal.hidOutBuffer[1];
+	DS5W_CHECK(body[0x00] == (flags & 0xFF) && body[0x01] == (flags >> 8));
+	DS5W_CHECK(body[0x0A] == (unsigned char)DS5W::TriggerEffectType::ReleaseAll);
+	DS5W_CHECK(body[0x15] == (unsigned char)DS5W::TriggerEffectType::ReleaseAll);
+}
+
+DS5W_TEST(outputUnchangedStateIsSkipped)
+{
+	const DS5W::DeviceConnection connections[] = { DS5W::DeviceConnection::USB, DS5W::DeviceConnection::BT };
+	for (DS5W::DeviceConnection connection : connections) {
+		start(connection);
+
+		DS5W::DS5OutputState state = {};
+		state.lightbar.g = 0xFF;
+
+		// Nothing sent yet
+		DS5W_CHECK(!__DS5W::Output::matchesLastOutput(&context, &state));
+
+		__DS5W::Output::createHIDOutputReport(&context, &state);
+		__DS5W::Output::rememberLastOutput(&context);
+		DS5W_CHECK(__DS5W::Output::matchesLastOutput(&context, &state));
+
+		// Any encoded field counts as a change
+		DS5W::DS5OutputState changed = state;
+		changed.playerLeds.playerLedFade = true;
+		DS5W_CHECK(!__DS5W::Output::matchesLastOutput(&context, &changed));
+		changed = state;
+		changed.rightTriggerEffect.effectType = DS5W::TriggerEffectType::ContinuousResitance;
+		DS5W_CHECK(!__DS5W::Output::matchesLastOutput(&context, &changed));
+
+		// A masked write is not the full state
+		__DS5W::Output::createHIDOutputReport(&context, &state, DS5W_OSTATE_SUBSYSTEM_LIGHTBAR);
+		__DS5W::Output::rememberLastOutput(&context);
+		DS5W_CHECK(!__DS5W::Output::matchesLastOutput(&context, &state));
+
+		__DS5W::Output::createHIDOutputReport(&context, &state);
+		__DS5W::Output::rememberLastOutput(&context);
+		__DS5W::Output::forgetLastOutput(&context);
+		DS5W_CHECK(!__DS5W::Output::matchesLastOutput(&context, &state));
+	}
+}
+
+DS5W_TEST(outputUpdateOfUnchangedStateWritesNothing)
+{
+	const DS5W::DeviceConnection connections[] = { DS5W::DeviceConnection::USB, DS5W::DeviceConnection::BT };
+	for (DS5W::DeviceConnection connection : connections) {
+		start(connection);
+		__DS5W::OutputWriter::init(&context);
+		__DS5W::OutputTimeline::init(&context);
+
+		DS5W::DS5OutputState state = {};
+		state.leftRumble = 0x40;
+		state.lightbar.b = 0xFF;
+		state.rightTriggerEffect.effectType = DS5W::TriggerEffectType::ContinuousResitance;
+		state.rightTriggerEffect.Continuous.force = 0x80;
+		bool written = true;
+
+		// Disconnected devices are refused before comparing
+		DS5W_CHECK(DS5W::updateDeviceOutputState(&context, &state, &written) == DS5W_E_DEVICE_REMOVED);
+		DS5W_CHECK(!written);
+
+		// The device handle is never opened, an attempted write would fail
+		context._internal.connected = true;
+		__DS5W::Output::createHIDOutputReport(&context, &state);
+		__DS5W::Output::rememberLastOutput(&context);
+		memset(context._internal.hidOutBuffer, 0, sizeof(context._internal.hidOutBuffer));
+
+		written = true;
+		DS5W_CHECK(DS5W::updateDeviceOutputState(&context, &state, &written) == DS5W_OK);
+		DS5W_CHECK(!written);
+		DS5W_CHECK(DS5W::updateDeviceOutputState(&context, &state, nullptr) == DS5W_OK);
+
+		// No report was built for the skipped states
+		unsigned char empty[sizeof(context._internal.hidOutBuffer)] = {};
+		DS5W_CHECK(memcmp(context._internal.hidOutBuffer, empty, sizeof(empty)) == 0);
+		DS5W_CHECK(__DS5W::Output::matchesLastOutput(&context, &state));
+	}
+}
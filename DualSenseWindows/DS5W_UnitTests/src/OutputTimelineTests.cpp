@@ -0,0 +1,114 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Output.h>
+#include <DualSenseWindows/DS5_OutputTimeline.h>
+
+#include <stdlib.h>
+
+namespace {
+	using DS5WTest::context;
+
+	// Timeline marked running without its thread, so events stay where schedule put them
+	void start()
+	{
+		DS5WTest::resetContext(&context);
+		__DS5W::OutputTimeline::init(&context);
+
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		context._internal.outputTimeline.hostFrequency = frequency.QuadPart;
+		context._internal.outputTimeline.running = true;
+	}
+
+	long long now()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	bool earlier(const DS5W::OutputTimelineEvent& a, const DS5W::OutputTimelineEvent& b)
+	{
+		return a.hostTime < b.hostTime || (a.hostTime == b.hostTime && a.order < b.order);
+	}
+}
+
+DS5W_TEST(timelineScheduleNeedsRunningTimeline)
+{
+	start();
+	context._internal.outputTimeline.running = false;
+
+	DS5W::DS5OutputState state = {};
+	DS5W_CHECK(__DS5W::OutputTimeline::schedule(&context, 0, &state, DS5W_OSTATE_SUBSYSTEM_ALL) == DS5W_E_CURRENTLY_NOT_SUPPORTED);
+	DS5W_CHECK(context._internal.outputTimeline.eventCount == 0);
+}
+
+DS5W_TEST(timelineKeepsEventsInDueOrder)
+{
+	start();
+	DS5W::OutputTimelineState& timeline = context._internal.outputTimeline;
+
+	// Many equal due times, those must stay in scheduling order
+	const long long base = now() + 10 * timeline.hostFrequency;
+	DS5W::DS5OutputState state = {};
+	srand(5);
+	for (int i = 0; i < DS5W_OUTPUT_TIMELINE_CAPACITY; i++) {
+		state.leftRumble = (unsigned char)i;
+		DS5W_CHECK(__DS5W::OutputTimeline::schedule(&context, base + rand() % 16, &state, DS5W_OSTATE_SUBSYSTEM_RUMBLE) == DS5W_OK);
+	}
+	DS5W_CHECK(__DS5W::OutputTimeline::schedule(&context, base, &state, DS5W_OSTATE_SUBSYSTEM_RUMBLE) == DS5W_E_INSUFFICIENT_BUFFER);
+	DS5W_CHECK(timeline.eventCount == DS5W_OUTPUT_TIMELINE_CAPACITY);
+	DS5W_CHECK(timeline.scheduled == DS5W_OUTPUT_TIMELINE_CAPACITY);
+
+	for (unsigned int i = 1; i < timeline.eventCount; i++)
+		DS5W_CHECK(!earlier(timeline.events[i], timeline.events[(i - 1) / 2]));
+
+	// Events keep the state they were scheduled with
+	for (unsigned int i = 0; i < timeline.eventCount; i++)
+		DS5W_CHECK(timeline.events[i].state.leftRumble == timeline.events[i].order);
+
+	__DS5W::OutputTimeline::clear(&context);
+	DS5W_CHECK(timeline.eventCount == 0);
+}
+
+DS5W_TEST(timelineImmediateEventsAreDueNow)
+{
+	start();
+	DS5W::OutputTimelineState& timeline = context._internal.outputTimeline;
+
+	// 0 and past times would otherwise count the time since then as lateness
+	DS5W::DS5OutputState state = {};
+	const long long before = now();
+	DS5W_CHECK(__DS5W::OutputTimeline::schedule(&context, 0, &state, DS5W_OSTATE_SUBSYSTEM_ALL) == DS5W_OK);
+	DS5W_CHECK(__DS5W::OutputTimeline::schedule(&context, before - timeline.hostFrequency, &state, DS5W_OSTATE_SUBSYSTEM_ALL) == DS5W_OK);
+	const long long after = now();
+
+	for (unsigned int i = 0; i < timeline.eventCount; i++)
+		DS5W_CHECK(timeline.events[i].hostTime >= before && timeline.events[i].hostTime <= after);
+
+	// Future times are kept
+	const long long later = after + timeline.hostFrequency;
+	DS5W_CHECK(__DS5W::OutputTimeline::schedule(&context, later, &state, DS5W_OSTATE_SUBSYSTEM_ALL) == DS5W_OK);
+	DS5W_CHECK(timeline.events[timeline.eventCount - 1].hostTime == later);
+}
+
+DS5W_TEST(timelinePendingEventsAreNotLastOutput)
+{
+	start();
+
+	DS5W::DS5OutputState state = {};
+	__DS5W::Output::createHIDOutputReport(&context, &state);
+	__DS5W::Output::rememberLastOutput(&context);
+	DS5W_CHECK(__DS5W::OutputTimeline::matchesLastOutput(&context, &state));
+
+	DS5W_CHECK(__DS5W::OutputTimeline::schedule(&context, 0, &state, DS5W_OSTATE_SUBSYSTEM_ALL) == DS5W_OK);
+	DS5W_CHECK(!__DS5W::OutputTimeline::matchesLastOutput(&context, &state));
+}
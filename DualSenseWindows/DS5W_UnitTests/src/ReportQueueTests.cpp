@@ -0,0 +1,177 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_ReportQueue.h>
+
+#include <thread>
+
+namespace {
+	using DS5WTest::context;
+
+	DS5W::DS5QueuedReport reports[DS5W_REPORT_QUEUE_CAPACITY];
+
+	void start(DS5W::ReportQueuePolicy policy)
+	{
+		DS5WTest::resetContext(&context);
+		__DS5W::ReportQueue::init(&context);
+		__DS5W::ReportQueue::configure(&context, true, policy);
+	}
+
+	void stop()
+	{
+		__DS5W::ReportQueue::release(&context);
+	}
+
+	// Reports are told apart by their sensor timestamp
+	void push(unsigned int number)
+	{
+		DS5W::DS5InputState state = {};
+		state.currentTime = number;
+		__DS5W::ReportQueue::push(&context, &state);
+	}
+
+	// Fill the queue with reports 1..count
+	void fill(unsigned int count)
+	{
+		for (unsigned int i = 1; i <= count; i++)
+			push(i);
+	}
+
+	DS5W::DS5ReportQueueStatistics statistics()
+	{
+		DS5W::DS5ReportQueueStatistics result;
+		__DS5W::ReportQueue::getStatistics(&context, &result);
+		return result;
+	}
+
+	// Input reader pushes count reports while this thread pops until all are accounted for
+	// Returns false if reports came out of order, or with gaps under the Block policy
+	bool runProducerConsumer(DS5W::ReportQueuePolicy policy, unsigned int count, bool slowConsumer)
+	{
+		start(policy);
+
+		std::thread producer([count] { fill(count); });
+
+		bool ordered = true;
+		unsigned int last = 0;
+		for (;;) {
+			const unsigned int popped = __DS5W::ReportQueue::pop(&context, reports, DS5W_REPORT_QUEUE_CAPACITY / 4);
+			for (unsigned int i = 0; i < popped; i++) {
+				const unsigned int number = reports[i].state.currentTime;
+				if (number <= last || (policy == DS5W::ReportQueuePolicy::Block && number != last + 1))
+					ordered = false;
+				last = number;
+			}
+
+			const DS5W::DS5ReportQueueStatistics now = statistics();
+			if (popped == 0 && now.pushed + (policy == DS5W::ReportQueuePolicy::DropNewest ? now.dropped : 0) == count && now.queued == 0)
+				break;
+
+			if (slowConsumer)
+				std::this_thread::yield();
+		}
+
+		producer.join();
+		return ordered;
+	}
+}
+
+DS5W_TEST(reportQueueKeepsEveryReportInOrder)
+{
+	start(DS5W::ReportQueuePolicy::DropOldest);
+
+	fill(100);
+	DS5W_CHECK(__DS5W::ReportQueue::pop(&context, reports, 40) == 40);
+	DS5W_CHECK(__DS5W::ReportQueue::pop(&context, &reports[40], DS5W_REPORT_QUEUE_CAPACITY) == 60);
+	DS5W_CHECK(__DS5W::ReportQueue::pop(&context, reports, DS5W_REPORT_QUEUE_CAPACITY) == 0);
+	for (unsigned int i = 0; i < 100; i++)
+		DS5W_CHECK(reports[i].state.currentTime == i + 1);
+
+	const DS5W::DS5ReportQueueStatistics result = statistics();
+	DS5W_CHECK(result.pushed == 100 && result.popped == 100 && result.dropped == 0 && result.queued == 0);
+	DS5W_CHECK(result.highWater == 100);
+	stop();
+}
+
+DS5W_TEST(reportQueueDropOldestKeepsNewest)
+{
+	start(DS5W::ReportQueuePolicy::DropOldest);
+
+	fill(DS5W_REPORT_QUEUE_CAPACITY + 10);
+	DS5W_CHECK(__DS5W::ReportQueue::pop(&context, reports, DS5W_REPORT_QUEUE_CAPACITY) == DS5W_REPORT_QUEUE_CAPACITY);
+	DS5W_CHECK(reports[0].state.currentTime == 11);
+	DS5W_CHECK(reports[DS5W_REPORT_QUEUE_CAPACITY - 1].state.currentTime == DS5W_REPORT_QUEUE_CAPACITY + 10);
+
+	const DS5W::DS5ReportQueueStatistics result = statistics();
+	DS5W_CHECK(result.pushed == DS5W_REPORT_QUEUE_CAPACITY + 10 && result.dropped == 10);
+	DS5W_CHECK(result.highWater == DS5W_REPORT_QUEUE_CAPACITY);
+	stop();
+}
+
+DS5W_TEST(reportQueueDropNewestKeepsOldest)
+{
+	start(DS5W::ReportQueuePolicy::DropNewest);
+
+	fill(DS5W_REPORT_QUEUE_CAPACITY + 10);
+	DS5W_CHECK(__DS5W::ReportQueue::pop(&context, reports, DS5W_REPORT_QUEUE_CAPACITY) == DS5W_REPORT_QUEUE_CAPACITY);
+	DS5W_CHECK(reports[0].state.currentTime == 1);
+	DS5W_CHECK(reports[DS5W_REPORT_QUEUE_CAPACITY - 1].state.currentTime == DS5W_REPORT_QUEUE_CAPACITY);
+
+	const DS5W::DS5ReportQueueStatistics result = statistics();
+	DS5W_CHECK(result.pushed == DS5W_REPORT_QUEUE_CAPACITY && result.dropped == 10);
+	stop();
+}
+
+DS5W_TEST(reportQueueBlockDropsOnlyWhenStopped)
+{
+	start(DS5W::ReportQueuePolicy::Block);
+
+	// A stopping reader must not wait for room forever
+	fill(DS5W_REPORT_QUEUE_CAPACITY);
+	context._internal.inputReader.stopRequested = TRUE;
+	push(DS5W_REPORT_QUEUE_CAPACITY + 1);
+
+	const DS5W::DS5ReportQueueStatistics result = statistics();
+	DS5W_CHECK(result.pushed == DS5W_REPORT_QUEUE_CAPACITY && result.dropped == 1 && result.blocked == 1);
+	stop();
+}
+
+DS5W_TEST(reportQueueConcurrentDropOldest)
+{
+	const unsigned int count = 500000;
+	DS5W_CHECK(runProducerConsumer(DS5W::ReportQueuePolicy::DropOldest, count, true));
+
+	// Every report is either popped or dropped
+	const DS5W::DS5ReportQueueStatistics result = statistics();
+	DS5W_CHECK(result.pushed == count);
+	DS5W_CHECK(result.popped + result.dropped == count);
+	stop();
+}
+
+DS5W_TEST(reportQueueConcurrentDropNewest)
+{
+	const unsigned int count = 500000;
+	DS5W_CHECK(runProducerConsumer(DS5W::ReportQueuePolicy::DropNewest, count, true));
+
+	const DS5W::DS5ReportQueueStatistics result = statistics();
+	DS5W_CHECK(result.pushed + result.dropped == count);
+	DS5W_CHECK(result.popped == result.pushed);
+	stop();
+}
+
+DS5W_TEST(reportQueueConcurrentBlockIsLossless)
+{
+	const unsigned int count = 500000;
+	DS5W_CHECK(runProducerConsumer(DS5W::ReportQueuePolicy::Block, count, true));
+
+	const DS5W::DS5ReportQueueStatistics result = statistics();
+	DS5W_CHECK(result.pushed == count && result.popped == count && result.dropped == 0);
+	stop();
+}
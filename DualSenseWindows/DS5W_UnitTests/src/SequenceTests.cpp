@@ -0,0 +1,114 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <string.h>
+
+namespace {
+	using DS5WTest::context;
+	using DS5WTest::REPORT_TICKS;
+
+	unsigned char report[DS_INPUT_REPORT_USB_SIZE];
+	unsigned int sequenceNumber;
+	unsigned int timestamp;
+
+	// Starts close to the wrap of both counters
+	void start()
+	{
+		DS5WTest::resetContext(&context);
+		memset(report, 0, sizeof(report));
+		sequenceNumber = 250;
+		timestamp = 0xFFFF0000u;
+	}
+
+	// Track the report skipped reports after the last one, with a few ticks of jitter
+	void receive(unsigned int skipped, int jitter = 0)
+	{
+		sequenceNumber += skipped + 1;
+		timestamp += (skipped + 1) * REPORT_TICKS + jitter;
+		DS5WTest::setReportSequence(report, (unsigned char)sequenceNumber);
+		DS5WTest::setReportTimestamp(report, timestamp);
+		__DS5W::Input::trackReportSequence(report, &context);
+	}
+
+	DS5W::DS5ReportStatistics statistics()
+	{
+		DS5W::DS5ReportStatistics result;
+		__DS5W::Input::getReportStatistics(&context, &result);
+		return result;
+	}
+}
+
+DS5W_TEST(sequenceCountsNothingLostForConsecutiveReports)
+{
+	start();
+	for (int i = 0; i < 100; i++)
+		receive(0, (i % 5) * 20 - 40);
+
+	const DS5W::DS5ReportStatistics result = statistics();
+	DS5W_CHECK(result.received == 100);
+	DS5W_CHECK(result.lost == 0 && result.duplicated == 0 && result.largestGap == 0);
+	DS5W_CHECK(result.reportInterval > REPORT_TICKS - 50 && result.reportInterval < REPORT_TICKS + 50);
+}
+
+DS5W_TEST(sequenceCountsLostReports)
+{
+	start();
+	for (int i = 0; i < 20; i++)
+		receive(0);
+
+	receive(3);
+	DS5W_CHECK(context._internal.reportSequence.lastGap == 3);
+
+	// Whole turns of the 8 bit counter are recovered from the timestamp
+	receive(255);
+	DS5W_CHECK(context._internal.reportSequence.lastGap == 255);
+	receive(600);
+	DS5W_CHECK(context._internal.reportSequence.lastGap == 600);
+
+	const DS5W::DS5ReportStatistics result = statistics();
+	DS5W_CHECK(result.received == 23);
+	DS5W_CHECK(result.lost == 3 + 255 + 600);
+	DS5W_CHECK(result.largestGap == 600);
+}
+
+DS5W_TEST(sequenceCountsDuplicatedReads)
+{
+	start();
+	for (int i = 0; i < 10; i++)
+		receive(0);
+	receive(2);
+
+	// Same report handed out again
+	__DS5W::Input::trackReportSequence(report, &context);
+
+	const DS5W::DS5ReportStatistics result = statistics();
+	DS5W_CHECK(result.duplicated == 1);
+	DS5W_CHECK(result.lost == 2);
+	DS5W_CHECK(context._internal.reportSequence.lastGap == 2);
+}
+
+DS5W_TEST(sequenceRestartsAfterReconnect)
+{
+	start();
+	for (int i = 0; i < 10; i++)
+		receive(0);
+
+	// The first report after a restart is only a starting point
+	__DS5W::Input::restartReportSequence(&context);
+	receive(40);
+	DS5W_CHECK(statistics().lost == 0);
+
+	__DS5W::Input::resetReportStatistics(&context);
+	receive(1);
+	const DS5W::DS5ReportStatistics result = statistics();
+	DS5W_CHECK(result.received == 1 && result.lost == 1);
+}
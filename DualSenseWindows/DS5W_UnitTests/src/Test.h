@@ -0,0 +1,51 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+namespace DS5WTest {
+	typedef void (*TestFunction)();
+
+	/// <summary>
+	/// Test registered by DS5W_TEST, all of them are run by main()
+	/// </summary>
+	struct TestCase {
+		const char* name;
+		TestFunction function;
+		TestCase* next;
+
+		TestCase(const char* name, TestFunction function);
+	};
+
+	/// <summary>
+	/// Report a failed check of the running test
+	/// </summary>
+	void fail(const char* file, int line, const char* expression);
+
+	/// <summary>
+	/// True once a check of the running test failed
+	/// </summary>
+	bool failed();
+}
+
+/// <summary>
+/// Define and register a test
+/// </summary>
+#define DS5W_TEST(name) \
+	static void name(); \
+	static DS5WTest::TestCase name##_case(#name, name); \
+	static void name()
+
+/// <summary>
+/// Fail the running test and leave it when expr is false
+/// </summary>
+#define DS5W_CHECK(expr) \
+	do { \
+		if (!(expr)) { \
+			DS5WTest::fail(__FILE__, __LINE__, #expr); \
+			return; \
+		} \
+	} while (0)
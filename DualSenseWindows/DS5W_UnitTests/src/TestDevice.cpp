@@ -0,0 +1,37 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Input.h>
+
+#include <string.h>
+
+short DS5WTest::calibrationReport[17] = { -3, 5, 2, 8700, -8650, 8690, -8710, 8720, -8680, 540, 540, 8200, -8180, 8210, -8170, 8190, -8200 };
+
+DS5W::DeviceContext DS5WTest::context;
+
+void DS5WTest::resetContext(DS5W::DeviceContext* ptrContext, DS5W::DeviceConnection connection)
+{
+	memset(ptrContext, 0, sizeof(DS5W::DeviceContext));
+	ptrContext->_internal.connectionType = connection;
+}
+
+void DS5WTest::calibrate(DS5W::DeviceContext* ptrContext)
+{
+	__DS5W::Input::parseCalibrationData(&ptrContext->_internal.calibrationData, calibrationReport);
+}
+
+void DS5WTest::setReportSequence(unsigned char* body, unsigned char sequenceNumber)
+{
+	body[0x06] = sequenceNumber;
+}
+
+void DS5WTest::setReportTimestamp(unsigned char* body, unsigned int timestamp)
+{
+	memcpy(&body[0x1B], &timestamp, sizeof(timestamp));
+}
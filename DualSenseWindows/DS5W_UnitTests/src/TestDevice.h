@@ -0,0 +1,46 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/Device.h>
+
+namespace DS5WTest {
+	/// <summary>
+	/// Sensor ticks between USB reports, which arrive every 4 ms
+	/// </summary>
+	const unsigned int REPORT_TICKS = DS_SENSOR_TIMESTAMP_PER_SECOND / 250;
+
+	/// <summary>
+	/// Calibration report values in the order the device sends them
+	/// </summary>
+	extern short calibrationReport[17];
+
+	/// <summary>
+	/// Context of the running test, tests start by resetting it
+	/// </summary>
+	extern DS5W::DeviceContext context;
+
+	/// <summary>
+	/// Clear a context as if the device was just connected, nothing is initialized
+	/// </summary>
+	void resetContext(DS5W::DeviceContext* ptrContext, DS5W::DeviceConnection connection = DS5W::DeviceConnection::USB);
+
+	/// <summary>
+	/// Load the calibration report into a context
+	/// </summary>
+	void calibrate(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Write the sequence number of an input report body
+	/// </summary>
+	void setReportSequence(unsigned char* body, unsigned char sequenceNumber);
+
+	/// <summary>
+	/// Write the sensor timestamp of an input report body
+	/// </summary>
+	void setReportTimestamp(unsigned char* body, unsigned int timestamp);
+}
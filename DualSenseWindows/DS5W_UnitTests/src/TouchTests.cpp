@@ -0,0 +1,215 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+#include "TestDevice.h"
+
+#include <DualSenseWindows/DS5_Input.h>
+#include <DualSenseWindows/DS5_Touch.h>
+
+#include <string.h>
+
+namespace {
+	using DS5WTest::context;
+	using DS5WTest::REPORT_TICKS;
+
+	unsigned int timestamp;
+
+	DS5W::DS5TouchGesture gestures[DS5W_TOUCH_GESTURE_QUEUE];
+	unsigned int gestureCount;
+
+	// Writes one touch point of the held USB report
+	void touch(int slot, bool down, unsigned char id, unsigned int x, unsigned int y)
+	{
+		const unsigned int packed = (down ? 0x00 : 0x80) | id | (x << 8) | (y << 20);
+		memcpy(&__DS5W::Input::heldReportBody(&context)[0x20 + 4 * slot], &packed, sizeof(packed));
+	}
+
+	void release(int slot)
+	{
+		touch(slot, false, 0, 0, 0);
+	}
+
+	// Next report with the touch points as they are written
+	void report()
+	{
+		timestamp += REPORT_TICKS;
+		DS5WTest::setReportTimestamp(__DS5W::Input::heldReportBody(&context), timestamp);
+		__DS5W::Touch::update(&context);
+	}
+
+	void start()
+	{
+		DS5WTest::resetContext(&context);
+		__DS5W::Touch::reset(&context);
+		context._internal.touchTracker.enabled = true;
+		timestamp = 100;
+
+		release(0);
+		release(1);
+		report();
+	}
+
+	void popGestures()
+	{
+		gestureCount = __DS5W::Touch::popGestures(&context, gestures, DS5W_TOUCH_GESTURE_QUEUE);
+	}
+
+	bool isGesture(unsigned int index, DS5W::TouchGestureType type, DS5W::TouchGesturePhase phase)
+	{
+		return index < gestureCount && gestures[index].type == type && gestures[index].phase == phase;
+	}
+}
+
+DS5W_TEST(touchRecognizesTap)
+{
+	start();
+	touch(0, true, 5, 500, 500);
+	report();
+	report();
+	release(0);
+	report();
+
+	popGestures();
+	DS5W_CHECK(gestureCount == 1);
+	DS5W_CHECK(isGesture(0, DS5W::TouchGestureType::Tap, DS5W::TouchGesturePhase::End));
+	DS5W_CHECK(gestures[0].x == 500.0f && gestures[0].y == 500.0f);
+}
+
+DS5W_TEST(touchRecognizesSwipe)
+{
+	start();
+	touch(0, true, 6, 200, 500);
+	report();
+	for (unsigned int i = 1; i <= 10; i++) {
+		touch(0, true, 6, 200 + i * 60, 500);
+		report();
+	}
+	release(0);
+	report();
+
+	popGestures();
+	DS5W_CHECK(gestureCount == 1);
+	DS5W_CHECK(isGesture(0, DS5W::TouchGestureType::Swipe, DS5W::TouchGesturePhase::End));
+	DS5W_CHECK(gestures[0].deltaX == 600.0f && gestures[0].deltaY == 0.0f);
+	DS5W_CHECK(gestures[0].velocityX > 0.0f);
+}
+
+DS5W_TEST(touchRecognizesScroll)
+{
+	start();
+	touch(0, true, 9, 800, 500);
+	touch(1, true, 10, 1000, 500);
+	report();
+	for (unsigned int i = 1; i <= 4; i++) {
+		touch(0, true, 9, 800, 500 - i * 20);
+		touch(1, true, 10, 1000, 500 - i * 20);
+		report();
+	}
+	release(0);
+	release(1);
+	report();
+
+	popGestures();
+	DS5W_CHECK(gestureCount >= 3);
+	DS5W_CHECK(isGesture(0, DS5W::TouchGestureType::Scroll, DS5W::TouchGesturePhase::Begin));
+	for (unsigned int i = 1; i + 1 < gestureCount; i++)
+		DS5W_CHECK(isGesture(i, DS5W::TouchGestureType::Scroll, DS5W::TouchGesturePhase::Update) && gestures[i].deltaY == -20.0f);
+	DS5W_CHECK(isGesture(gestureCount - 1, DS5W::TouchGestureType::Scroll, DS5W::TouchGesturePhase::End));
+}
+
+DS5W_TEST(touchRecognizesPinch)
+{
+	start();
+	touch(0, true, 7, 800, 500);
+	touch(1, true, 8, 1000, 500);
+	report();
+	for (unsigned int i = 1; i <= 4; i++) {
+		touch(0, true, 7, 800 - i * 30, 500);
+		touch(1, true, 8, 1000 + i * 30, 500);
+		report();
+	}
+	release(0);
+	report();
+
+	popGestures();
+	DS5W_CHECK(gestureCount >= 3);
+	DS5W_CHECK(isGesture(0, DS5W::TouchGestureType::Pinch, DS5W::TouchGesturePhase::Begin));
+	DS5W_CHECK(isGesture(gestureCount - 1, DS5W::TouchGestureType::Pinch, DS5W::TouchGesturePhase::End));
+	DS5W_CHECK(gestures[gestureCount - 1].scale == 440.0f / 200.0f);
+}
+
+DS5W_TEST(touchHeldPinchDoesNotFloodGestures)
+{
+	start();
+	touch(0, true, 7, 800, 500);
+	touch(1, true, 8, 1000, 500);
+	report();
+	touch(0, true, 7, 700, 500);
+	touch(1, true, 8, 1100, 500);
+	report();
+
+	// Fingers resting for longer than the gesture queue holds
+	for (int i = 0; i < 3 * DS5W_TOUCH_GESTURE_QUEUE; i++)
+		report();
+
+	touch(0, true, 7, 690, 500);
+	report();
+	release(0);
+	report();
+
+	popGestures();
+	DS5W_CHECK(gestureCount == 3);
+	DS5W_CHECK(isGesture(0, DS5W::TouchGestureType::Pinch, DS5W::TouchGesturePhase::Begin) && gestures[0].scale == 2.0f);
+	DS5W_CHECK(isGesture(1, DS5W::TouchGestureType::Pinch, DS5W::TouchGesturePhase::Update) && gestures[1].scale == 410.0f / 200.0f);
+	DS5W_CHECK(isGesture(2, DS5W::TouchGestureType::Pinch, DS5W::TouchGesturePhase::End));
+}
+
+DS5W_TEST(touchStateFollowsContacts)
+{
+	start();
+	touch(0, true, 3, 100, 200);
+	report();
+	touch(0, true, 3, 130, 200);
+	report();
+
+	DS5W::DS5TouchState state;
+	__DS5W::Touch::getTouchState(&context, &state);
+	DS5W_CHECK(state.contacts[0].down && !state.contacts[1].down);
+	DS5W_CHECK(state.contacts[0].velocityX > 0.0f && state.contacts[0].velocityY == 0.0f);
+
+	release(0);
+	report();
+	__DS5W::Touch::getTouchState(&context, &state);
+	DS5W_CHECK(!state.contacts[0].down);
+}
+
+DS5W_TEST(touchCountsDroppedGestures)
+{
+	start();
+
+	// Taps nobody reads
+	for (unsigned int i = 0; i < DS5W_TOUCH_GESTURE_QUEUE + 3; i++) {
+		touch(0, true, (unsigned char)i, 500, 500);
+		report();
+		release(0);
+		report();
+	}
+
+	DS5W::DS5TouchState state;
+	__DS5W::Touch::getTouchState(&context, &state);
+	DS5W_CHECK(state.droppedGestures == 3);
+
+	// Newest gestures are kept
+	popGestures();
+	DS5W_CHECK(gestureCount == DS5W_TOUCH_GESTURE_QUEUE);
+	DS5W_CHECK(gestures[DS5W_TOUCH_GESTURE_QUEUE - 1].currentTime == timestamp);
+
+	__DS5W::Touch::reset(&context);
+	__DS5W::Touch::getTouchState(&context, &state);
+	DS5W_CHECK(state.droppedGestures == 0);
+}
@@ -0,0 +1,108 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+
+#include <DualSenseWindows/TriggerEffects.h>
+
+#include <string.h>
+
+namespace {
+	namespace TE = DS5W::TriggerEffects;
+
+	// Builders must stay usable for effects packed at compile time
+	constexpr DS5W::TriggerEffect staticWeapon = TE::weapon(2, 6, 8);
+	static_assert(staticWeapon._u1_raw[0] == 0x44 && staticWeapon._u1_raw[2] == 0x07, "weapon() is not constexpr");
+
+	// Packed bytes worked out by hand from the zone layout
+	bool matches(const DS5W::TriggerEffect& effect, DS5W::TriggerEffectType type, const unsigned char (&bytes)[10])
+	{
+		return effect.effectType == type && memcmp(effect._u1_raw, bytes, sizeof(bytes)) == 0;
+	}
+
+	DS5W::TriggerEffectDescription describe(DS5W::TriggerEffectMode mode)
+	{
+		DS5W::TriggerEffectDescription description;
+		memset(&description, 0, sizeof(description));
+		description.mode = mode;
+		return description;
+	}
+}
+
+DS5W_TEST(triggerEffectsPackZones)
+{
+	// Zones 2 and 6, strength 8 stored as 7
+	const unsigned char weapon[10] = { 0x44, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	DS5W_CHECK(matches(TE::weapon(2, 6, 8), DS5W::TriggerEffectType::Weapon, weapon));
+
+	// All 10 zones at strength 8
+	const unsigned char feedback[10] = { 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00 };
+	DS5W_CHECK(matches(TE::feedback(0, 8), DS5W::TriggerEffectType::Feedback, feedback));
+
+	// Zones 3 - 9 at amplitude 5, frequency in the 9th byte
+	const unsigned char vibration[10] = { 0xF8, 0x03, 0x00, 0x48, 0x92, 0x24, 0x00, 0x00, 40, 0x00 };
+	DS5W_CHECK(matches(TE::vibration(3, 5, 40), DS5W::TriggerEffectType::EffectEx, vibration));
+
+	// Zones 2 - 4 at strength 8
+	const unsigned char zones[10] = { 0, 0, 8, 8, 8, 0, 0, 0, 0, 0 };
+	const unsigned char multiple[10] = { 0x1C, 0x00, 0xC0, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	DS5W_CHECK(matches(TE::multiplePositionFeedback(zones), DS5W::TriggerEffectType::Feedback, multiple));
+
+	// Strengths 2, 3, 4, 5, 6 over zones 2 - 6, then 6 to the end of travel
+	const unsigned char slope[10] = { 0xFC, 0x03, 0x40, 0x34, 0xB6, 0x2D, 0x00, 0x00, 0x00, 0x00 };
+	DS5W_CHECK(matches(TE::slopeFeedback(2, 6, 2, 6), DS5W::TriggerEffectType::Feedback, slope));
+}
+
+DS5W_TEST(triggerEffectsOutOfRangeAreOff)
+{
+	const unsigned char off[10] = {};
+	DS5W_CHECK(matches(TE::off(), DS5W::TriggerEffectType::ReleaseAll, off));
+	DS5W_CHECK(matches(TE::weapon(1, 6, 8), DS5W::TriggerEffectType::ReleaseAll, off));
+	DS5W_CHECK(matches(TE::weapon(2, 9, 8), DS5W::TriggerEffectType::ReleaseAll, off));
+	DS5W_CHECK(matches(TE::feedback(10, 8), DS5W::TriggerEffectType::ReleaseAll, off));
+	DS5W_CHECK(matches(TE::feedback(0, 9), DS5W::TriggerEffectType::ReleaseAll, off));
+	DS5W_CHECK(matches(TE::vibration(3, 5, 0), DS5W::TriggerEffectType::ReleaseAll, off));
+	DS5W_CHECK(matches(TE::slopeFeedback(6, 2, 2, 6), DS5W::TriggerEffectType::ReleaseAll, off));
+}
+
+DS5W_TEST(compileTriggerEffectMatchesBuilders)
+{
+	DS5W::TriggerEffectDescription description = describe(DS5W::TriggerEffectMode::Vibration);
+	description.startPosition = 3;
+	description.strength = 5;
+	description.frequency = 40;
+
+	// Second call is served from the cache
+	const DS5W::TriggerEffect expected = TE::vibration(3, 5, 40);
+	for (unsigned int i = 0; i < 2; i++) {
+		DS5W::TriggerEffect effect;
+		DS5W_CHECK(DS5W_SUCCESS(DS5W::compileTriggerEffect(&description, &effect)));
+		DS5W_CHECK(memcmp(&effect, &expected, sizeof(effect)) == 0);
+	}
+
+	description = describe(DS5W::TriggerEffectMode::SlopeFeedback);
+	description.startPosition = 2;
+	description.endPosition = 6;
+	description.strength = 2;
+	description.endStrength = 6;
+	const DS5W::TriggerEffect slope = TE::slopeFeedback(2, 6, 2, 6);
+	DS5W::TriggerEffect effect;
+	DS5W_CHECK(DS5W_SUCCESS(DS5W::compileTriggerEffect(&description, &effect)));
+	DS5W_CHECK(memcmp(&effect, &slope, sizeof(effect)) == 0);
+}
+
+DS5W_TEST(compileTriggerEffectRejectsOutOfRange)
+{
+	DS5W::TriggerEffectDescription description = describe(DS5W::TriggerEffectMode::Vibration);
+	description.startPosition = 3;
+	description.strength = 9;
+	description.frequency = 40;
+
+	DS5W::TriggerEffect effect;
+	DS5W_CHECK(DS5W::compileTriggerEffect(&description, &effect) == DS5W_E_INVALID_ARGS);
+	DS5W_CHECK(DS5W::compileTriggerEffect(&description, nullptr) == DS5W_E_INVALID_ARGS);
+}
@@ -0,0 +1,60 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "Test.h"
+
+#include <stdio.h>
+
+namespace {
+	DS5WTest::TestCase*& firstTest()
+	{
+		static DS5WTest::TestCase* first = nullptr;
+		return first;
+	}
+
+	bool runningFailed = false;
+}
+
+DS5WTest::TestCase::TestCase(const char* name, TestFunction function) :
+	name(name), function(function), next(nullptr)
+{
+	// Keep the order the tests were defined in
+	TestCase** link = &firstTest();
+	while (*link)
+		link = &(*link)->next;
+	*link = this;
+}
+
+void DS5WTest::fail(const char* file, int line, const char* expression)
+{
+	printf("  %s(%d): check failed: %s\n", file, line, expression);
+	runningFailed = true;
+}
+
+bool DS5WTest::failed()
+{
+	return runningFailed;
+}
+
+int main()
+{
+	int testCount = 0;
+	int failCount = 0;
+
+	for (DS5WTest::TestCase* test = firstTest(); test; test = test->next) {
+		runningFailed = false;
+		test->function();
+
+		printf("%s %s\n", runningFailed ? "FAIL" : "ok  ", test->name);
+		testCount++;
+		if (runningFailed)
+			failCount++;
+	}
+
+	printf("%d of %d tests passed\n", testCount - failCount, testCount);
+	return failCount ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace DS5W {
+	/// <summary>
+	/// Playback of one track
+	/// </summary>
+	typedef struct _AnimationTrackState {
+		/// <summary>
+		/// Keyframes of the track
+		/// </summary>
+		const AnimationKeyframe* keyframes;
+		unsigned int keyframeCount;
+
+		/// <summary>
+		/// Keyframe at or before the last evaluated time, evaluation moves forward from here
+		/// </summary>
+		unsigned int cursor;
+
+		/// <summary>
+		/// Engine time the track started at
+		/// </summary>
+		double startTime;
+
+		/// <summary>
+		/// Track restarts after the last keyframe
+		/// </summary>
+		bool loop;
+
+		/// <summary>
+		/// Track is evaluated on ticks
+		/// </summary>
+		bool active;
+	} AnimationTrackState;
+
+	/// <summary>
+	/// Keyframe animation of the output states of several devices
+	/// </summary>
+	typedef struct _DS5AnimationEngine {
+		/// <summary>
+		/// Encapsulate data in struct to (at least try) prevent user from modifing the engine
+		/// </summary>
+		struct {
+			/// <summary>
+			/// Seconds ticked since the engine was initialized
+			/// </summary>
+			double time;
+
+			/// <summary>
+			/// Output state written for each device slot, NULL when unused
+			/// </summary>
+			DS5OutputState* outputs[DS5W_ANIMATION_MAX_DEVICES];
+
+			/// <summary>
+			/// Tracks by channel then device, so a tick walks each channel of every device in one run
+			/// </summary>
+			AnimationTrackState tracks[(int)AnimationChannel::Count][DS5W_ANIMATION_MAX_DEVICES];
+		} _internal;
+	} DS5AnimationEngine;
+
+	/// <summary>
+	/// Prepare an animation engine, no devices are bound and no tracks play
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue initAnimationEngine(DS5W::DS5AnimationEngine* ptrEngine);
+
+	/// <summary>
+	/// Attach the output state a device slot writes to, stopping the tracks of the slot
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <param name="slot">Device slot, below DS5W_ANIMATION_MAX_DEVICES</param>
+	/// <param name="ptrOutputState">Output state to animate, NULL to free the slot</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue bindAnimationOutput(DS5W::DS5AnimationEngine* ptrEngine, unsigned int slot, DS5W::DS5OutputState* ptrOutputState);
+
+	/// <summary>
+	/// Start a track on a device slot from the current engine time, replacing the track playing on its channel
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <param name="slot">Bound device slot</param>
+	/// <param name="ptrTrack">Track to play, keyframes must outlive playback</param>
+	/// <returns>Result of call, DS5W_E_INVALID_ARGS for unsorted or missing keyframes</returns>
+	extern "C" DS5W_API DS5W_ReturnValue playAnimation(DS5W::DS5AnimationEngine* ptrEngine, unsigned int slot, const DS5W::DS5AnimationTrack* ptrTrack);
+
+	/// <summary>
+	/// Stop the track on a channel of a device slot, the output keeps its last value
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <param name="slot">Device slot</param>
+	/// <param name="channel">Channel to stop</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue stopAnimation(DS5W::DS5AnimationEngine* ptrEngine, unsigned int slot, DS5W::AnimationChannel channel);
+
+	/// <summary>
+	/// Advance time and write every playing track into the output states
+	/// Fields are only written when their value changes
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <param name="deltaSeconds">Seconds since the last tick</param>
+	/// <param name="ptrDirtyMasks">Optional array of DS5W_ANIMATION_MAX_DEVICES, set to the DS5W_OSTATE_SUBSYSTEM_ bits written per slot (for setDeviceOutputStateMasked)</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue tickAnimations(DS5W::DS5AnimationEngine* ptrEngine, float deltaSeconds, unsigned int* ptrDirtyMasks);
+}
@@ -41,12 +41,66 @@
 #define DS5W_ISTATE_BTN_PAD_BUTTON 0x020000
 #define DS5W_ISTATE_BTN_MIC_BUTTON 0x040000
 
+// Maximum number of input events a single report can generate
+#define DS5W_MAX_INPUT_EVENTS 34
+
+// Number of touch gestures held per device until they are read
+#define DS5W_TOUCH_GESTURE_QUEUE 16
+
+// Input state fields for masked decoding
+#define DS5W_ISTATE_FIELD_STICKS 0x0001
+#define DS5W_ISTATE_FIELD_TRIGGERS 0x0002
+#define DS5W_ISTATE_FIELD_BUTTONS 0x0004
+#define DS5W_ISTATE_FIELD_ACCELEROMETER 0x0008
+#define DS5W_ISTATE_FIELD_GYROSCOPE 0x0010
+#define DS5W_ISTATE_FIELD_TOUCH 0x0020
+#define DS5W_ISTATE_FIELD_TIME 0x0040
+#define DS5W_ISTATE_FIELD_BATTERY 0x0080
+#define DS5W_ISTATE_FIELD_HEADPHONE 0x0100
+#define DS5W_ISTATE_FIELD_TRIGGER_FEEDBACK 0x0200
+#define DS5W_ISTATE_FIELD_ALL 0x03FF
+
 #define DS5W_OSTATE_PLAYER_LED_LEFT 0x01
 #define DS5W_OSTATE_PLAYER_LED_MIDDLE_LEFT 0x02
 #define DS5W_OSTATE_PLAYER_LED_MIDDLE 0x04
 #define DS5W_OSTATE_PLAYER_LED_MIDDLE_RIGHT 0x08
 #define DS5W_OSTATE_PLAYER_LED_RIGHT 0x10
 
+// Output state subsystems for partial updates, the device keeps the state of subsystems not sent
+#define DS5W_OSTATE_SUBSYSTEM_RUMBLE 0x0001
+#define DS5W_OSTATE_SUBSYSTEM_LEFT_TRIGGER 0x0002
+#define DS5W_OSTATE_SUBSYSTEM_RIGHT_TRIGGER 0x0004
+#define DS5W_OSTATE_SUBSYSTEM_MIC_LED 0x0008
+#define DS5W_OSTATE_SUBSYSTEM_LIGHTBAR 0x0010
+#define DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS 0x0020
+#define DS5W_OSTATE_SUBSYSTEM_MOTOR_STRENGTH 0x0040
+#define DS5W_OSTATE_SUBSYSTEM_ALL 0x007F
+
+// Number of devices one animation engine drives
+#define DS5W_ANIMATION_MAX_DEVICES 16
+
+// Number of devices one input engine services, most worker threads it runs and reads it keeps posted per device
+#define DS5W_INPUT_ENGINE_MAX_DEVICES 64
+#define DS5W_INPUT_ENGINE_MAX_WORKERS 16
+#define DS5W_INPUT_ENGINE_READS 2
+
+// Haptic frames (at DS_HAPTICS_SAMPLE_RATE) buffered per device, a power of two
+#define DS5W_HAPTICS_RING_FRAMES 1024
+
+// Scheduled output changes held per device until they are due
+#define DS5W_OUTPUT_TIMELINE_CAPACITY 64
+
+// Most input reads kept posted per device by the read pipeline
+#define DS5W_INPUT_PIPELINE_MAX_DEPTH 8
+
+// HID input queue lengths, Windows accepts 2 - 512 reports
+#define DS5W_INPUT_QUEUE_MIN 2
+#define DS5W_INPUT_QUEUE_MAX 512
+#define DS5W_INPUT_QUEUE_DEFAULT 128
+
+// Decoded reports held per device by the report queue, a power of two
+#define DS5W_REPORT_QUEUE_CAPACITY 256
+
 namespace DS5W {
 
 	/// <summary>
@@ -107,6 +161,58 @@ namespace DS5W {
 		unsigned char id;
 	} Touch;
 
+	/// <summary>
+	/// Analog stick normalized to [-1, 1]
+	/// </summary>
+	typedef struct _AnalogStickF {
+		float x;
+		float y;
+	} AnalogStickF;
+
+	/// <summary>
+	/// 3 Component float vector
+	/// </summary>
+	typedef struct _Vec3F {
+		float x;
+		float y;
+		float z;
+	} Vector3F, Vec3F;
+
+	/// <summary>
+	/// Rotation quaternion
+	/// </summary>
+	typedef struct _Quaternion {
+		float w;
+		float x;
+		float y;
+		float z;
+	} Quaternion;
+
+	/// <summary>
+	/// Touchpad state normalized to [0, 1]
+	/// </summary>
+	typedef struct _TouchF {
+		/// <summary>
+		/// X positon of finger (0 = left, 1 = right)
+		/// </summary>
+		float x;
+
+		/// <summary>
+		/// Y position of finger (0 = top, 1 = bottom)
+		/// </summary>
+		float y;
+
+		/// <summary>
+		/// Touch is down
+		/// </summary>
+		bool down;
+
+		/// <summary>
+		/// 7-bit ID for touch
+		/// </summary>
+		unsigned char id;
+	} TouchF;
+
 	typedef struct _Battery {
 		/// <summary>
 		/// Charching state of the battery
@@ -144,6 +250,46 @@ namespace DS5W {
 		PULSE = 0x02,
 	} MicLed;
 
+	/// <summary>
+	/// How input reads treat reports queued by Windows since the last read
+	/// </summary>
+	typedef enum class _InputMode : unsigned char {
+		/// <summary>
+		/// Queue is flushed before every read, reads wait for the next report the device sends (default)
+		/// </summary>
+		Flush = 0,
+
+		/// <summary>
+		/// Queue holds only the newest reports and is not flushed, reads return a queued report without waiting for the next one
+		/// </summary>
+		LatestOnly = 1,
+
+		/// <summary>
+		/// Queue holds many reports and is not flushed, drainInputReports() reads all of them
+		/// </summary>
+		EveryReport = 2,
+	} InputMode;
+
+	/// <summary>
+	/// What the report queue does with a report when it is full
+	/// </summary>
+	typedef enum class _ReportQueuePolicy : unsigned char {
+		/// <summary>
+		/// Oldest queued report is dropped to make room
+		/// </summary>
+		DropOldest = 0,
+
+		/// <summary>
+		/// New report is dropped
+		/// </summary>
+		DropNewest = 1,
+
+		/// <summary>
+		/// Input reader waits until reports are popped, further reports wait in the HID queue (see setInputMode())
+		/// </summary>
+		Block = 2,
+	} ReportQueuePolicy;
+
 	/// <summary>
 	/// Type of trigger effect
 	/// </summary>
@@ -169,7 +315,17 @@ namespace DS5W {
 		ReleaseAll = 0x05,
 
 		/// <summary>
-		/// Extended trigger effect
+		/// Resistance per zone, packed by TriggerEffects::feedback()
+		/// </summary>
+		Feedback = 0x21,
+
+		/// <summary>
+		/// Resistance that snaps between two zones, packed by TriggerEffects::weapon()
+		/// </summary>
+		Weapon = 0x25,
+
+		/// <summary>
+		/// Extended trigger effect, vibration per zone when packed by TriggerEffects::vibration()
 		/// </summary>
 		EffectEx = 0x26,
 
@@ -279,6 +435,86 @@ namespace DS5W {
 		};
 	} TriggerEffect;
 
+	/// <summary>
+	/// Trigger effects that can be packed by compileTriggerEffect()
+	/// </summary>
+	typedef enum class _TriggerEffectMode : unsigned char {
+		/// <summary>
+		/// TriggerEffects::off()
+		/// </summary>
+		Off = 0,
+
+		/// <summary>
+		/// TriggerEffects::feedback(startPosition, strength)
+		/// </summary>
+		Feedback = 1,
+
+		/// <summary>
+		/// TriggerEffects::weapon(startPosition, endPosition, strength)
+		/// </summary>
+		Weapon = 2,
+
+		/// <summary>
+		/// TriggerEffects::vibration(startPosition, strength, frequency)
+		/// </summary>
+		Vibration = 3,
+
+		/// <summary>
+		/// TriggerEffects::multiplePositionFeedback(zones)
+		/// </summary>
+		MultiplePositionFeedback = 4,
+
+		/// <summary>
+		/// TriggerEffects::slopeFeedback(startPosition, endPosition, strength, endStrength)
+		/// </summary>
+		SlopeFeedback = 5,
+
+		/// <summary>
+		/// TriggerEffects::multiplePositionVibration(frequency, zones)
+		/// </summary>
+		MultiplePositionVibration = 6,
+	} TriggerEffectMode;
+
+	/// <summary>
+	/// Parameters of a trigger effect, fields a mode does not use should be 0
+	/// </summary>
+	typedef struct _TriggerEffectDescription {
+		/// <summary>
+		/// Effect to pack
+		/// </summary>
+		TriggerEffectMode mode;
+
+		/// <summary>
+		/// Zone the effect starts at
+		/// </summary>
+		unsigned char startPosition;
+
+		/// <summary>
+		/// Zone the effect ends at
+		/// </summary>
+		unsigned char endPosition;
+
+		/// <summary>
+		/// Resistance or vibration amplitude (at the start for slopes)
+		/// </summary>
+		unsigned char strength;
+
+		/// <summary>
+		/// Resistance at the end of slopes
+		/// </summary>
+		unsigned char endStrength;
+
+		/// <summary>
+		/// Vibrations per second
+		/// </summary>
+		unsigned char frequency;
+
+		/// <summary>
+		/// Resistance or vibration amplitude of each zone for multiple position effects
+		/// </summary>
+		unsigned char zones[10];
+	} TriggerEffectDescription;
+
 	/// <summary>
 	/// Led brightness
 	/// </summary>
@@ -326,8 +562,8 @@ namespace DS5W {
 	{
 		SetMainMotorsA =		1 << 0,		// Allow changing controller haptics. Also requires SetMainMotorsB flag
 		SetMainMotorsB =		1 << 1,		// Allow changing controller haptics. Also requires SetMainMotorsA flag
-		SetTriggerMotorsA =		1 << 2,		// Allow changing trigger haptics. Also requires SetTriggerMotorsB flag
-		SetTriggerMotorsB =		1 << 3,		// Allow changing trigger haptics. Also requires SetTriggerMotorsA flag
+		SetTriggerMotorsA =		1 << 2,		// Allow changing the right trigger effect
+		SetTriggerMotorsB =		1 << 3,		// Allow changing the left trigger effect
 		SetAudioVolume =		1 << 4,		// Enable modification of audio volume
 		EnableAudio =			1 << 5,		// Enable internal speaker (even while headset is connected)
 		SetMicrophoneVolume =	1 << 6,		// Enable modification of microphone volume
@@ -419,6 +655,16 @@ namespace DS5W {
 		/// </summary>
 		unsigned int deltaTime;
 
+		/// <summary>
+		/// Sensor timestamp mapped onto the host clock, in QueryPerformanceCounter ticks
+		/// </summary>
+		long long hostTimestamp;
+
+		/// <summary>
+		/// Number of reports lost between the previous report and this one
+		/// </summary>
+		unsigned int reportGap;
+
 		/// <summary>
 		/// Battery information
 		/// </summary>
@@ -440,54 +686,1010 @@ namespace DS5W {
 		unsigned char rightTriggerFeedback;
 	} DS5InputState;
 
-	typedef struct _DS5OutputState {
+	/// <summary>
+	/// Input state converted to floats in SI units
+	/// </summary>
+	typedef struct _DS5InputStateF {
+		/// <summary>
+		/// Position of left stick [-1, 1]
+		/// </summary>
+		AnalogStickF leftStick;
 
 		/// <summary>
-		/// Left / Hard rumbel motor
+		/// Position of right stick [-1, 1]
 		/// </summary>
-		unsigned char leftRumble;
+		AnalogStickF rightStick;
 
 		/// <summary>
-		/// Right / Soft rumbel motor
+		/// Angular velocity in rad/s
 		/// </summary>
-		unsigned char rightRumble;
+		Vector3F gyroscope;
 
 		/// <summary>
-		/// strength of rumble motors in 12.5% steps
-		/// lower nibble (bits 0-3) main rumbles
-		/// uppper nibble (bits 4-7) trigger rumbles
+		/// Acceleration in m/s^2
 		/// </summary>
-		unsigned char rumbleStrength;
+		Vector3F accelerometer;
 
 		/// <summary>
-		/// State of the microphone led
+		/// Left trigger position [0, 1]
 		/// </summary>
-		MicLed microphoneLed;
+		float leftTrigger;
 
 		/// <summary>
-		/// Diables all leds
+		/// Right trigger position [0, 1]
 		/// </summary>
-		bool disableLeds;
+		float rightTrigger;
 
 		/// <summary>
-		/// Player leds
+		/// bitflags of buttons, (face | btnsA | btnsB), final 13 bits are empty
 		/// </summary>
-		PlayerLeds playerLeds;
+		unsigned int buttonMap;
 
 		/// <summary>
-		/// Color of the lightbar
+		/// First touch point
 		/// </summary>
-		Color lightbar;
+		TouchF touchPoint1;
 
 		/// <summary>
-		/// Effect of left trigger
+		/// Second touch point
 		/// </summary>
-		TriggerEffect leftTriggerEffect;
+		TouchF touchPoint2;
 
 		/// <summary>
-		/// Effect of right trigger
+		/// Sensor timestamp in 0.33 microseconds
 		/// </summary>
-		TriggerEffect rightTriggerEffect;
+		unsigned int currentTime;
 
-	} DS5OutputState;
+		/// <summary>
+		/// Time since last input report, in 0.33 microseconds
+		/// </summary>
+		unsigned int deltaTime;
+
+		/// <summary>
+		/// Time since last input report, in seconds
+		/// </summary>
+		float deltaSeconds;
+
+		/// <summary>
+		/// Sensor timestamp mapped onto the host clock, in QueryPerformanceCounter ticks
+		/// </summary>
+		long long hostTimestamp;
+
+		/// <summary>
+		/// Number of reports lost between the previous report and this one
+		/// </summary>
+		unsigned int reportGap;
+
+		/// <summary>
+		/// Battery information
+		/// </summary>
+		Battery battery;
+
+		/// <summary>
+		/// Indicates the connection of headphone
+		/// </summary>
+		bool headPhoneConnected;
+
+		/// <summary>
+		/// Feedback of the left adaptive trigger (only when trigger effect is active)
+		/// </summary>
+		unsigned char leftTriggerFeedback;
+
+		/// <summary>
+		/// Feedback of the right adaptive trigger (only when trigger effect is active)
+		/// </summary>
+		unsigned char rightTriggerFeedback;
+	} DS5InputStateF;
+
+	/// <summary>
+	/// Output of the motion fusion
+	/// </summary>
+	typedef struct _DS5MotionState {
+		/// <summary>
+		/// Rotation from controller axes into world axes (world z is up)
+		/// </summary>
+		Quaternion orientation;
+
+		/// <summary>
+		/// Gravity in controller axes, in m/s^2
+		/// </summary>
+		Vector3F gravity;
+
+		/// <summary>
+		/// Sensor timestamp of the last report fused
+		/// </summary>
+		unsigned int currentTime;
+	} DS5MotionState;
+
+	/// <summary>
+	/// State of the device to host clock mapping
+	/// </summary>
+	typedef struct _DS5ClockSyncInfo {
+		/// <summary>
+		/// QueryPerformanceCounter ticks per second
+		/// </summary>
+		long long hostFrequency;
+
+		/// <summary>
+		/// Host time of the last report, in QueryPerformanceCounter ticks
+		/// </summary>
+		long long hostTime;
+
+		/// <summary>
+		/// Unwrapped device time of the last report, in 0.33 microseconds
+		/// </summary>
+		unsigned long long deviceTime;
+
+		/// <summary>
+		/// Device clock speed relative to its nominal rate, in parts per million (positive = device runs fast)
+		/// </summary>
+		double driftPpm;
+
+		/// <summary>
+		/// Average delay between the estimated report time and its arrival, in microseconds
+		/// </summary>
+		double latencyMicroseconds;
+
+		/// <summary>
+		/// Number of reports used by the model
+		/// </summary>
+		unsigned int sampleCount;
+
+		/// <summary>
+		/// Number of times the model was anchored (first connection and reconnects)
+		/// </summary>
+		unsigned int anchorCount;
+	} DS5ClockSyncInfo;
+
+	/// <summary>
+	/// Counters of input reports read from a device
+	/// </summary>
+	typedef struct _DS5ReportStatistics {
+		/// <summary>
+		/// Reports read
+		/// </summary>
+		unsigned long long received;
+
+		/// <summary>
+		/// Reports the device sent that were never read (dropped by Windows or the HID queue)
+		/// </summary>
+		unsigned long long lost;
+
+		/// <summary>
+		/// Reports read more than once
+		/// </summary>
+		unsigned long long duplicated;
+
+		/// <summary>
+		/// Largest number of consecutive reports lost
+		/// </summary>
+		unsigned int largestGap;
+
+		/// <summary>
+		/// Average sensor time between reports sent by the device, in 0.33 microseconds (0 until measured)
+		/// </summary>
+		unsigned int reportInterval;
+	} DS5ReportStatistics;
+
+	/// <summary>
+	/// Counters of the background output writer
+	/// </summary>
+	typedef struct _DS5OutputWriterStatistics {
+		/// <summary>
+		/// Output states handed to the writer
+		/// </summary>
+		unsigned long long submitted;
+
+		/// <summary>
+		/// Output states replaced by a newer one before they were written
+		/// </summary>
+		unsigned long long coalesced;
+
+		/// <summary>
+		/// Output reports written to the device
+		/// </summary>
+		unsigned long long written;
+
+		/// <summary>
+		/// Output states not written as the device already had them
+		/// </summary>
+		unsigned long long unchanged;
+
+		/// <summary>
+		/// Writes that failed
+		/// </summary>
+		unsigned long long failed;
+
+		/// <summary>
+		/// Rate the writer flushes at, in Hz
+		/// </summary>
+		unsigned int rate;
+
+		/// <summary>
+		/// False once stopped, also after the device was removed
+		/// </summary>
+		bool running;
+	} DS5OutputWriterStatistics;
+
+	/// <summary>
+	/// Counters of the Bluetooth haptics stream
+	/// </summary>
+	typedef struct _DS5HapticsStreamStatistics {
+		/// <summary>
+		/// Haptics reports written to the device
+		/// </summary>
+		unsigned long long reportsWritten;
+
+		/// <summary>
+		/// Reports that had fewer frames than they carry, the rest was filled with silence
+		/// </summary>
+		unsigned long long underruns;
+
+		/// <summary>
+		/// Writes that did not fit into the buffer
+		/// </summary>
+		unsigned long long overruns;
+
+		/// <summary>
+		/// Resampled frames dropped by overruns
+		/// </summary>
+		unsigned long long droppedFrames;
+
+		/// <summary>
+		/// Writes that failed
+		/// </summary>
+		unsigned long long failed;
+
+		/// <summary>
+		/// Frames waiting to be sent, at DS_HAPTICS_SAMPLE_RATE
+		/// </summary>
+		unsigned int queuedFrames;
+
+		/// <summary>
+		/// False once stopped, also after the device was removed
+		/// </summary>
+		bool running;
+	} DS5HapticsStreamStatistics;
+
+	/// <summary>
+	/// Counters of the output timeline
+	/// Lateness is the time from when a change was due until its report was handed on
+	/// </summary>
+	typedef struct _DS5OutputTimelineStatistics {
+		/// <summary>
+		/// Changes accepted into the timeline
+		/// </summary>
+		unsigned long long scheduled;
+
+		/// <summary>
+		/// Changes dispatched
+		/// </summary>
+		unsigned long long dispatched;
+
+		/// <summary>
+		/// Changes that shared a report with an earlier change due in the same transport slot
+		/// </summary>
+		unsigned long long merged;
+
+		/// <summary>
+		/// Reports handed to the device or output writer
+		/// </summary>
+		unsigned long long reports;
+
+		/// <summary>
+		/// Writes that failed
+		/// </summary>
+		unsigned long long failed;
+
+		/// <summary>
+		/// Changes dispatched more than one transport slot after they were due
+		/// </summary>
+		unsigned long long lateEvents;
+
+		/// <summary>
+		/// Average, largest and last lateness in microseconds, changes scheduled for a time already passed count from when they were scheduled
+		/// </summary>
+		double averageLatenessMicroseconds;
+		double maxLatenessMicroseconds;
+		double lastLatenessMicroseconds;
+
+		/// <summary>
+		/// Changes waiting to be due
+		/// </summary>
+		unsigned int queued;
+
+		/// <summary>
+		/// False once stopped, also after the device was removed
+		/// </summary>
+		bool running;
+	} DS5OutputTimelineStatistics;
+
+	/// <summary>
+	/// Counters of the input read pipeline
+	/// Wait is the time a read blocked until its report completed
+	/// </summary>
+	typedef struct _DS5InputPipelineStatistics {
+		/// <summary>
+		/// Reports taken from the pipeline
+		/// </summary>
+		unsigned long long reports;
+
+		/// <summary>
+		/// Reports that had already completed when they were taken
+		/// </summary>
+		unsigned long long readyReports;
+
+		/// <summary>
+		/// Reads that failed or timed out
+		/// </summary>
+		unsigned long long failed;
+
+		/// <summary>
+		/// Average and largest wait in microseconds
+		/// </summary>
+		double averageWaitMicroseconds;
+		double maxWaitMicroseconds;
+
+		/// <summary>
+		/// Reads kept posted, 0 while the pipeline is off
+		/// </summary>
+		unsigned int depth;
+	} DS5InputPipelineStatistics;
+
+	/// <summary>
+	/// Counters of the input mode since it was set
+	/// </summary>
+	typedef struct _DS5InputModeStatistics {
+		/// <summary>
+		/// Reports the device sent between two reads that were never read (flushed or pushed out of the queue)
+		/// </summary>
+		unsigned long long skipped;
+
+		/// <summary>
+		/// Reports returned by drainInputReports()
+		/// </summary>
+		unsigned long long drained;
+
+		/// <summary>
+		/// Calls to drainInputReports() that returned reports
+		/// </summary>
+		unsigned long long drains;
+
+		/// <summary>
+		/// Most reports returned by one drain
+		/// </summary>
+		unsigned int largestDrain;
+
+		/// <summary>
+		/// HID input queue length in reports
+		/// </summary>
+		unsigned int queueLength;
+
+		/// <summary>
+		/// Current mode
+		/// </summary>
+		InputMode mode;
+	} DS5InputModeStatistics;
+
+	/// <summary>
+	/// Input report taken from the report queue
+	/// </summary>
+	typedef struct _DS5QueuedReport {
+		/// <summary>
+		/// Decoded input state
+		/// </summary>
+		DS5InputState state;
+
+		/// <summary>
+		/// QueryPerformanceCounter ticks when the report was read
+		/// </summary>
+		long long receiveTime;
+	} DS5QueuedReport;
+
+	/// <summary>
+	/// Counters of the report queue since it was enabled
+	/// </summary>
+	typedef struct _DS5ReportQueueStatistics {
+		/// <summary>
+		/// Reports queued and popped
+		/// </summary>
+		unsigned long long pushed;
+		unsigned long long popped;
+
+		/// <summary>
+		/// Reports dropped because the queue was full
+		/// </summary>
+		unsigned long long dropped;
+
+		/// <summary>
+		/// Times the input reader waited for room (Block policy)
+		/// </summary>
+		unsigned long long blocked;
+
+		/// <summary>
+		/// Most reports queued at once
+		/// </summary>
+		unsigned int highWater;
+
+		/// <summary>
+		/// Reports queued now
+		/// </summary>
+		unsigned int queued;
+
+		/// <summary>
+		/// Policy when full
+		/// </summary>
+		ReportQueuePolicy policy;
+
+		/// <summary>
+		/// Input reader queues reports
+		/// </summary>
+		bool enabled;
+	} DS5ReportQueueStatistics;
+
+	/// <summary>
+	/// Column arrays for decoding many input reports at once
+	/// Every pointer must reference an array with at least as many elements as reports being decoded
+	/// Values match the fields of DS5InputState with the same name
+	/// </summary>
+	typedef struct _DS5InputBatch {
+		/// <summary>
+		/// Left stick X / Y positions
+		/// </summary>
+		char* leftStickX;
+		char* leftStickY;
+
+		/// <summary>
+		/// Right stick X / Y positions
+		/// </summary>
+		char* rightStickX;
+		char* rightStickY;
+
+		/// <summary>
+		/// Trigger positions
+		/// </summary>
+		unsigned char* leftTrigger;
+		unsigned char* rightTrigger;
+
+		/// <summary>
+		/// Button bitflags (DS5W_ISTATE_BTN_???)
+		/// </summary>
+		unsigned int* buttonMap;
+
+		/// <summary>
+		/// Calibrated gyroscope axes
+		/// </summary>
+		int* gyroscopeX;
+		int* gyroscopeY;
+		int* gyroscopeZ;
+
+		/// <summary>
+		/// Calibrated accelerometer axes
+		/// </summary>
+		int* accelerometerX;
+		int* accelerometerY;
+		int* accelerometerZ;
+
+		/// <summary>
+		/// First and second touch points
+		/// </summary>
+		Touch* touchPoint1;
+		Touch* touchPoint2;
+
+		/// <summary>
+		/// Sensor timestamp and time since previous report in 0.33 microseconds
+		/// </summary>
+		unsigned int* currentTime;
+		unsigned int* deltaTime;
+	} DS5InputBatch;
+
+	/// <summary>
+	/// Type of an input event
+	/// </summary>
+	typedef enum class _InputEventType : unsigned char {
+		/// <summary>
+		/// A button was pressed
+		/// </summary>
+		ButtonDown = 0,
+
+		/// <summary>
+		/// A button was released
+		/// </summary>
+		ButtonUp = 1,
+
+		/// <summary>
+		/// Left stick moved past the threshold
+		/// </summary>
+		LeftStickMoved = 2,
+
+		/// <summary>
+		/// Right stick moved past the threshold
+		/// </summary>
+		RightStickMoved = 3,
+
+		/// <summary>
+		/// Left trigger moved past the threshold
+		/// </summary>
+		LeftTriggerMoved = 4,
+
+		/// <summary>
+		/// Right trigger moved past the threshold
+		/// </summary>
+		RightTriggerMoved = 5,
+
+		/// <summary>
+		/// A finger was put on the touchpad
+		/// </summary>
+		TouchDown = 6,
+
+		/// <summary>
+		/// A finger was lifted from the touchpad
+		/// </summary>
+		TouchUp = 7,
+
+		/// <summary>
+		/// Headphones were plugged in or removed
+		/// </summary>
+		HeadphoneChanged = 8,
+
+		/// <summary>
+		/// Battery level or charging state changed
+		/// </summary>
+		BatteryChanged = 9,
+	} InputEventType;
+
+	/// <summary>
+	/// Single change between two input reports
+	/// </summary>
+	typedef struct _DS5InputEvent {
+		/// <summary>
+		/// Type of event, selects the valid union member
+		/// </summary>
+		InputEventType type;
+
+		/// <summary>
+		/// Sensor timestamp of the report that caused the event
+		/// </summary>
+		unsigned int currentTime;
+
+		union {
+			/// <summary>
+			/// ButtonDown / ButtonUp: DS5W_ISTATE_BTN_* flag of the button
+			/// </summary>
+			unsigned int button;
+
+			/// <summary>
+			/// LeftStickMoved / RightStickMoved: new stick position
+			/// </summary>
+			AnalogStick stick;
+
+			/// <summary>
+			/// LeftTriggerMoved / RightTriggerMoved: new trigger value
+			/// </summary>
+			unsigned char trigger;
+
+			/// <summary>
+			/// TouchDown / TouchUp: touch point (0 or 1) and its state
+			/// </summary>
+			struct {
+				unsigned char index;
+				Touch point;
+			} touch;
+
+			/// <summary>
+			/// HeadphoneChanged: new headphone state
+			/// </summary>
+			bool headPhoneConnected;
+
+			/// <summary>
+			/// BatteryChanged: new battery state
+			/// </summary>
+			Battery battery;
+		};
+	} DS5InputEvent;
+
+	/// <summary>
+	/// Finger on the touchpad followed across input reports
+	/// </summary>
+	typedef struct _DS5TouchContact {
+		/// <summary>
+		/// Position in touchpad pixels (0 - 1920, 0 - 1080)
+		/// </summary>
+		float x;
+		float y;
+
+		/// <summary>
+		/// Velocity in pixels per second
+		/// </summary>
+		float velocityX;
+		float velocityY;
+
+		/// <summary>
+		/// Acceleration in pixels per second squared
+		/// </summary>
+		float accelerationX;
+		float accelerationY;
+
+		/// <summary>
+		/// 7-bit ID for touch
+		/// </summary>
+		unsigned char id;
+
+		/// <summary>
+		/// Touch is down
+		/// </summary>
+		bool down;
+	} DS5TouchContact;
+
+	/// <summary>
+	/// Both touch contacts of the last report used by touch tracking
+	/// </summary>
+	typedef struct _DS5TouchState {
+		/// <summary>
+		/// Contacts in the order they touched down
+		/// </summary>
+		DS5TouchContact contacts[2];
+
+		/// <summary>
+		/// Sensor timestamp of the last report tracked
+		/// </summary>
+		unsigned int currentTime;
+
+		/// <summary>
+		/// Gestures dropped as the queue was full before getTouchGestures() read them, since tracking was turned on or the device reconnected
+		/// </summary>
+		unsigned int droppedGestures;
+	} DS5TouchState;
+
+	/// <summary>
+	/// Type of a touch gesture
+	/// </summary>
+	typedef enum class _TouchGestureType : unsigned char {
+		/// <summary>
+		/// One finger touched briefly without moving
+		/// </summary>
+		Tap = 0,
+
+		/// <summary>
+		/// One finger moved quickly and lifted
+		/// </summary>
+		Swipe = 1,
+
+		/// <summary>
+		/// Two fingers moved apart or together
+		/// </summary>
+		Pinch = 2,
+
+		/// <summary>
+		/// Two fingers moved together in the same direction
+		/// </summary>
+		Scroll = 3,
+	} TouchGestureType;
+
+	/// <summary>
+	/// Progress of a touch gesture, taps and swipes only generate End
+	/// </summary>
+	typedef enum class _TouchGesturePhase : unsigned char {
+		/// <summary>
+		/// Gesture was recognized
+		/// </summary>
+		Begin = 0,
+
+		/// <summary>
+		/// Gesture continued in a new report
+		/// </summary>
+		Update = 1,
+
+		/// <summary>
+		/// Gesture finished
+		/// </summary>
+		End = 2,
+	} TouchGesturePhase;
+
+	/// <summary>
+	/// Touch gesture recognized from the touchpad contacts
+	/// </summary>
+	typedef struct _DS5TouchGesture {
+		/// <summary>
+		/// Type of gesture
+		/// </summary>
+		TouchGestureType type;
+
+		/// <summary>
+		/// Progress of the gesture
+		/// </summary>
+		TouchGesturePhase phase;
+
+		/// <summary>
+		/// Sensor timestamp of the report that generated the gesture
+		/// </summary>
+		unsigned int currentTime;
+
+		/// <summary>
+		/// Position in touchpad pixels, tap and swipe: where the finger touched down, pinch and scroll: center of both fingers
+		/// </summary>
+		float x;
+		float y;
+
+		/// <summary>
+		/// Movement in touchpad pixels, swipe: whole swipe, scroll: since the last scroll gesture
+		/// </summary>
+		float deltaX;
+		float deltaY;
+
+		/// <summary>
+		/// Velocity in pixels per second, swipe: when lifted, scroll: of the center
+		/// </summary>
+		float velocityX;
+		float velocityY;
+
+		/// <summary>
+		/// Pinch: finger distance relative to when the pinch began
+		/// </summary>
+		float scale;
+	} DS5TouchGesture;
+
+	/// <summary>
+	/// Shape of a stick deadzone
+	/// </summary>
+	typedef enum class _StickDeadzoneShape : unsigned char {
+		/// <summary>
+		/// Each axis has its own deadzone, keeps movement along one axis clean
+		/// </summary>
+		Axial = 0,
+
+		/// <summary>
+		/// Deadzone is a circle around the center, keeps the stick direction
+		/// </summary>
+		Radial = 1,
+	} StickDeadzoneShape;
+
+	/// <summary>
+	/// Mapping of an analog input in [0, 1] (stick magnitude or axis, trigger) to the output
+	/// Input below deadzone reads 0, input between deadzone and saturation is mapped to [antiDeadzone, 1] through the curve
+	/// </summary>
+	typedef struct _AnalogResponse {
+		/// <summary>
+		/// Input below this reads 0
+		/// </summary>
+		float deadzone;
+
+		/// <summary>
+		/// Smallest output outside the deadzone, cancels out a deadzone applied by the game
+		/// </summary>
+		float antiDeadzone;
+
+		/// <summary>
+		/// Input above this reads 1, must be greater than deadzone
+		/// </summary>
+		float saturation;
+
+		/// <summary>
+		/// Response curve exponent, 1 is linear and higher values give finer control near the center
+		/// Only used without curve points
+		/// </summary>
+		float exponent;
+
+		/// <summary>
+		/// Optional custom response curve, outputs for inputs evenly spaced from 0 to 1
+		/// Only read while the configuration is applied
+		/// </summary>
+		const float* curvePoints;
+
+		/// <summary>
+		/// Number of curve points, 0 to use the exponent, otherwise at least 2
+		/// </summary>
+		unsigned int curvePointCount;
+	} AnalogResponse;
+
+	/// <summary>
+	/// Conditioning of one analog stick
+	/// </summary>
+	typedef struct _StickConditioning {
+		/// <summary>
+		/// Response of the stick magnitude (radial) or of each axis (axial)
+		/// </summary>
+		AnalogResponse response;
+
+		/// <summary>
+		/// Shape of the deadzone
+		/// </summary>
+		StickDeadzoneShape shape;
+	} StickConditioning;
+
+	/// <summary>
+	/// Conditioning of one trigger
+	/// </summary>
+	typedef struct _TriggerConditioning {
+		/// <summary>
+		/// Response of the trigger
+		/// </summary>
+		AnalogResponse response;
+
+		/// <summary>
+		/// Raw trigger value at which the digital trigger button is pressed
+		/// </summary>
+		unsigned char pressThreshold;
+
+		/// <summary>
+		/// Raw trigger value below which the digital trigger button is released again, at most pressThreshold
+		/// </summary>
+		unsigned char releaseThreshold;
+	} TriggerConditioning;
+
+	/// <summary>
+	/// Analog conditioning of all sticks and triggers
+	/// </summary>
+	typedef struct _DS5AnalogConditioning {
+		StickConditioning leftStick;
+		StickConditioning rightStick;
+		TriggerConditioning leftTrigger;
+		TriggerConditioning rightTrigger;
+	} DS5AnalogConditioning;
+
+	typedef struct _DS5OutputState {
+
+		/// <summary>
+		/// Left / Hard rumbel motor
+		/// </summary>
+		unsigned char leftRumble;
+
+		/// <summary>
+		/// Right / Soft rumbel motor
+		/// </summary>
+		unsigned char rightRumble;
+
+		/// <summary>
+		/// strength of rumble motors in 12.5% steps
+		/// lower nibble (bits 0-3) main rumbles
+		/// uppper nibble (bits 4-7) trigger rumbles
+		/// </summary>
+		unsigned char rumbleStrength;
+
+		/// <summary>
+		/// State of the microphone led
+		/// </summary>
+		MicLed microphoneLed;
+
+		/// <summary>
+		/// Diables all leds
+		/// </summary>
+		bool disableLeds;
+
+		/// <summary>
+		/// Player leds
+		/// </summary>
+		PlayerLeds playerLeds;
+
+		/// <summary>
+		/// Color of the lightbar
+		/// </summary>
+		Color lightbar;
+
+		/// <summary>
+		/// Effect of left trigger
+		/// </summary>
+		TriggerEffect leftTriggerEffect;
+
+		/// <summary>
+		/// Effect of right trigger
+		/// </summary>
+		TriggerEffect rightTriggerEffect;
+
+	} DS5OutputState;
+
+	/// <summary>
+	/// Output state field an animation track drives
+	/// </summary>
+	typedef enum class _AnimationChannel : unsigned char {
+		/// <summary>
+		/// lightbar, from value as red, green, blue and alpha (0 - 1)
+		/// </summary>
+		Lightbar = 0,
+
+		/// <summary>
+		/// playerLeds, from playerLeds, never interpolated
+		/// </summary>
+		PlayerLeds = 1,
+
+		/// <summary>
+		/// leftRumble, from value[0] (0 - 1)
+		/// </summary>
+		LeftRumble = 2,
+
+		/// <summary>
+		/// rightRumble, from value[0] (0 - 1)
+		/// </summary>
+		RightRumble = 3,
+
+		/// <summary>
+		/// leftTriggerEffect, from triggerEffect, never interpolated
+		/// </summary>
+		LeftTrigger = 4,
+
+		/// <summary>
+		/// rightTriggerEffect, from triggerEffect, never interpolated
+		/// </summary>
+		RightTrigger = 5,
+
+		/// <summary>
+		/// Number of channels
+		/// </summary>
+		Count = 6,
+	} AnimationChannel;
+
+	/// <summary>
+	/// How a keyframe moves to the next one
+	/// </summary>
+	typedef enum class _AnimationInterpolation : unsigned char {
+		/// <summary>
+		/// Hold the value until the next keyframe
+		/// </summary>
+		Step = 0,
+
+		/// <summary>
+		/// Constant speed
+		/// </summary>
+		Linear = 1,
+
+		/// <summary>
+		/// Ease in and out (smoothstep)
+		/// </summary>
+		Smooth = 2,
+	} AnimationInterpolation;
+
+	/// <summary>
+	/// Value of an animation channel at a point in time
+	/// </summary>
+	typedef struct _AnimationKeyframe {
+		/// <summary>
+		/// Seconds from the start of the track
+		/// </summary>
+		float time;
+
+		/// <summary>
+		/// Interpolation towards the next keyframe
+		/// </summary>
+		AnimationInterpolation interpolation;
+
+		/// <summary>
+		/// Lightbar color and alpha, or rumble in value[0]
+		/// </summary>
+		float value[4];
+
+		/// <summary>
+		/// Player leds
+		/// </summary>
+		PlayerLeds playerLeds;
+
+		/// <summary>
+		/// Trigger effect
+		/// </summary>
+		TriggerEffect triggerEffect;
+	} AnimationKeyframe;
+
+	/// <summary>
+	/// Keyframes of one channel
+	/// </summary>
+	typedef struct _DS5AnimationTrack {
+		/// <summary>
+		/// Output state field to drive
+		/// </summary>
+		AnimationChannel channel;
+
+		/// <summary>
+		/// Keyframes sorted by time, not copied and must outlive playback
+		/// </summary>
+		const AnimationKeyframe* keyframes;
+
+		/// <summary>
+		/// Number of keyframes
+		/// </summary>
+		unsigned int keyframeCount;
+
+		/// <summary>
+		/// Restart from the first keyframe after the last one, otherwise hold the last value and stop
+		/// </summary>
+		bool loop;
+	} DS5AnimationTrack;
 }
\ No newline at end of file
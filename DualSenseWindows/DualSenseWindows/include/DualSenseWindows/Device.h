@@ -12,6 +12,7 @@
 
 #include <Windows.h>
 #include <DualSenseWindows/DeviceSpecs.h>
+#include <DualSenseWindows/DS5State.h>
 
 // more accurate integer multiplication by a fraction
 constexpr int mult_frac(int x, int numer, int denom)
@@ -30,9 +31,50 @@ namespace DS5W {
 		int sens_numer;
 		int sens_denom;
 
-		int calibrate(int rawValue)
+		/// <summary>
+		/// Division free form of mult_frac(sens_numer, x, sens_denom), filled by precompute()
+		/// quot * x + sign(x) * ((rem * |x| * magic) >> shift)
+		/// magic is 0 when the calibration values are out of range and mult_frac has to be used
+		/// </summary>
+		int sens_quot;
+		unsigned int sens_rem;
+		unsigned int sens_magic;
+		unsigned int sens_shift;
+
+		void precompute()
+		{
+			sens_quot = 0;
+			sens_rem = 0;
+			sens_magic = 0;
+			sens_shift = 0;
+
+			// reciprocal only holds for positive values with a 15 bit denominator
+			if (sens_numer <= 0 || sens_denom <= 0 || sens_denom > 0x7FFF)
+				return;
+
+			// ceil(log2(denom))
+			unsigned int log2Denom = 0;
+			while ((1u << log2Denom) < (unsigned int)sens_denom)
+				log2Denom++;
+
+			// rem * |x| < denom * 2^16, so shift = 2 * log2Denom + 16 keeps the rounding error below one
+			// and magic below 2^32, the product with magic always fits 64 bits
+			sens_quot = sens_numer / sens_denom;
+			sens_rem = sens_numer % sens_denom;
+			sens_shift = 2 * log2Denom + 16;
+			sens_magic = (unsigned int)(((1ull << sens_shift) + sens_denom - 1) / sens_denom);
+		}
+
+		int calibrate(int rawValue) const
 		{
-			return mult_frac(sens_numer, rawValue - bias, sens_denom);
+			const int x = rawValue - bias;
+			const unsigned int absX = x < 0 ? 0u - (unsigned int)x : (unsigned int)x;
+
+			if (sens_magic == 0 || absX > 0xFFFF)
+				return mult_frac(sens_numer, x, sens_denom);
+
+			const int frac = (int)(((unsigned long long)(sens_rem * absX) * sens_magic) >> sens_shift);
+			return sens_quot * x + (x < 0 ? -frac : frac);
 		}
 	} AxisCalibrationData;
 
@@ -48,6 +90,714 @@ namespace DS5W {
 		AxisCalibrationData gyroscope[3];
 	} DeviceCalibrationData;
 
+	/// <summary>
+	/// Storage for generating input events from consecutive input reports
+	/// </summary>
+	typedef struct _InputEventTracker {
+		/// <summary>
+		/// Body of the last input report events were generated from
+		/// </summary>
+		unsigned char lastReport[64];
+
+		/// <summary>
+		/// Stick positions from the last stick move events (left x, left y, right x, right y)
+		/// </summary>
+		char sticks[4];
+
+		/// <summary>
+		/// Trigger values from the last trigger move events (left, right)
+		/// </summary>
+		unsigned char triggers[2];
+
+		/// <summary>
+		/// Distance a stick axis has to move before an event is generated
+		/// </summary>
+		unsigned char stickThreshold;
+
+		/// <summary>
+		/// Distance a trigger has to move before an event is generated
+		/// </summary>
+		unsigned char triggerThreshold;
+
+		/// <summary>
+		/// False until the first report has been seen
+		/// </summary>
+		bool valid;
+	} InputEventTracker;
+
+	/// <summary>
+	/// Orientation estimate of the controller, updated from the motion sensors of each new input report
+	/// </summary>
+	typedef struct _MotionFusionState {
+		/// <summary>
+		/// Orientation quaternion (w, x, y, z) rotating controller axes into world axes
+		/// </summary>
+		float orientation[4];
+
+		/// <summary>
+		/// Filter gain, higher values trust the accelerometer more
+		/// </summary>
+		float beta;
+
+		/// <summary>
+		/// Sensor timestamp of the last report used
+		/// </summary>
+		unsigned int timestamp;
+
+		/// <summary>
+		/// Fusion runs on every new input report
+		/// </summary>
+		bool enabled;
+
+		/// <summary>
+		/// Decoding leaves the report to updateMotionFusionBatch() instead of fusing it
+		/// </summary>
+		bool batched;
+
+		/// <summary>
+		/// False until the orientation has been set from the first accelerometer sample
+		/// </summary>
+		bool initialized;
+	} MotionFusionState;
+
+	/// <summary>
+	/// Touchpad contact tracking and gesture recognition
+	/// </summary>
+	typedef struct _TouchTrackerState {
+		/// <summary>
+		/// Contacts in the order they touched down
+		/// </summary>
+		DS5TouchContact contacts[2];
+
+		/// <summary>
+		/// Where and when each contact touched down
+		/// </summary>
+		float startX[2];
+		float startY[2];
+		unsigned int startTime[2];
+
+		/// <summary>
+		/// Two finger gesture state (PairMode in DS5_Touch.cpp)
+		/// </summary>
+		unsigned char pairMode;
+
+		/// <summary>
+		/// Finger distance and center when the second finger touched down
+		/// </summary>
+		float pairStartDistance;
+		float pairStartCenterX;
+		float pairStartCenterY;
+
+		/// <summary>
+		/// Finger center of the last report
+		/// </summary>
+		float pairCenterX;
+		float pairCenterY;
+
+		/// <summary>
+		/// Pinch scale of the last pinch gesture queued
+		/// </summary>
+		float pairScale;
+
+		/// <summary>
+		/// Most fingers down at once since the touchpad was last released
+		/// </summary>
+		unsigned char sessionContacts;
+
+		/// <summary>
+		/// Gestures not yet read, oldest are overwritten when full
+		/// </summary>
+		DS5TouchGesture gestures[DS5W_TOUCH_GESTURE_QUEUE];
+		unsigned char gestureHead;
+		unsigned char gestureCount;
+
+		/// <summary>
+		/// Gestures overwritten before they were read, only changed by the thread decoding reports
+		/// </summary>
+		unsigned int droppedGestures;
+
+		/// <summary>
+		/// Guards the gesture queue, gestures are queued by the thread decoding reports and read by the user
+		/// </summary>
+		SRWLOCK gestureLock;
+
+		/// <summary>
+		/// Sensor timestamp of the last report used
+		/// </summary>
+		unsigned int timestamp;
+
+		/// <summary>
+		/// Tracking runs on every new input report
+		/// </summary>
+		bool enabled;
+
+		/// <summary>
+		/// False until the first report has been seen
+		/// </summary>
+		bool initialized;
+	} TouchTrackerState;
+
+	/// <summary>
+	/// Model mapping the device's sensor timestamp onto the host's QueryPerformanceCounter
+	/// </summary>
+	typedef struct _ClockSyncState {
+		/// <summary>
+		/// QueryPerformanceCounter ticks per second
+		/// </summary>
+		long long hostFrequency;
+
+		/// <summary>
+		/// Estimated host ticks per device tick
+		/// </summary>
+		double rate;
+
+		/// <summary>
+		/// Estimated host time of the last report (lower envelope of receive times)
+		/// </summary>
+		double hostAnchor;
+
+		/// <summary>
+		/// Smoothed distance of receive times above the estimate, in host ticks
+		/// </summary>
+		double latency;
+
+		/// <summary>
+		/// Unwrapped device time of the last report, continues across wraparound and reconnects
+		/// </summary>
+		unsigned long long deviceTime;
+
+		/// <summary>
+		/// Raw sensor timestamp of the last report
+		/// </summary>
+		unsigned int lastTimestamp;
+
+		/// <summary>
+		/// Host time the last report was received
+		/// </summary>
+		long long lastReceiveTime;
+
+		/// <summary>
+		/// Number of reports fed into the model
+		/// </summary>
+		unsigned int sampleCount;
+
+		/// <summary>
+		/// Number of times the offset was taken from a fresh report (first connection and reconnects)
+		/// </summary>
+		unsigned int anchorCount;
+
+		/// <summary>
+		/// False when the next report has to set the offset again
+		/// </summary>
+		bool anchored;
+
+		/// <summary>
+		/// False until the first report has been seen
+		/// </summary>
+		bool valid;
+	} ClockSyncState;
+
+	/// <summary>
+	/// Tracking of the input report sequence counter
+	/// </summary>
+	typedef struct _ReportSequenceState {
+		/// <summary>
+		/// Sequence counter of the last report
+		/// </summary>
+		unsigned char lastSequence;
+
+		/// <summary>
+		/// Sensor timestamp of the last report
+		/// </summary>
+		unsigned int lastTimestamp;
+
+		/// <summary>
+		/// Average sensor time between consecutive reports, 0 until measured
+		/// </summary>
+		unsigned int reportInterval;
+
+		/// <summary>
+		/// Reports lost right before the last report
+		/// </summary>
+		unsigned int lastGap;
+
+		/// <summary>
+		/// Largest gap seen
+		/// </summary>
+		unsigned int largestGap;
+
+		/// <summary>
+		/// Counters since the last reset
+		/// </summary>
+		unsigned long long received;
+		unsigned long long lost;
+		unsigned long long duplicated;
+
+		/// <summary>
+		/// False until the first report after connecting
+		/// </summary>
+		bool valid;
+	} ReportSequenceState;
+
+	/// <summary>
+	/// Background thread writing the latest submitted output state at a fixed rate
+	/// </summary>
+	typedef struct _OutputWriterState {
+		/// <summary>
+		/// Writer thread, NULL when not started
+		/// </summary>
+		HANDLE thread;
+
+		/// <summary>
+		/// Periodic waitable timer the thread flushes on
+		/// </summary>
+		HANDLE timer;
+
+		/// <summary>
+		/// Signaled to make the thread flush once more and exit
+		/// </summary>
+		HANDLE stopEvent;
+
+		/// <summary>
+		/// Guards every field below
+		/// </summary>
+		SRWLOCK lock;
+
+		/// <summary>
+		/// Latest output state not yet written
+		/// </summary>
+		DS5W::DS5OutputState pending;
+		bool pendingValid;
+
+		/// <summary>
+		/// DS5W_OSTATE_SUBSYSTEM_ bits of pending submitted since the last write
+		/// </summary>
+		unsigned int pendingSubsystems;
+
+		/// <summary>
+		/// Flush rate in Hz
+		/// </summary>
+		unsigned int rate;
+
+		/// <summary>
+		/// Counters since the writer was started
+		/// </summary>
+		unsigned long long submitted;
+		unsigned long long coalesced;
+		unsigned long long written;
+		unsigned long long unchanged;
+		unsigned long long failed;
+
+		/// <summary>
+		/// Thread accepts output states
+		/// </summary>
+		bool running;
+
+		/// <summary>
+		/// Thread stopped itself as the device was removed
+		/// </summary>
+		bool deviceRemoved;
+	} OutputWriterState;
+
+	/// <summary>
+	/// Bluetooth haptics stream, frames written by the application are sent by a thread at DS_HAPTICS_SAMPLE_RATE
+	/// </summary>
+	typedef struct _HapticsStreamState {
+		/// <summary>
+		/// Stream thread, NULL when not started
+		/// </summary>
+		HANDLE thread;
+
+		/// <summary>
+		/// Waitable timer set to the due time of the next report
+		/// </summary>
+		HANDLE timer;
+
+		/// <summary>
+		/// Signaled to make the thread exit
+		/// </summary>
+		HANDLE stopEvent;
+
+		/// <summary>
+		/// Synchronization struct for haptics reports, separate from other output
+		/// </summary>
+		OVERLAPPED olWrite;
+
+		/// <summary>
+		/// Haptics report being written
+		/// </summary>
+		unsigned char report[DS_OUTPUT_REPORT_BT_HAPTICS_SIZE];
+
+		/// <summary>
+		/// Sequence number of the next report
+		/// </summary>
+		unsigned char sequence;
+
+		/// <summary>
+		/// Resampled frames (left, right), one writer (the application) and one reader (the stream thread)
+		/// </summary>
+		signed char frames[DS5W_HAPTICS_RING_FRAMES][2];
+
+		/// <summary>
+		/// Frames written and read since the stream started, the ring index is the count modulo DS5W_HAPTICS_RING_FRAMES
+		/// Only changed through Interlocked functions after the frames they cover
+		/// </summary>
+		volatile LONG writeCount;
+		volatile LONG readCount;
+
+		/// <summary>
+		/// Resampler state, only used by the application thread
+		/// Input frames are averaged until the output clock passes the next frame
+		/// </summary>
+		unsigned int inputRate;
+		unsigned int phase;
+		int sum[2];
+		unsigned int sumCount;
+		signed char last[2];
+
+		/// <summary>
+		/// Last report carried frames, an empty ring after it is an underrun
+		/// </summary>
+		bool streaming;
+
+		/// <summary>
+		/// Counters since the stream was started, only changed through Interlocked functions
+		/// </summary>
+		volatile LONG64 reportsWritten;
+		volatile LONG64 underruns;
+		volatile LONG64 overruns;
+		volatile LONG64 droppedFrames;
+		volatile LONG64 failed;
+
+		/// <summary>
+		/// Thread accepts frames, and thread stopped itself as the device was removed
+		/// </summary>
+		volatile LONG running;
+		volatile LONG deviceRemoved;
+	} HapticsStreamState;
+
+	/// <summary>
+	/// Output change waiting in the output timeline
+	/// </summary>
+	typedef struct _OutputTimelineEvent {
+		/// <summary>
+		/// Host time (QueryPerformanceCounter ticks) the change is due
+		/// </summary>
+		long long hostTime;
+
+		/// <summary>
+		/// Scheduling order, changes due at the same time are applied in this order
+		/// </summary>
+		unsigned long long order;
+
+		/// <summary>
+		/// DS5W_OSTATE_SUBSYSTEM_ bits taken from state
+		/// </summary>
+		unsigned int subsystems;
+		DS5W::DS5OutputState state;
+	} OutputTimelineEvent;
+
+	/// <summary>
+	/// Background thread applying output changes at the host time they are due
+	/// </summary>
+	typedef struct _OutputTimelineState {
+		/// <summary>
+		/// Timeline thread, NULL when not started
+		/// </summary>
+		HANDLE thread;
+
+		/// <summary>
+		/// Waitable timer set to the next due time
+		/// </summary>
+		HANDLE timer;
+
+		/// <summary>
+		/// Signaled to make the thread exit
+		/// </summary>
+		HANDLE stopEvent;
+
+		/// <summary>
+		/// Signaled when a change becomes the next one due
+		/// </summary>
+		HANDLE wakeEvent;
+
+		/// <summary>
+		/// QueryPerformanceCounter ticks per second
+		/// </summary>
+		long long hostFrequency;
+
+		/// <summary>
+		/// Guards every field below except current and lastDispatch
+		/// </summary>
+		SRWLOCK lock;
+
+		/// <summary>
+		/// Binary min heap of waiting changes by due time, then order
+		/// </summary>
+		OutputTimelineEvent events[DS5W_OUTPUT_TIMELINE_CAPACITY];
+		unsigned int eventCount;
+		unsigned long long nextOrder;
+
+		/// <summary>
+		/// Counters since the timeline was started, lateness in host ticks
+		/// </summary>
+		unsigned long long scheduled;
+		unsigned long long dispatched;
+		unsigned long long merged;
+		unsigned long long reports;
+		unsigned long long failed;
+		unsigned long long lateEvents;
+		unsigned long long latenessTotal;
+		unsigned long long latenessMax;
+		unsigned long long latenessLast;
+
+		/// <summary>
+		/// Thread accepts changes
+		/// </summary>
+		bool running;
+
+		/// <summary>
+		/// Thread stopped itself as the device was removed
+		/// </summary>
+		bool deviceRemoved;
+
+		/// <summary>
+		/// Dispatched changes are being sent, the last output report does not tell what the device gets
+		/// </summary>
+		bool sending;
+
+		/// <summary>
+		/// Output state all dispatched changes were merged into, only used by the thread
+		/// </summary>
+		DS5W::DS5OutputState current;
+
+		/// <summary>
+		/// Host time of the last report, only used by the thread
+		/// </summary>
+		long long lastDispatch;
+	} OutputTimelineState;
+
+	/// <summary>
+	/// Ring of overlapped input reads kept posted so a report is always being received
+	/// Reads complete in the order they were posted and are taken in the same order
+	/// </summary>
+	typedef struct _InputPipelineState {
+		/// <summary>
+		/// Report buffer and overlapped struct of each read
+		/// </summary>
+		unsigned char buffers[DS5W_INPUT_PIPELINE_MAX_DEPTH][DS_MAX_INPUT_REPORT_SIZE];
+		OVERLAPPED overlapped[DS5W_INPUT_PIPELINE_MAX_DEPTH];
+
+		/// <summary>
+		/// Read is handed to the driver and its buffer must stay untouched
+		/// </summary>
+		bool posted[DS5W_INPUT_PIPELINE_MAX_DEPTH];
+
+		/// <summary>
+		/// Number of reads in the ring, 0 reads one report at a time through olRead
+		/// </summary>
+		unsigned int depth;
+
+		/// <summary>
+		/// Oldest read, taken next
+		/// </summary>
+		unsigned int next;
+
+		/// <summary>
+		/// Report length the reads were posted with
+		/// </summary>
+		unsigned short reportLen;
+
+		/// <summary>
+		/// startInputRequest() already took a report, the next awaitInputRequest() returns without reading
+		/// </summary>
+		bool taken;
+
+		/// <summary>
+		/// QueryPerformanceCounter ticks per second
+		/// </summary>
+		long long hostFrequency;
+
+		/// <summary>
+		/// Counters since the depth was set, wait in host ticks
+		/// </summary>
+		unsigned long long reports;
+		unsigned long long readyReports;
+		unsigned long long failed;
+		unsigned long long waitTotal;
+		unsigned long long waitMax;
+	} InputPipelineState;
+
+	/// <summary>
+	/// Input mode and the HID queue length it set
+	/// </summary>
+	typedef struct _InputModeState {
+		/// <summary>
+		/// Whether reads flush the HID queue and how long it is
+		/// </summary>
+		DS5W::InputMode mode;
+		unsigned int queueLength;
+
+		/// <summary>
+		/// Counters since the mode was set
+		/// </summary>
+		unsigned long long skipped;
+		unsigned long long drained;
+		unsigned long long drains;
+		unsigned int largestDrain;
+	} InputModeState;
+
+	/// <summary>
+	/// State last decoded by the input reader or an input engine, published through a sequence lock
+	/// </summary>
+	typedef struct _LatestInputState {
+		/// <summary>
+		/// Odd while the states are being written, incremented twice per published report
+		/// </summary>
+		volatile LONG sequence;
+
+		/// <summary>
+		/// Input state, orientation and touch contacts, only valid between equal even sequence values
+		/// Orientation and contacts are copied when reads are taken over, so they are valid before the first report
+		/// </summary>
+		DS5W::DS5InputState input;
+		DS5W::DS5MotionState motion;
+		DS5W::DS5TouchState touch;
+	} LatestInputState;
+
+	/// <summary>
+	/// Background thread reading every input report and publishing the decoded state
+	/// </summary>
+	typedef struct _InputReaderState {
+		/// <summary>
+		/// Reader thread, NULL when not started
+		/// </summary>
+		HANDLE thread;
+
+		/// <summary>
+		/// Set to make the thread exit after its current read
+		/// </summary>
+		volatile LONG stopRequested;
+
+		/// <summary>
+		/// Reads that failed without the device being removed, only changed through Interlocked functions
+		/// </summary>
+		volatile LONG64 failed;
+
+		/// <summary>
+		/// Thread owns input reads, and thread stopped itself as the device was removed
+		/// </summary>
+		volatile LONG running;
+		volatile LONG deviceRemoved;
+	} InputReaderState;
+
+	/// <summary>
+	/// Input engine a device is registered with
+	/// </summary>
+	typedef struct _InputEngineLink {
+		/// <summary>
+		/// Engine reading the device (DS5InputEngine), NULL if none
+		/// </summary>
+		void* engine;
+
+		/// <summary>
+		/// Set when the engine stops reading the device, a report queue blocking for room gives up
+		/// </summary>
+		volatile LONG stopRequested;
+
+		/// <summary>
+		/// Engine found the device removed, or it was disconnected from the engine callback
+		/// The engine drops such devices on its own, the flag stays set until the device is registered again
+		/// </summary>
+		volatile LONG deviceRemoved;
+	} InputEngineLink;
+
+	/// <summary>
+	/// Decoded reports queued by the input reader (one producer) for the application (one consumer)
+	/// </summary>
+	typedef struct _ReportQueueState {
+		/// <summary>
+		/// Queued reports, the ring index is the count modulo DS5W_REPORT_QUEUE_CAPACITY
+		/// </summary>
+		DS5W::DS5QueuedReport reports[DS5W_REPORT_QUEUE_CAPACITY];
+
+		/// <summary>
+		/// Reports written and read since the queue was enabled, only changed through Interlocked functions after the reports they cover
+		/// The input reader also moves readCount when dropping the oldest report, the consumer commits with a compare exchange
+		/// </summary>
+		volatile LONG writeCount;
+		volatile LONG readCount;
+
+		/// <summary>
+		/// Signaled by the consumer while the input reader waits for room (Block policy)
+		/// </summary>
+		HANDLE spaceEvent;
+		volatile LONG producerWaiting;
+
+		/// <summary>
+		/// Only changed while the input reader is stopped
+		/// </summary>
+		DS5W::ReportQueuePolicy policy;
+		bool enabled;
+
+		/// <summary>
+		/// Counters since the queue was enabled, only changed through Interlocked functions
+		/// </summary>
+		volatile LONG64 pushed;
+		volatile LONG64 popped;
+		volatile LONG64 dropped;
+		volatile LONG64 blocked;
+		volatile LONG highWater;
+	} ReportQueueState;
+
+	/// <summary>
+	/// Stick and trigger conditioning compiled into lookup tables
+	/// </summary>
+	typedef struct _AnalogConditioningTables {
+		/// <summary>
+		/// Conditioned stick axes indexed by the raw report byte (left x, left y, right x, right y)
+		/// Radial sticks only normalize here and are scaled by stickGain
+		/// </summary>
+		float stickAxis[4][256];
+
+		/// <summary>
+		/// stickAxis rounded to the integer input state range, axial sticks only
+		/// </summary>
+		char stickAxisI[4][256];
+
+		/// <summary>
+		/// Radial sticks: output scale indexed by input magnitude (0 - STICK_GAIN_RANGE mapped to 0 - 255)
+		/// </summary>
+		float stickGain[2][256];
+
+		/// <summary>
+		/// Conditioned triggers indexed by the raw report byte (left, right)
+		/// </summary>
+		float trigger[2][256];
+
+		/// <summary>
+		/// trigger rounded to the integer input state range
+		/// </summary>
+		unsigned char triggerI[2][256];
+
+		/// <summary>
+		/// Digital trigger thresholds and current state (left, right)
+		/// </summary>
+		unsigned char pressThreshold[2];
+		unsigned char releaseThreshold[2];
+		bool triggerPressed[2];
+
+		/// <summary>
+		/// Stick uses stickGain (left, right)
+		/// </summary>
+		bool radial[2];
+
+		/// <summary>
+		/// Conditioning is applied when decoding
+		/// </summary>
+		bool enabled;
+	} AnalogConditioningTables;
+
 	/// <summary>
 	/// Enum for device connection type
 	/// </summary>
@@ -133,11 +883,91 @@ namespace DS5W {
 			/// </summary>
 			DeviceCalibrationData calibrationData;
 
+			/// <summary>
+			/// State required to generate input events
+			/// </summary>
+			InputEventTracker inputEvents;
+
+			/// <summary>
+			/// Orientation estimate from the motion sensors
+			/// </summary>
+			MotionFusionState motionFusion;
+
+			/// <summary>
+			/// Touchpad contacts and gestures
+			/// </summary>
+			TouchTrackerState touchTracker;
+
+			/// <summary>
+			/// Mapping from device time to host time
+			/// </summary>
+			ClockSyncState clockSync;
+
+			/// <summary>
+			/// Lost and duplicated report tracking
+			/// </summary>
+			ReportSequenceState reportSequence;
+
+			/// <summary>
+			/// Background output writer
+			/// </summary>
+			OutputWriterState outputWriter;
+
+			/// <summary>
+			/// Bluetooth haptics stream
+			/// </summary>
+			HapticsStreamState hapticsStream;
+
+			/// <summary>
+			/// Scheduled output changes
+			/// </summary>
+			OutputTimelineState outputTimeline;
+
+			/// <summary>
+			/// Posted input reads
+			/// </summary>
+			InputPipelineState inputPipeline;
+
+			/// <summary>
+			/// Input mode
+			/// </summary>
+			InputModeState inputMode;
+
+			/// <summary>
+			/// Background input reader
+			/// </summary>
+			InputReaderState inputReader;
+
+			/// <summary>
+			/// State last decoded by the input reader or input engine
+			/// </summary>
+			LatestInputState latestInput;
+
+			/// <summary>
+			/// Reports queued by the input reader
+			/// </summary>
+			ReportQueueState reportQueue;
+
+			/// <summary>
+			/// Input engine reading the device
+			/// </summary>
+			InputEngineLink inputEngine;
+
+			/// <summary>
+			/// Stick and trigger conditioning
+			/// </summary>
+			AnalogConditioningTables conditioning;
+
 			/// <summary>
 			/// Time when last input report was received, measured in 0.33 microseconds
 			/// </summary>
 			unsigned int timestamp;
 
+			/// <summary>
+			/// Time between the last two input reports, kept so the held report can be decoded more than once
+			/// </summary>
+			unsigned int deltaTime;
+
 			/// <summary>
 			/// Current state of connection
 			/// </summary>
@@ -152,6 +982,31 @@ namespace DS5W {
 			/// HID Output buffer
 			/// </summary>
 			unsigned char hidOutBuffer[DS_MAX_OUTPUT_REPORT_SIZE];
+
+			/// <summary>
+			/// Output report body of the last output state sent, used to skip sending the same state again
+			/// </summary>
+			unsigned char lastOutputBody[DS_OUTPUT_REPORT_BODY_SIZE];
+
+			/// <summary>
+			/// lastOutputBody matches what the device was last sent
+			/// </summary>
+			bool lastOutputValid;
+
+			/// <summary>
+			/// Last BT output report hashed (minus the hash), the hash of the next report is updated from it
+			/// </summary>
+			unsigned char btOutputReport[DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32)];
+
+			/// <summary>
+			/// Hash of btOutputReport
+			/// </summary>
+			UINT32 btOutputCrc;
+
+			/// <summary>
+			/// btOutputReport and btOutputCrc hold a report
+			/// </summary>
+			bool btOutputCrcValid;
 		}_internal;
 	} DeviceContext;
 }
\ No newline at end of file
@@ -21,6 +21,12 @@
 #define DS_OUTPUT_REPORT_USB_SIZE				63
 #define DS_OUTPUT_REPORT_BT						0x31
 #define DS_OUTPUT_REPORT_BT_SIZE				78
+#define DS_OUTPUT_REPORT_BODY_SIZE				62 /* DS_OUTPUT_REPORT_USB_SIZE without the report ID */
+#define DS_OUTPUT_REPORT_BT_HAPTICS				0x32
+#define DS_OUTPUT_REPORT_BT_HAPTICS_SIZE		141
+
+#define DS_HAPTICS_SAMPLE_RATE					3000 /* haptic samples per second and channel in DS_OUTPUT_REPORT_BT_HAPTICS */
+#define DS_HAPTICS_FRAMES_PER_REPORT			32 /* stereo frames in one DS_OUTPUT_REPORT_BT_HAPTICS */
 
 #define DS_FEATURE_REPORT_CALIBRATION			0x05
 #define DS_FEATURE_REPORT_CALIBRATION_SIZE		41
@@ -38,6 +44,7 @@
 #define DS_GYRO_RANGE							(2048*DS_GYRO_RES_PER_DEG_S)
 #define DS_TOUCHPAD_WIDTH						1920
 #define DS_TOUCHPAD_HEIGHT						1080
+#define DS_SENSOR_TIMESTAMP_PER_SECOND			3000000 /* sensor timestamp counts 0.33 microseconds */
 
 /*	
 	// body of input report
@@ -50,7 +57,7 @@
 	0x04 uint8_t left_trigger
 	0x05 uint8_t right_trigger
 
-	0x06 uint8_t seq_number; // unknown use
+	0x06 uint8_t seq_number; // increments every report
 
 	0x07 uint8_t buttons[4];
 	0x0B uint8_t reserved[4];
@@ -117,4 +124,19 @@
 	outputReport[45] = 0x1f; // Red value of light bars left and right from touchpad
 	outputReport[46] = 0xff; // Green value of light bars left and right from touchpad
 	outputReport[47] = 0x1f; // Blue value of light bars left and right from touchpad
+*/
+
+/*
+	// BT haptics output report (DS_OUTPUT_REPORT_BT_HAPTICS), reverse engineered from captures, layout unofficial
+	// carries sampled audio for the voice coil actuators instead of the two motor rumble bytes
+
+	0x00 uint8_t report_id; // 0x32
+	0x01 uint8_t tag; // upper nibble sequence number, increments every report
+
+	// packets follow each other: uint8_t id | 0x80 (length present), uint8_t length, uint8_t data[length]
+	0x02 packet 0x11, length 7: { 0xFE, 0x00, 0x00, 0x00, 0x00, 0xFF, sequence }
+	0x0B packet 0x12, length 64: int8_t samples[32][2]; // left, right at 3000 Hz
+
+	0x4D uint8_t reserved[60];
+	0x89 uint32_t crc; // same as DS_OUTPUT_REPORT_BT
 */
\ No newline at end of file
@@ -76,26 +76,475 @@ namespace DS5W {
 	/// <summary>
 	/// Set the device output state
 	/// Blocks thread until state is read or an error occurs
+	/// While the output writer runs the state is handed to it instead and this returns immediately
 	/// </summary>
 	/// <param name="ptrContext">Pointer to context</param>
 	/// <param name="ptrOutputState">Pointer to output state to be set</param>
 	/// <returns>Result of call</returns>
 	extern "C" DS5W_API DS5W_ReturnValue setDeviceOutputState(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState);
 
+	/// <summary>
+	/// Set only some subsystems of the device output state, the device keeps its state for the others
+	/// Producers updating different subsystems can interleave without overwriting each other
+	/// Blocks thread until state is read or an error occurs, or hands the subsystems to the output writer while it runs
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrOutputState">Pointer to output state, only fields of the subsystems are read</param>
+	/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits that changed</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setDeviceOutputStateMasked(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems);
+
+	/// <summary>
+	/// Set the device output state only if it differs from the last state sent
+	/// Identical states return without computing the report checksum or writing to the device
+	/// While the output writer runs the state is handed to it instead, ptrWritten is then false
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrOutputState">Pointer to output state to be set</param>
+	/// <param name="ptrWritten">Optional, set to whether a report was sent</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue updateDeviceOutputState(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState, bool* ptrWritten);
+
 	/// <summary>
 	/// Starts an overlapped IO call to get device input report
+	/// With an input pipeline the oldest posted read is checked instead, DS5W_E_IO_PENDING until it completed
 	/// </summary>
 	extern "C" DS5W_API DS5W_ReturnValue startInputRequest(DS5W::DeviceContext* ptrContext);
 
 	/// <summary>
 	/// Waits until overlapped call finishes
-	/// Only call this if startInputRequest() returned DS5W_E_IO_PENDING
+	/// Only call this if startInputRequest() returned DS5W_E_IO_PENDING, with an input pipeline it returns right away after a report startInputRequest() took
 	/// </summary>
 	extern "C" DS5W_API DS5W_ReturnValue awaitInputRequest(DS5W::DeviceContext* ptrContext);
 
 	/// <summary>
 	/// Parses and copies the last input report read into an InputState struct
 	/// Intended to be used with startInputRequest() after the request is completed
+	/// Does nothing while the input reader or an input engine reads the device
 	/// </summary>
 	extern "C" DS5W_API void getHeldInputState(DS5W::DeviceContext * ptrContext, DS5W::DS5InputState * ptrInputState);
-}
+
+	/// <summary>
+	/// Get device input state, only decoding the requested fields
+	/// Fields not in the mask are left untouched and can be decoded later with getHeldInputStateMasked()
+	/// Blocks thread until state is read or an error occurs
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrInputState">Pointer to input state</param>
+	/// <param name="fieldMask">DS5W_ISTATE_FIELD_* flags of fields to decode</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getDeviceInputStateMasked(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int fieldMask);
+
+	/// <summary>
+	/// Parses only the requested fields of the last input report read into an InputState struct
+	/// The held report can be decoded any number of times, delta time stays the same until a new report is read
+	/// Does nothing while the input reader or an input engine reads the device
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrInputState">Pointer to input state</param>
+	/// <param name="fieldMask">DS5W_ISTATE_FIELD_* flags of fields to decode</param>
+	extern "C" DS5W_API void getHeldInputStateMasked(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int fieldMask);
+
+	/// <summary>
+	/// Get device input state converted to floats in SI units
+	/// Blocks thread until state is read or an error occurs
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrInputState">Pointer to float input state</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getDeviceInputStateF(DS5W::DeviceContext* ptrContext, DS5W::DS5InputStateF* ptrInputState);
+
+	/// <summary>
+	/// Parses the last input report read into a float InputState struct
+	/// Intended to be used with startInputRequest() after the request is completed
+	/// Does nothing while the input reader or an input engine reads the device
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrInputState">Pointer to float input state</param>
+	extern "C" DS5W_API void getHeldInputStateF(DS5W::DeviceContext* ptrContext, DS5W::DS5InputStateF* ptrInputState);
+
+	/// <summary>
+	/// Decodes many raw input reports into column arrays using SIMD
+	/// Gives the same values as parsing each report in order with getHeldInputState
+	/// The context's previous timestamp is used for the first delta time and is updated to the last report's time
+	/// </summary>
+	/// <param name="ptrContext">Context of the device the reports came from (supplies calibration data)</param>
+	/// <param name="reportBodies">Pointer to the first report body (USB reports skip 1 header byte, BT reports skip 2)</param>
+	/// <param name="reportStride">Distance in bytes between the start of consecutive report bodies</param>
+	/// <param name="reportCount">Number of reports to decode</param>
+	/// <param name="ptrBatch">Columns to write to, each must hold reportCount elements</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue decodeInputReportBatch(DS5W::DeviceContext* ptrContext, const unsigned char* reportBodies, unsigned int reportStride, unsigned int reportCount, DS5W::DS5InputBatch* ptrBatch);
+
+	/// <summary>
+	/// Read an input report and list what changed since the last report events were generated from
+	/// The first report after connecting only sets the starting point and generates no events
+	/// Blocks thread until state is read or an error occurs
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrEvents">Array to receive the events</param>
+	/// <param name="maxEvents">Length of event array, DS5W_MAX_INPUT_EVENTS is always enough</param>
+	/// <param name="eventCount">Receives the number of events generated</param>
+	/// <returns>Result of call, DS5W_E_INSUFFICIENT_BUFFER if events did not fit (extra events are lost)</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getDeviceInputEvents(DS5W::DeviceContext* ptrContext, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents, unsigned int* eventCount);
+
+	/// <summary>
+	/// List what changed in the last input report read since the last report events were generated from
+	/// Intended to be used with startInputRequest() after the request is completed
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrEvents">Array to receive the events</param>
+	/// <param name="maxEvents">Length of event array, DS5W_MAX_INPUT_EVENTS is always enough</param>
+	/// <param name="eventCount">Receives the number of events generated</param>
+	/// <returns>Result of call, DS5W_E_INSUFFICIENT_BUFFER if events did not fit (extra events are lost), DS5W_E_CURRENTLY_NOT_SUPPORTED while the input reader or an input engine reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getHeldInputEvents(DS5W::DeviceContext* ptrContext, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents, unsigned int* eventCount);
+
+	/// <summary>
+	/// Set how far sticks and triggers have to move before a move event is generated
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="stickThreshold">Distance per stick axis (0 and 1 report every change)</param>
+	/// <param name="triggerThreshold">Distance per trigger (0 and 1 report every change)</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED while the input reader or an input engine reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setInputEventThresholds(DS5W::DeviceContext* ptrContext, unsigned char stickThreshold, unsigned char triggerThreshold);
+
+	/// <summary>
+	/// Turn the motion fusion on or off
+	/// When on, every new input report read through this context updates its orientation (Madgwick filter, dt from the sensor timestamp)
+	/// Batched contexts are only updated by updateMotionFusionBatch(), the input reader and input engines do not fuse them
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="enabled">Run fusion on new reports</param>
+	/// <param name="beta">Filter gain, higher trusts the accelerometer more (0.1 is a good start)</param>
+	/// <param name="batched">Leave new reports to updateMotionFusionBatch() instead of fusing them while decoding</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED while the input reader or an input engine reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setMotionFusion(DS5W::DeviceContext* ptrContext, bool enabled, float beta = 0.1f, bool batched = false);
+
+	/// <summary>
+	/// Restart the orientation estimate from the next accelerometer sample
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED while the input reader or an input engine reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue resetMotionFusion(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Get the orientation and gravity vector estimated by the motion fusion
+	/// While the input reader or an input engine reads the device this is the estimate published with getLatestInputState()
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrMotionState">Pointer to motion state</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if fusion is off</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getMotionState(DS5W::DeviceContext* ptrContext, DS5W::DS5MotionState* ptrMotionState);
+
+	/// <summary>
+	/// Fuse the held input report of many controllers at once, 4 controllers per SSE register
+	/// Intended for reading several controllers with startInputRequest(), decoding them and then updating them together
+	/// Contexts with fusion off or without a new report are skipped, only contexts set up with batched fusion are left to this call
+	/// </summary>
+	/// <param name="ptrContexts">Array of context pointers (null entries are skipped)</param>
+	/// <param name="contextCount">Length of the array</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if the input reader or an input engine reads one of the devices</returns>
+	extern "C" DS5W_API DS5W_ReturnValue updateMotionFusionBatch(DS5W::DeviceContext** ptrContexts, unsigned int contextCount);
+
+	/// <summary>
+	/// Get the state of the mapping from device sensor time to host QueryPerformanceCounter time
+	/// The mapping is updated whenever a read completes through this API
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrInfo">Pointer to clock information</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getClockSyncInfo(DS5W::DeviceContext* ptrContext, DS5W::DS5ClockSyncInfo* ptrInfo);
+
+	/// <summary>
+	/// Convert a sensor timestamp (e.g. from DS5InputBatch) to host QueryPerformanceCounter ticks
+	/// Timestamps must be within about 10 minutes of the last report read
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="deviceTimestamp">Sensor timestamp in 0.33 microseconds</param>
+	/// <param name="ptrHostTime">Pointer to host time</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED before the first report</returns>
+	extern "C" DS5W_API DS5W_ReturnValue deviceToHostTime(DS5W::DeviceContext* ptrContext, unsigned int deviceTimestamp, long long* ptrHostTime);
+
+	/// <summary>
+	/// Get the number of input reports read, lost and read twice
+	/// Reports are counted whenever a read completes through this API
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getReportStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5ReportStatistics* ptrStatistics);
+
+	/// <summary>
+	/// Clear the counters returned by getReportStatistics()
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue resetReportStatistics(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Turn touchpad contact tracking and gesture recognition on or off
+	/// When on, every new input report read through this API updates the contacts and queues gestures
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="enabled">Track touches on new reports</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED while the input reader or an input engine reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setTouchTracking(DS5W::DeviceContext* ptrContext, bool enabled);
+
+	/// <summary>
+	/// Get the tracked touch contacts with their velocity and acceleration
+	/// While the input reader or an input engine reads the device these are the contacts published with getLatestInputState()
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrTouchState">Pointer to touch state</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if tracking is off</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getTouchState(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchState* ptrTouchState);
+
+	/// <summary>
+	/// Take the touch gestures recognized since the last call, oldest first
+	/// Up to DS5W_TOUCH_GESTURE_QUEUE gestures are kept, older ones are dropped and counted by getTouchState()
+	/// Can be called while the input reader or an input engine reads the device
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrGestures">Array to receive gestures</param>
+	/// <param name="maxGestures">Length of the array</param>
+	/// <param name="ptrGestureCount">Number of gestures written</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if tracking is off</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getTouchGestures(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchGesture* ptrGestures, unsigned int maxGestures, unsigned int* ptrGestureCount);
+
+	/// <summary>
+	/// Apply deadzones, response curves and trigger button thresholds to every decoded input state
+	/// The configuration is compiled into lookup tables once, decoding then costs a few table lookups
+	/// Batch decoding (decodeInputReportBatch) and input events stay unconditioned
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrConditioning">Configuration, null to return to raw values</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED while the input reader or an input engine reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setAnalogConditioning(DS5W::DeviceContext* ptrContext, const DS5W::DS5AnalogConditioning* ptrConditioning);
+
+	/// <summary>
+	/// Start a background thread writing output states at a fixed rate
+	/// Output states are then submitted without blocking and only the latest one is written on each tick
+	/// The writer owns output while running, setDeviceOutputState and updateDeviceOutputState submit to it
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="rate">Writes per second, rounded to whole milliseconds. 0 or above the transport maximum (250 BT, 1000 USB) uses the maximum</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue startOutputWriter(DS5W::DeviceContext* ptrContext, unsigned int rate = 0);
+
+	/// <summary>
+	/// Hand an output state to the output writer, replacing a state not yet written
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrOutputState">Pointer to output state to be set</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if the writer is not running</returns>
+	extern "C" DS5W_API DS5W_ReturnValue submitOutputState(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState);
+
+	/// <summary>
+	/// Write the last submitted state and stop the output writer
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue stopOutputWriter(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Get the number of output states submitted to the output writer, replaced before being written and written
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getOutputWriterStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputWriterStatistics* ptrStatistics);
+
+	/// <summary>
+	/// Start streaming haptics (experimental, Bluetooth only)
+	/// Frames written with writeHapticsFrames are sent to the voice coil actuators at DS_HAPTICS_SAMPLE_RATE with their own reports
+	/// The rumble bytes of output states are not used meanwhile by the device
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED over USB</returns>
+	extern "C" DS5W_API DS5W_ReturnValue startHapticsStream(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Queue PCM frames on the haptics stream, resampled to DS_HAPTICS_SAMPLE_RATE
+	/// Frames that do not fit into the buffer (DS5W_HAPTICS_RING_FRAMES after resampling) are dropped and counted as an overrun
+	/// Must only be called from one thread at a time
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrFrames">Interleaved 16 bit stereo frames (left, right)</param>
+	/// <param name="frameCount">Number of frames</param>
+	/// <param name="sampleRate">Sample rate of the frames in Hz, up to 192000</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if the stream is not running</returns>
+	extern "C" DS5W_API DS5W_ReturnValue writeHapticsFrames(DS5W::DeviceContext* ptrContext, const short* ptrFrames, unsigned int frameCount, unsigned int sampleRate);
+
+	/// <summary>
+	/// Stop the haptics stream, queued frames are discarded
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue stopHapticsStream(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Get the number of haptics reports written, underruns, overruns and queued frames
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getHapticsStreamStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5HapticsStreamStatistics* ptrStatistics);
+
+	/// <summary>
+	/// Encode one haptics report as the stream sends it, without a device
+	/// Allows comparing the encoding against captured reports
+	/// </summary>
+	/// <param name="sequence">Report sequence number, only the lower 4 bits are used</param>
+	/// <param name="ptrSamples">DS_HAPTICS_FRAMES_PER_REPORT frames of signed 8 bit samples (left, right)</param>
+	/// <param name="ptrReport">Buffer of DS_OUTPUT_REPORT_BT_HAPTICS_SIZE bytes, including the CRC</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue encodeHapticsReport(unsigned char sequence, const signed char* ptrSamples, unsigned char* ptrReport);
+
+	/// <summary>
+	/// Start the output timeline, a thread applying scheduled output changes when they are due
+	/// Changes due in the same transport slot (4ms BT, 1ms USB) are sent with one report, through the output writer if it runs
+	/// While running, setDeviceOutputState and updateDeviceOutputState schedule their change for the next report
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue startOutputTimeline(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Schedule subsystems of an output state to be applied at a host time
+	/// Changes due at the same time are applied in the order they were scheduled
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="hostTime">QueryPerformanceCounter ticks (as DS5ClockSyncInfo), times already passed are applied with the next report and count as due now</param>
+	/// <param name="ptrOutputState">Pointer to output state, copied</param>
+	/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits to apply</param>
+	/// <returns>Result of call, DS5W_E_INSUFFICIENT_BUFFER if DS5W_OUTPUT_TIMELINE_CAPACITY changes are waiting, DS5W_E_CURRENTLY_NOT_SUPPORTED if the timeline is not running</returns>
+	extern "C" DS5W_API DS5W_ReturnValue scheduleOutputState(DS5W::DeviceContext* ptrContext, long long hostTime, DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems);
+
+	/// <summary>
+	/// Drop all scheduled changes not yet applied
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue clearOutputTimeline(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Stop the output timeline, scheduled changes not yet applied are discarded
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue stopOutputTimeline(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Get the number of changes scheduled, merged and dispatched and how late they were applied
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getOutputTimelineStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputTimelineStatistics* ptrStatistics);
+
+	/// <summary>
+	/// Keep a number of input reads posted to the device so a report is always being received
+	/// Reports are taken in the order the device sent them by every function reading input, without flushing the driver queue
+	/// Reads that are not taken keep their reports, so input must be read at least as often as the device sends it
+	/// The pipeline takes precedence over the input mode, whose flush is not applied while reads are posted
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="depth">Reads kept posted, 0 reads one report at a time (default), at most DS5W_INPUT_PIPELINE_MAX_DEPTH</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setInputPipelineDepth(DS5W::DeviceContext* ptrContext, unsigned int depth);
+
+	/// <summary>
+	/// Get the number of reports taken from the input pipeline and how long reads waited for them
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getInputPipelineStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputPipelineStatistics* ptrStatistics);
+
+	/// <summary>
+	/// Choose whether input reads flush the reports Windows queued since the last read
+	/// Flush (default) waits for the next report, LatestOnly returns a report at most one behind the newest without waiting,
+	/// EveryReport keeps every report so drainInputReports() can read all of them
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="mode">Input mode</param>
+	/// <param name="queueLength">Reports Windows queues in EveryReport mode (DS5W_INPUT_QUEUE_MIN - DS5W_INPUT_QUEUE_MAX), 0 for DS5W_INPUT_QUEUE_DEFAULT, ignored by the other modes</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED while an input pipeline depth is set</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setInputMode(DS5W::DeviceContext* ptrContext, DS5W::InputMode mode, unsigned int queueLength);
+
+	/// <summary>
+	/// Read every queued input report in the order received, oldest first
+	/// Blocks thread until the first report is read, further reports are only taken if already queued
+	/// Intended for EveryReport mode, Flush mode returns a single report
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrInputStates">Array to receive the input states</param>
+	/// <param name="maxStates">Length of the array, reports that do not fit stay queued</param>
+	/// <param name="ptrStateCount">Receives the number of states written</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue drainInputReports(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputStates, unsigned int maxStates, unsigned int* ptrStateCount);
+
+	/// <summary>
+	/// Get the number of reports skipped between reads and drained since the input mode was set
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getInputModeStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputModeStatistics* ptrStatistics);
+
+	/// <summary>
+	/// Start a thread reading and decoding every input report of the device, orientation and touch tracking are updated by it
+	/// Functions reading input on the calling thread return DS5W_E_CURRENTLY_NOT_SUPPORTED while it runs, use getLatestInputState()
+	/// getMotionState() and getTouchState() return the copies published with the latest state, input configuration can only be changed while it is stopped
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue startInputReader(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Copy the input state last decoded by the input reader or the input engine the device is registered with
+	/// Never blocks or makes a system call and can be called from any number of threads, it only retries while a new state is being copied in
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrInputState">Pointer to input state</param>
+	/// <param name="ptrVersion">Optional, receives the number of states decoded since the reader started, unchanged means no new report</param>
+	/// <returns>Result of call, DS5W_E_IO_PENDING until the first report was read, DS5W_E_DEVICE_REMOVED once the reader or engine found the device removed, DS5W_E_CURRENTLY_NOT_SUPPORTED if neither reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getLatestInputState(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int* ptrVersion);
+
+	/// <summary>
+	/// Stop the input reader, input is read on the calling thread again
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue stopInputReader(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Make the input reader or input engine queue every decoded report for popReports(), in addition to publishing the latest state
+	/// The queue holds DS5W_REPORT_QUEUE_CAPACITY reports and is emptied by this call
+	/// Must be called while neither reads the device
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="enabled">Queue reports</param>
+	/// <param name="policy">What to do with a report when the queue is full</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED while the input reader or an input engine reads the device</returns>
+	extern "C" DS5W_API DS5W_ReturnValue setReportQueue(DS5W::DeviceContext* ptrContext, bool enabled, DS5W::ReportQueuePolicy policy);
+
+	/// <summary>
+	/// Take the oldest queued reports, oldest first
+	/// Does not block, must only be called from one thread at a time per device
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrReports">Array to receive the reports</param>
+	/// <param name="maxReports">Length of the array, reports that do not fit stay queued</param>
+	/// <param name="ptrReportCount">Receives the number of reports copied, 0 if none are queued</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if the queue is not enabled</returns>
+	extern "C" DS5W_API DS5W_ReturnValue popReports(DS5W::DeviceContext* ptrContext, DS5W::DS5QueuedReport* ptrReports, unsigned int maxReports, unsigned int* ptrReportCount);
+
+	/// <summary>
+	/// Get the number of reports queued, popped and dropped and the most reports queued at once
+	/// </summary>
+	/// <param name="ptrContext">Pointer to context</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getReportQueueStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5ReportQueueStatistics* ptrStatistics);
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+#include <DualSenseWindows/DeviceSpecs.h>
+
+namespace DS5W {
+	/// <summary>
+	/// Called by an engine worker for every report of a registered device, in the order the device sent them
+	/// Calls for one device never overlap, calls for different devices run on any worker at the same time
+	/// No engine lock is held during the call. The callback must not unregister devices, stop the engine or free contexts,
+	/// unregisterInputEngineDevice() and stopInputEngine() return DS5W_E_CURRENTLY_NOT_SUPPORTED when called from it
+	/// A device disconnected from the callback, for example by an output call finding it removed, is handled like a removed device
+	/// </summary>
+	/// <param name="ptrContext">Device the report belongs to</param>
+	/// <param name="ptrInputState">Decoded report, NULL once when the device was removed, the engine drops the device after this call</param>
+	/// <param name="userData">Value given to startInputEngine()</param>
+	typedef void (*DS5InputEngineCallback)(DS5W::DeviceContext* ptrContext, const DS5W::DS5InputState* ptrInputState, void* userData);
+
+	/// <summary>
+	/// Device serviced by an input engine
+	/// </summary>
+	typedef struct _InputEngineDevice {
+		/// <summary>
+		/// Registered device, NULL when the slot is free
+		/// </summary>
+		DeviceContext* context;
+
+		/// <summary>
+		/// Handle the engine reads through, bound to the completion port
+		/// Separate from the context's handle so its overlapped IO does not complete on the port
+		/// </summary>
+		HANDLE handle;
+
+		/// <summary>
+		/// Report buffer and overlapped struct of each posted read
+		/// </summary>
+		unsigned char buffers[DS5W_INPUT_ENGINE_READS][DS_MAX_INPUT_REPORT_SIZE];
+		OVERLAPPED overlapped[DS5W_INPUT_ENGINE_READS];
+		bool posted[DS5W_INPUT_ENGINE_READS];
+
+		/// <summary>
+		/// Oldest posted read, reports are decoded from here on
+		/// </summary>
+		unsigned int next;
+
+		/// <summary>
+		/// Length of one input report of the device
+		/// </summary>
+		unsigned short reportLen;
+
+		/// <summary>
+		/// Reads that completed but were not posted again are not counted
+		/// </summary>
+		unsigned int outstanding;
+
+		/// <summary>
+		/// No reads are posted again (unregistering or device removed)
+		/// A removed device is dropped by the worker handling its last outstanding read
+		/// </summary>
+		bool closing;
+		bool removed;
+
+		/// <summary>
+		/// Callback was told the device was removed
+		/// </summary>
+		bool notified;
+
+		/// <summary>
+		/// A worker is handling reports of the device, others leave newly completed reads to it
+		/// Keeps callbacks of one device in order while they run without the lock
+		/// </summary>
+		bool delivering;
+
+		/// <summary>
+		/// Signalled once unregistering can close the handle, no read outstanding and no callback running
+		/// </summary>
+		HANDLE idle;
+
+		/// <summary>
+		/// Guards every field above except context, handle and idle
+		/// </summary>
+		SRWLOCK lock;
+	} InputEngineDevice;
+
+	/// <summary>
+	/// Counters of an input engine since it was started
+	/// Dispatch time is from a worker taking a completion until the report was decoded and the callback returned
+	/// </summary>
+	typedef struct _DS5InputEngineStatistics {
+		/// <summary>
+		/// Reports decoded
+		/// </summary>
+		unsigned long long reports;
+
+		/// <summary>
+		/// Reads that failed without the device being removed
+		/// </summary>
+		unsigned long long failed;
+
+		/// <summary>
+		/// Devices found removed
+		/// </summary>
+		unsigned long long removed;
+
+		/// <summary>
+		/// Completions taken by the workers
+		/// </summary>
+		unsigned long long completions;
+
+		/// <summary>
+		/// Average and largest dispatch time in microseconds
+		/// </summary>
+		double averageDispatchMicroseconds;
+		double maxDispatchMicroseconds;
+
+		/// <summary>
+		/// Registered devices and worker threads
+		/// </summary>
+		unsigned int devices;
+		unsigned int workers;
+	} DS5InputEngineStatistics;
+
+	/// <summary>
+	/// Reads the input of many devices through one IO completion port serviced by a small pool of worker threads
+	/// </summary>
+	typedef struct _DS5InputEngine {
+		/// <summary>
+		/// Encapsulate data in struct to (at least try) prevent user from modifing the engine
+		/// </summary>
+		struct {
+			/// <summary>
+			/// Completion port, NULL when not started
+			/// </summary>
+			HANDLE port;
+
+			/// <summary>
+			/// Worker threads
+			/// </summary>
+			HANDLE workers[DS5W_INPUT_ENGINE_MAX_WORKERS];
+			DWORD workerIds[DS5W_INPUT_ENGINE_MAX_WORKERS];
+			unsigned int workerCount;
+
+			/// <summary>
+			/// Called for every decoded report
+			/// </summary>
+			DS5InputEngineCallback callback;
+			void* userData;
+
+			/// <summary>
+			/// Guards registering and unregistering devices
+			/// </summary>
+			SRWLOCK lock;
+
+			/// <summary>
+			/// Device slots, the slot index is the completion key
+			/// </summary>
+			InputEngineDevice devices[DS5W_INPUT_ENGINE_MAX_DEVICES];
+
+			/// <summary>
+			/// Registered devices, workers dropping removed devices change it without the lock
+			/// </summary>
+			volatile LONG deviceCount;
+
+			/// <summary>
+			/// QueryPerformanceCounter ticks per second
+			/// </summary>
+			long long hostFrequency;
+
+			/// <summary>
+			/// Counters since the engine was started, only changed through Interlocked functions, dispatch time in host ticks
+			/// </summary>
+			volatile LONG64 reports;
+			volatile LONG64 failed;
+			volatile LONG64 removed;
+			volatile LONG64 completions;
+			volatile LONG64 dispatchTotal;
+			volatile LONG64 dispatchMax;
+		} _internal;
+	} DS5InputEngine;
+
+	/// <summary>
+	/// Create the completion port and worker threads of an engine
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine, must not be running</param>
+	/// <param name="workerCount">Worker threads, 0 for one per processor (at most DS5W_INPUT_ENGINE_MAX_WORKERS)</param>
+	/// <param name="callback">Optional, called for every decoded report</param>
+	/// <param name="userData">Passed to the callback</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue startInputEngine(DS5W::DS5InputEngine* ptrEngine, unsigned int workerCount, DS5W::DS5InputEngineCallback callback, void* userData);
+
+	/// <summary>
+	/// Let the engine read a device, the latest state is available through getLatestInputState() and queued by the report queue if enabled
+	/// Functions reading input on the calling thread return DS5W_E_CURRENTLY_NOT_SUPPORTED while it is registered
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to started engine</param>
+	/// <param name="ptrContext">Connected device not read by an input reader, another engine or an input pipeline</param>
+	/// <returns>Result of call, DS5W_E_INSUFFICIENT_BUFFER if DS5W_INPUT_ENGINE_MAX_DEVICES are registered, DS5W_E_CURRENTLY_NOT_SUPPORTED if input is read elsewhere</returns>
+	extern "C" DS5W_API DS5W_ReturnValue registerInputEngineDevice(DS5W::DS5InputEngine* ptrEngine, DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Stop reading a device, waits until no report of it is being decoded and its callbacks returned
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <param name="ptrContext">Registered device</param>
+	/// <returns>Result of call, DS5W_E_INVALID_ARGS if the engine already dropped the device as removed, DS5W_E_CURRENTLY_NOT_SUPPORTED if called from the engine callback</returns>
+	extern "C" DS5W_API DS5W_ReturnValue unregisterInputEngineDevice(DS5W::DS5InputEngine* ptrEngine, DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Unregister every device and stop the workers
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <returns>Result of call, DS5W_E_CURRENTLY_NOT_SUPPORTED if called from the engine callback</returns>
+	extern "C" DS5W_API DS5W_ReturnValue stopInputEngine(DS5W::DS5InputEngine* ptrEngine);
+
+	/// <summary>
+	/// Get the number of reports the engine decoded and how long dispatching them took
+	/// </summary>
+	/// <param name="ptrEngine">Pointer to engine</param>
+	/// <param name="ptrStatistics">Pointer to statistics</param>
+	/// <returns>Result of call</returns>
+	extern "C" DS5W_API DS5W_ReturnValue getInputEngineStatistics(DS5W::DS5InputEngine* ptrEngine, DS5W::DS5InputEngineStatistics* ptrStatistics);
+}
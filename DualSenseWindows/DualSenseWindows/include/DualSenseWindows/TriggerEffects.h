@@ -0,0 +1,243 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace DS5W {
+	/// <summary>
+	/// Builders packing typed trigger effect parameters into the 11 byte form the device reads
+	/// The trigger travel is split into 10 zones, each zone has its own 3 bit strength
+	/// All builders are constexpr so static effects cost nothing at runtime
+	/// Parameters outside the documented ranges produce off()
+	/// </summary>
+	namespace TriggerEffects {
+		/// <summary>
+		/// Number of zones the trigger travel is split into
+		/// </summary>
+		const unsigned char ZONE_COUNT = 10;
+
+		namespace _internal {
+			// Mode byte, 10 bit zone mask, 30 bits of 3 bit zone values and the trailing parameter bytes
+			constexpr TriggerEffect pack(TriggerEffectType type, unsigned int zones, unsigned int values, unsigned char frequency)
+			{
+				return TriggerEffect{ type, { {
+					(unsigned char)(zones & 0xFF), (unsigned char)((zones >> 8) & 0xFF),
+					(unsigned char)(values & 0xFF), (unsigned char)((values >> 8) & 0xFF), (unsigned char)((values >> 16) & 0xFF), (unsigned char)((values >> 24) & 0xFF),
+					0x00, 0x00, frequency, 0x00
+				} } };
+			}
+
+			// Zone mask of zones with a strength, strengths are 1 - 8
+			constexpr unsigned int zoneMask(const unsigned char (&strengths)[ZONE_COUNT])
+			{
+				unsigned int zones = 0;
+				for (unsigned int i = 0; i < ZONE_COUNT; i++) {
+					if (strengths[i] > 0)
+						zones |= 1u << i;
+				}
+				return zones;
+			}
+
+			// Strength of every zone stored as strength - 1
+			constexpr unsigned int zoneValues(const unsigned char (&strengths)[ZONE_COUNT])
+			{
+				unsigned int values = 0;
+				for (unsigned int i = 0; i < ZONE_COUNT; i++) {
+					if (strengths[i] > 0)
+						values |= (unsigned int)((strengths[i] - 1) & 0x07) << (3 * i);
+				}
+				return values;
+			}
+
+			constexpr bool strengthsValid(const unsigned char (&strengths)[ZONE_COUNT])
+			{
+				for (unsigned int i = 0; i < ZONE_COUNT; i++) {
+					if (strengths[i] > 8)
+						return false;
+				}
+				return true;
+			}
+
+			constexpr bool anyStrength(const unsigned char (&strengths)[ZONE_COUNT])
+			{
+				return zoneMask(strengths) != 0;
+			}
+
+			// Same strength from a zone to the end of travel
+			struct Zones {
+				unsigned char strength[ZONE_COUNT];
+			};
+
+			constexpr Zones fromPosition(unsigned char position, unsigned char strength)
+			{
+				Zones zones = {};
+				for (unsigned int i = position; i < ZONE_COUNT; i++) {
+					zones.strength[i] = strength;
+				}
+				return zones;
+			}
+
+			// Linear ramp between two zones, then constant to the end of travel
+			constexpr Zones slope(unsigned char startPosition, unsigned char endPosition, unsigned char startStrength, unsigned char endStrength)
+			{
+				Zones zones = {};
+				const int span = endPosition - startPosition;
+				for (int i = startPosition; i < ZONE_COUNT; i++) {
+					if (i > endPosition) {
+						zones.strength[i] = endStrength;
+						continue;
+					}
+
+					// Rounded to the nearest strength, halves away from zero
+					const int step = (endStrength - startStrength) * (i - startPosition);
+					zones.strength[i] = (unsigned char)(startStrength + (2 * step + (step < 0 ? -span : span)) / (2 * span));
+				}
+				return zones;
+			}
+		}
+
+		/// <summary>
+		/// No resistance, releases any tension the trigger holds
+		/// </summary>
+		constexpr TriggerEffect off()
+		{
+			return _internal::pack(TriggerEffectType::ReleaseAll, 0, 0, 0);
+		}
+
+		/// <summary>
+		/// Check the parameters of feedback()
+		/// </summary>
+		constexpr bool feedbackValid(unsigned char position, unsigned char strength)
+		{
+			return position < ZONE_COUNT && strength <= 8;
+		}
+
+		/// <summary>
+		/// Constant resistance from a position to the end of travel
+		/// </summary>
+		/// <param name="position">Zone resistance starts at, 0 - 9</param>
+		/// <param name="strength">Resistance, 1 - 8 (0 is off)</param>
+		constexpr TriggerEffect feedback(unsigned char position, unsigned char strength)
+		{
+			return !feedbackValid(position, strength) || strength == 0 ? off() :
+				_internal::pack(TriggerEffectType::Feedback,
+					_internal::zoneMask(_internal::fromPosition(position, strength).strength),
+					_internal::zoneValues(_internal::fromPosition(position, strength).strength), 0);
+		}
+
+		/// <summary>
+		/// Check the parameters of weapon()
+		/// </summary>
+		constexpr bool weaponValid(unsigned char startPosition, unsigned char endPosition, unsigned char strength)
+		{
+			return startPosition >= 2 && startPosition <= 7 && endPosition > startPosition && endPosition <= 8 && strength <= 8;
+		}
+
+		/// <summary>
+		/// Resistance between two positions that gives way with a snap, like a gun trigger
+		/// </summary>
+		/// <param name="startPosition">Zone resistance starts at, 2 - 7</param>
+		/// <param name="endPosition">Zone the trigger snaps at, startPosition + 1 - 8</param>
+		/// <param name="strength">Resistance, 1 - 8 (0 is off)</param>
+		constexpr TriggerEffect weapon(unsigned char startPosition, unsigned char endPosition, unsigned char strength)
+		{
+			return !weaponValid(startPosition, endPosition, strength) || strength == 0 ? off() :
+				_internal::pack(TriggerEffectType::Weapon, (1u << startPosition) | (1u << endPosition), (unsigned int)(strength - 1), 0);
+		}
+
+		/// <summary>
+		/// Check the parameters of vibration()
+		/// </summary>
+		constexpr bool vibrationValid(unsigned char position, unsigned char amplitude)
+		{
+			return position < ZONE_COUNT && amplitude <= 8;
+		}
+
+		/// <summary>
+		/// Vibration from a position to the end of travel
+		/// </summary>
+		/// <param name="position">Zone vibration starts at, 0 - 9</param>
+		/// <param name="amplitude">Strength of vibration, 1 - 8 (0 is off)</param>
+		/// <param name="frequency">Vibrations per second, 1 - 255 (0 is off)</param>
+		constexpr TriggerEffect vibration(unsigned char position, unsigned char amplitude, unsigned char frequency)
+		{
+			return !vibrationValid(position, amplitude) || amplitude == 0 || frequency == 0 ? off() :
+				_internal::pack(TriggerEffectType::EffectEx,
+					_internal::zoneMask(_internal::fromPosition(position, amplitude).strength),
+					_internal::zoneValues(_internal::fromPosition(position, amplitude).strength), frequency);
+		}
+
+		/// <summary>
+		/// Check the parameters of multiplePositionFeedback()
+		/// </summary>
+		constexpr bool multiplePositionFeedbackValid(const unsigned char (&strengths)[ZONE_COUNT])
+		{
+			return _internal::strengthsValid(strengths);
+		}
+
+		/// <summary>
+		/// Resistance set per zone
+		/// </summary>
+		/// <param name="strengths">Resistance of each zone, 1 - 8 (0 has none)</param>
+		constexpr TriggerEffect multiplePositionFeedback(const unsigned char (&strengths)[ZONE_COUNT])
+		{
+			return !multiplePositionFeedbackValid(strengths) || !_internal::anyStrength(strengths) ? off() :
+				_internal::pack(TriggerEffectType::Feedback, _internal::zoneMask(strengths), _internal::zoneValues(strengths), 0);
+		}
+
+		/// <summary>
+		/// Check the parameters of slopeFeedback()
+		/// </summary>
+		constexpr bool slopeFeedbackValid(unsigned char startPosition, unsigned char endPosition, unsigned char startStrength, unsigned char endStrength)
+		{
+			return startPosition < ZONE_COUNT - 1 && endPosition > startPosition && endPosition < ZONE_COUNT &&
+				startStrength >= 1 && startStrength <= 8 && endStrength >= 1 && endStrength <= 8;
+		}
+
+		/// <summary>
+		/// Resistance ramping between two positions, then held to the end of travel
+		/// </summary>
+		/// <param name="startPosition">Zone the ramp starts at, 0 - 8</param>
+		/// <param name="endPosition">Zone the ramp ends at, startPosition + 1 - 9</param>
+		/// <param name="startStrength">Resistance at the start, 1 - 8</param>
+		/// <param name="endStrength">Resistance at the end, 1 - 8</param>
+		constexpr TriggerEffect slopeFeedback(unsigned char startPosition, unsigned char endPosition, unsigned char startStrength, unsigned char endStrength)
+		{
+			return !slopeFeedbackValid(startPosition, endPosition, startStrength, endStrength) ? off() :
+				multiplePositionFeedback(_internal::slope(startPosition, endPosition, startStrength, endStrength).strength);
+		}
+
+		/// <summary>
+		/// Check the parameters of multiplePositionVibration()
+		/// </summary>
+		constexpr bool multiplePositionVibrationValid(const unsigned char (&amplitudes)[ZONE_COUNT])
+		{
+			return _internal::strengthsValid(amplitudes);
+		}
+
+		/// <summary>
+		/// Vibration with the amplitude set per zone
+		/// </summary>
+		/// <param name="frequency">Vibrations per second, 1 - 255 (0 is off)</param>
+		/// <param name="amplitudes">Strength of vibration in each zone, 1 - 8 (0 has none)</param>
+		constexpr TriggerEffect multiplePositionVibration(unsigned char frequency, const unsigned char (&amplitudes)[ZONE_COUNT])
+		{
+			return !multiplePositionVibrationValid(amplitudes) || frequency == 0 || !_internal::anyStrength(amplitudes) ? off() :
+				_internal::pack(TriggerEffectType::EffectEx, _internal::zoneMask(amplitudes), _internal::zoneValues(amplitudes), frequency);
+		}
+	}
+
+	/// <summary>
+	/// Pack a trigger effect description, results are cached so switching between generated effects costs one lookup
+	/// </summary>
+	/// <param name="ptrDescription">Effect to pack</param>
+	/// <param name="ptrEffect">Packed effect, ready for DS5OutputState</param>
+	/// <returns>Result of call, DS5W_E_INVALID_ARGS for parameters out of range</returns>
+	extern "C" DS5W_API DS5W_ReturnValue compileTriggerEffect(const DS5W::TriggerEffectDescription* ptrDescription, DS5W::TriggerEffect* ptrEffect);
+}
@@ -0,0 +1,230 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include <DualSenseWindows/Animation.h>
+#include <DualSenseWindows/Helpers.h>
+
+#include <math.h>
+#include <string.h>
+
+namespace {
+	const int CHANNEL_COUNT = (int)DS5W::AnimationChannel::Count;
+
+	// Output subsystem each channel writes to
+	const unsigned int CHANNEL_SUBSYSTEMS[CHANNEL_COUNT] = {
+		DS5W_OSTATE_SUBSYSTEM_LIGHTBAR,
+		DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS,
+		DS5W_OSTATE_SUBSYSTEM_RUMBLE,
+		DS5W_OSTATE_SUBSYSTEM_RUMBLE,
+		DS5W_OSTATE_SUBSYSTEM_LEFT_TRIGGER,
+		DS5W_OSTATE_SUBSYSTEM_RIGHT_TRIGGER,
+	};
+
+	float clampUnit(float value)
+	{
+		return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+	}
+
+	// Keyframe the value comes from and the share of the next keyframe mixed in
+	struct Sample {
+		const DS5W::AnimationKeyframe* from;
+		const DS5W::AnimationKeyframe* to;
+		float blend;
+	};
+
+	Sample sampleTrack(DS5W::AnimationTrackState& track, double engineTime)
+	{
+		const DS5W::AnimationKeyframe* keyframes = track.keyframes;
+		const unsigned int last = track.keyframeCount - 1;
+		double time = engineTime - track.startTime;
+
+		// Past the end a looping track wraps, others hold the last keyframe and finish
+		const double duration = keyframes[last].time;
+		if (time >= duration) {
+			if (!track.loop || duration <= 0.0) {
+				track.active = false;
+				track.cursor = last;
+				Sample sample = { &keyframes[last], &keyframes[last], 0.0f };
+				return sample;
+			}
+			time = fmod(time, duration);
+		}
+
+		// Wrapped around, search again from the start
+		if (time < keyframes[track.cursor].time)
+			track.cursor = 0;
+
+		while (track.cursor < last && keyframes[track.cursor + 1].time <= time)
+			track.cursor++;
+
+		const DS5W::AnimationKeyframe& from = keyframes[track.cursor];
+		Sample sample = { &from, &from, 0.0f };
+		if (track.cursor == last || time < from.time || from.interpolation == DS5W::AnimationInterpolation::Step)
+			return sample;
+
+		const DS5W::AnimationKeyframe& to = keyframes[track.cursor + 1];
+		float blend = (float)((time - from.time) / (double)(to.time - from.time));
+		if (from.interpolation == DS5W::AnimationInterpolation::Smooth)
+			blend = blend * blend * (3.0f - 2.0f * blend);
+
+		sample.to = &to;
+		sample.blend = blend;
+		return sample;
+	}
+
+	float mix(const Sample& sample, int index)
+	{
+		return sample.from->value[index] + (sample.to->value[index] - sample.from->value[index]) * sample.blend;
+	}
+
+	// Write a sampled channel into the output state, returns whether the field changed
+	bool apply(DS5W::AnimationChannel channel, const Sample& sample, DS5W::DS5OutputState* ptrOutputState)
+	{
+		switch (channel) {
+			case DS5W::AnimationChannel::Lightbar: {
+				const DS5W::Color color = DS5W::color_R32G32B32A32_FLOAT(
+					clampUnit(mix(sample, 0)), clampUnit(mix(sample, 1)), clampUnit(mix(sample, 2)), clampUnit(mix(sample, 3)));
+				if (color.r == ptrOutputState->lightbar.r && color.g == ptrOutputState->lightbar.g && color.b == ptrOutputState->lightbar.b)
+					return false;
+				ptrOutputState->lightbar = color;
+				return true;
+			}
+
+			case DS5W::AnimationChannel::PlayerLeds: {
+				const DS5W::PlayerLeds& leds = sample.from->playerLeds;
+				if (leds.bitmask == ptrOutputState->playerLeds.bitmask && leds.playerLedFade == ptrOutputState->playerLeds.playerLedFade &&
+					leds.brightness == ptrOutputState->playerLeds.brightness)
+					return false;
+				ptrOutputState->playerLeds = leds;
+				return true;
+			}
+
+			case DS5W::AnimationChannel::LeftRumble:
+			case DS5W::AnimationChannel::RightRumble: {
+				unsigned char* rumble = channel == DS5W::AnimationChannel::LeftRumble ? &ptrOutputState->leftRumble : &ptrOutputState->rightRumble;
+				const unsigned char value = (unsigned char)lrintf(clampUnit(mix(sample, 0)) * 255.0f);
+				if (value == *rumble)
+					return false;
+				*rumble = value;
+				return true;
+			}
+
+			case DS5W::AnimationChannel::LeftTrigger:
+			case DS5W::AnimationChannel::RightTrigger: {
+				DS5W::TriggerEffect* effect = channel == DS5W::AnimationChannel::LeftTrigger ? &ptrOutputState->leftTriggerEffect : &ptrOutputState->rightTriggerEffect;
+				if (memcmp(effect, &sample.from->triggerEffect, sizeof(DS5W::TriggerEffect)) == 0)
+					return false;
+				*effect = sample.from->triggerEffect;
+				return true;
+			}
+
+			default:
+				return false;
+		}
+	}
+}
+
+DS5W_API DS5W_ReturnValue DS5W::initAnimationEngine(DS5W::DS5AnimationEngine* ptrEngine)
+{
+	// Check pointer
+	if (!ptrEngine) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	memset(&ptrEngine->_internal, 0, sizeof(ptrEngine->_internal));
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::bindAnimationOutput(DS5W::DS5AnimationEngine* ptrEngine, unsigned int slot, DS5W::DS5OutputState* ptrOutputState)
+{
+	// Check pointer
+	if (!ptrEngine || slot >= DS5W_ANIMATION_MAX_DEVICES) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	ptrEngine->_internal.outputs[slot] = ptrOutputState;
+	for (int channel = 0; channel < CHANNEL_COUNT; channel++) {
+		ptrEngine->_internal.tracks[channel][slot].active = false;
+	}
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::playAnimation(DS5W::DS5AnimationEngine* ptrEngine, unsigned int slot, const DS5W::DS5AnimationTrack* ptrTrack)
+{
+	// Check pointer
+	if (!ptrEngine || !ptrTrack || slot >= DS5W_ANIMATION_MAX_DEVICES || !ptrEngine->_internal.outputs[slot]) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check track
+	const int channel = (int)ptrTrack->channel;
+	if (channel >= CHANNEL_COUNT || !ptrTrack->keyframes || ptrTrack->keyframeCount == 0 || !(ptrTrack->keyframes[0].time >= 0.0f)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	for (unsigned int i = 1; i < ptrTrack->keyframeCount; i++) {
+		if (!(ptrTrack->keyframes[i].time >= ptrTrack->keyframes[i - 1].time)) {
+			return DS5W_E_INVALID_ARGS;
+		}
+	}
+
+	DS5W::AnimationTrackState& track = ptrEngine->_internal.tracks[channel][slot];
+	track.keyframes = ptrTrack->keyframes;
+	track.keyframeCount = ptrTrack->keyframeCount;
+	track.cursor = 0;
+	track.startTime = ptrEngine->_internal.time;
+	track.loop = ptrTrack->loop;
+	track.active = true;
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::stopAnimation(DS5W::DS5AnimationEngine* ptrEngine, unsigned int slot, DS5W::AnimationChannel channel)
+{
+	// Check pointer
+	if (!ptrEngine || slot >= DS5W_ANIMATION_MAX_DEVICES || (int)channel >= CHANNEL_COUNT) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	ptrEngine->_internal.tracks[(int)channel][slot].active = false;
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::tickAnimations(DS5W::DS5AnimationEngine* ptrEngine, float deltaSeconds, unsigned int* ptrDirtyMasks)
+{
+	// Check pointer
+	if (!ptrEngine) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	unsigned int dirty[DS5W_ANIMATION_MAX_DEVICES] = {};
+	ptrEngine->_internal.time += deltaSeconds;
+	const double time = ptrEngine->_internal.time;
+
+	// One channel of every device at a time, tracks of a channel are contiguous
+	for (int channel = 0; channel < CHANNEL_COUNT; channel++) {
+		DS5W::AnimationTrackState* tracks = ptrEngine->_internal.tracks[channel];
+
+		for (int slot = 0; slot < DS5W_ANIMATION_MAX_DEVICES; slot++) {
+			if (!tracks[slot].active)
+				continue;
+
+			const Sample sample = sampleTrack(tracks[slot], time);
+			if (apply((DS5W::AnimationChannel)channel, sample, ptrEngine->_internal.outputs[slot]))
+				dirty[slot] |= CHANNEL_SUBSYSTEMS[channel];
+		}
+	}
+
+	if (ptrDirtyMasks) {
+		memcpy(ptrDirtyMasks, dirty, sizeof(dirty));
+	}
+
+	return DS5W_OK;
+}
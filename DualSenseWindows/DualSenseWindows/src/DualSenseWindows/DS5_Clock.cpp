@@ -0,0 +1,134 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Clock.h"
+#include "DS5_Input.h"
+
+#include <DualSenseWindows/DeviceSpecs.h>
+
+namespace {
+	// Receive times are the report time plus a non-negative transport delay, so the model follows their lower envelope:
+	// early reports pull the estimate down quickly, late reports only nudge it up to absorb drift
+	const double EARLY_GAIN = 0.5;
+	const double LATE_GAIN = 0.003;
+
+	// Share of each offset correction fed back into the rate, turns the offset loop into a drift estimator
+	const double RATE_GAIN = 0.001;
+
+	// Crystals are well within this, anything further is noise from a stall
+	const double MAX_DRIFT = 500e-6;
+
+	// Smoothing of the latency average
+	const double LATENCY_GAIN = 0.01;
+
+	double nominalRate(const DS5W::ClockSyncState& clock)
+	{
+		return (double)clock.hostFrequency / DS_SENSOR_TIMESTAMP_PER_SECOND;
+	}
+}
+
+void __DS5W::Clock::reset(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::ClockSyncState& clock = ptrContext->_internal.clockSync;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	clock.hostFrequency = frequency.QuadPart;
+	clock.rate = nominalRate(clock);
+	clock.hostAnchor = 0.0;
+	clock.latency = 0.0;
+	clock.deviceTime = 0;
+	clock.lastTimestamp = 0;
+	clock.lastReceiveTime = 0;
+	clock.sampleCount = 0;
+	clock.anchorCount = 0;
+	clock.anchored = false;
+	clock.valid = false;
+}
+
+void __DS5W::Clock::reanchor(DS5W::DeviceContext* ptrContext)
+{
+	ptrContext->_internal.clockSync.anchored = false;
+}
+
+void __DS5W::Clock::onInputReport(DS5W::DeviceContext* ptrContext, long long now)
+{
+	DS5W::ClockSyncState& clock = ptrContext->_internal.clockSync;
+	const unsigned int timestamp = *(unsigned int*)&__DS5W::Input::heldReportBody(ptrContext)[0x1B];
+
+	// Same report seen again
+	if (clock.anchored && timestamp == clock.lastTimestamp)
+		return;
+
+	if (!clock.anchored) {
+		// Device time continues from where it was, bridged with host time as the device clock may have restarted
+		if (clock.valid) {
+			const double elapsed = (double)(now - clock.lastReceiveTime) / clock.rate;
+			clock.deviceTime += elapsed > 1.0 ? (unsigned long long)elapsed : 1;
+		}
+		else {
+			clock.deviceTime = timestamp;
+		}
+
+		clock.hostAnchor = (double)now;
+		clock.lastTimestamp = timestamp;
+		clock.lastReceiveTime = now;
+		clock.sampleCount++;
+		clock.anchorCount++;
+		clock.anchored = true;
+		clock.valid = true;
+		return;
+	}
+
+	// Modular difference handles wraparound of the 32 bit counter
+	const unsigned int deltaDevice = timestamp - clock.lastTimestamp;
+	const double predicted = clock.hostAnchor + (double)deltaDevice * clock.rate;
+	const double error = (double)now - predicted;
+	const double correction = error * (error < 0.0 ? EARLY_GAIN : LATE_GAIN);
+
+	clock.hostAnchor = predicted + correction;
+	clock.rate += RATE_GAIN * correction / (double)deltaDevice;
+
+	const double nominal = nominalRate(clock);
+	if (clock.rate > nominal * (1.0 + MAX_DRIFT))
+		clock.rate = nominal * (1.0 + MAX_DRIFT);
+	else if (clock.rate < nominal * (1.0 - MAX_DRIFT))
+		clock.rate = nominal * (1.0 - MAX_DRIFT);
+
+	clock.latency += ((double)now - clock.hostAnchor - clock.latency) * LATENCY_GAIN;
+	clock.deviceTime += deltaDevice;
+	clock.lastTimestamp = timestamp;
+	clock.lastReceiveTime = now;
+	clock.sampleCount++;
+}
+
+long long __DS5W::Clock::deviceToHost(const DS5W::DeviceContext* ptrContext, unsigned int deviceTimestamp)
+{
+	const DS5W::ClockSyncState& clock = ptrContext->_internal.clockSync;
+	if (!clock.valid)
+		return 0;
+
+	// Signed so timestamps slightly before the last report map backwards
+	const int deltaDevice = (int)(deviceTimestamp - clock.lastTimestamp);
+	return (long long)(clock.hostAnchor + (double)deltaDevice * clock.rate);
+}
+
+void __DS5W::Clock::getInfo(const DS5W::DeviceContext* ptrContext, DS5W::DS5ClockSyncInfo* ptrInfo)
+{
+	const DS5W::ClockSyncState& clock = ptrContext->_internal.clockSync;
+
+	ptrInfo->hostFrequency = clock.hostFrequency;
+	ptrInfo->hostTime = (long long)clock.hostAnchor;
+	ptrInfo->deviceTime = clock.deviceTime;
+
+	// Host ticks per device tick go down when the device runs fast
+	ptrInfo->driftPpm = (nominalRate(clock) / clock.rate - 1.0) * 1e6;
+	ptrInfo->latencyMicroseconds = clock.latency * 1e6 / (double)clock.hostFrequency;
+	ptrInfo->sampleCount = clock.sampleCount;
+	ptrInfo->anchorCount = clock.anchorCount;
+}
@@ -0,0 +1,43 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace Clock {
+		/// <summary>
+		/// Forget all clock history, used when a context is created
+		/// </summary>
+		void reset(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Keep the drift estimate and unwrapped device time but take the offset from the next report
+		/// Used after reconnecting as the device clock may have restarted
+		/// </summary>
+		void reanchor(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Feed the held input report and the host time it was received at into the clock model
+		/// Call as soon as a read completes, reports already seen are ignored
+		/// </summary>
+		/// <param name="hostTime">QueryPerformanceCounter ticks when the read completed</param>
+		void onInputReport(DS5W::DeviceContext* ptrContext, long long hostTime);
+
+		/// <summary>
+		/// Host time (QueryPerformanceCounter ticks) of a device timestamp near the last report
+		/// </summary>
+		long long deviceToHost(const DS5W::DeviceContext* ptrContext, unsigned int deviceTimestamp);
+
+		/// <summary>
+		/// Copy the state of the clock model
+		/// </summary>
+		void getInfo(const DS5W::DeviceContext* ptrContext, DS5W::DS5ClockSyncInfo* ptrInfo);
+	}
+}
@@ -0,0 +1,195 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Conditioning.h"
+
+#include <math.h>
+
+namespace {
+	bool responseValid(const DS5W::AnalogResponse& response)
+	{
+		// Comparisons written so NaN fails them
+		if (!(response.deadzone >= 0.0f) || !(response.saturation > response.deadzone))
+			return false;
+
+		if (!(response.antiDeadzone >= 0.0f) || !(response.antiDeadzone < 1.0f))
+			return false;
+
+		if (response.curvePointCount == 0)
+			return response.exponent > 0.0f;
+
+		return response.curvePoints && response.curvePointCount >= 2;
+	}
+
+	float curve(const DS5W::AnalogResponse& response, float t)
+	{
+		if (response.curvePointCount == 0)
+			return powf(t, response.exponent);
+
+		// Piecewise linear through evenly spaced points
+		const float position = t * (float)(response.curvePointCount - 1);
+		const unsigned int index = (unsigned int)position;
+		if (index >= response.curvePointCount - 1)
+			return response.curvePoints[response.curvePointCount - 1];
+
+		const float fraction = position - (float)index;
+		return response.curvePoints[index] + (response.curvePoints[index + 1] - response.curvePoints[index]) * fraction;
+	}
+
+	// Output for an input magnitude in [0, 1] or above
+	float respond(const DS5W::AnalogResponse& response, float input)
+	{
+		if (input <= response.deadzone)
+			return 0.0f;
+
+		float t = (input - response.deadzone) / (response.saturation - response.deadzone);
+		if (t > 1.0f)
+			t = 1.0f;
+
+		return response.antiDeadzone + (1.0f - response.antiDeadzone) * curve(response, t);
+	}
+
+	float clampUnit(float value)
+	{
+		return value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+	}
+
+	// Same centering as the unconditioned decoders
+	float normalizeAxis(int raw, bool yAxis)
+	{
+		return clampUnit((float)(yAxis ? 127 - raw : raw - 128) * (1.0f / 127.0f));
+	}
+
+	void compileStick(const DS5W::StickConditioning& conditioning, int stick, DS5W::AnalogConditioningTables* ptrTables)
+	{
+		const bool radial = conditioning.shape == DS5W::StickDeadzoneShape::Radial;
+		ptrTables->radial[stick] = radial;
+
+		for (int axis = 0; axis < 2; axis++) {
+			float* table = ptrTables->stickAxis[stick * 2 + axis];
+			char* tableI = ptrTables->stickAxisI[stick * 2 + axis];
+
+			for (int raw = 0; raw < 256; raw++) {
+				const float value = normalizeAxis(raw, axis == 1);
+				if (radial) {
+					table[raw] = value;
+				}
+				else {
+					table[raw] = value < 0.0f ? -respond(conditioning.response, -value) : respond(conditioning.response, value);
+				}
+				tableI[raw] = (char)lrintf(table[raw] * 127.0f);
+			}
+		}
+
+		// Gain at the center of each magnitude bin
+		for (int i = 0; i < 256; i++) {
+			const float magnitude = ((float)i + 0.5f) * (__DS5W::Conditioning::STICK_GAIN_RANGE / 256.0f);
+			ptrTables->stickGain[stick][i] = respond(conditioning.response, magnitude) / magnitude;
+		}
+	}
+
+	void compileTrigger(const DS5W::TriggerConditioning& conditioning, int trigger, DS5W::AnalogConditioningTables* ptrTables)
+	{
+		for (int raw = 0; raw < 256; raw++) {
+			const float value = respond(conditioning.response, (float)raw * (1.0f / 255.0f));
+			ptrTables->trigger[trigger][raw] = value;
+			ptrTables->triggerI[trigger][raw] = (unsigned char)lrintf(value * 255.0f);
+		}
+
+		ptrTables->pressThreshold[trigger] = conditioning.pressThreshold;
+		ptrTables->releaseThreshold[trigger] = conditioning.releaseThreshold;
+		ptrTables->triggerPressed[trigger] = false;
+	}
+
+	// Scale both axes of a radial stick by the gain of its magnitude
+	void radialStick(const DS5W::AnalogConditioningTables& tables, int stick, float* ptrX, float* ptrY)
+	{
+		const float magnitude = sqrtf(*ptrX * *ptrX + *ptrY * *ptrY);
+		int index = (int)(magnitude * (256.0f / __DS5W::Conditioning::STICK_GAIN_RANGE));
+		if (index > 255)
+			index = 255;
+
+		const float gain = tables.stickGain[stick][index];
+		*ptrX = clampUnit(*ptrX * gain);
+		*ptrY = clampUnit(*ptrY * gain);
+	}
+}
+
+bool __DS5W::Conditioning::isValid(const DS5W::DS5AnalogConditioning* ptrConditioning)
+{
+	return responseValid(ptrConditioning->leftStick.response) &&
+		responseValid(ptrConditioning->rightStick.response) &&
+		responseValid(ptrConditioning->leftTrigger.response) &&
+		responseValid(ptrConditioning->rightTrigger.response) &&
+		ptrConditioning->leftTrigger.releaseThreshold <= ptrConditioning->leftTrigger.pressThreshold &&
+		ptrConditioning->rightTrigger.releaseThreshold <= ptrConditioning->rightTrigger.pressThreshold;
+}
+
+void __DS5W::Conditioning::compile(const DS5W::DS5AnalogConditioning* ptrConditioning, DS5W::AnalogConditioningTables* ptrTables)
+{
+	compileStick(ptrConditioning->leftStick, 0, ptrTables);
+	compileStick(ptrConditioning->rightStick, 1, ptrTables);
+	compileTrigger(ptrConditioning->leftTrigger, 0, ptrTables);
+	compileTrigger(ptrConditioning->rightTrigger, 1, ptrTables);
+	ptrTables->enabled = true;
+}
+
+void __DS5W::Conditioning::sticks(const DS5W::AnalogConditioningTables& tables, const unsigned char* hidInBuffer, DS5W::AnalogStick* ptrLeft, DS5W::AnalogStick* ptrRight)
+{
+	DS5W::AnalogStick* sticks[2] = { ptrLeft, ptrRight };
+
+	for (int stick = 0; stick < 2; stick++) {
+		const unsigned char rawX = hidInBuffer[stick * 2];
+		const unsigned char rawY = hidInBuffer[stick * 2 + 1];
+
+		if (!tables.radial[stick]) {
+			sticks[stick]->x = tables.stickAxisI[stick * 2][rawX];
+			sticks[stick]->y = tables.stickAxisI[stick * 2 + 1][rawY];
+			continue;
+		}
+
+		float x = tables.stickAxis[stick * 2][rawX];
+		float y = tables.stickAxis[stick * 2 + 1][rawY];
+		radialStick(tables, stick, &x, &y);
+		sticks[stick]->x = (char)lrintf(x * 127.0f);
+		sticks[stick]->y = (char)lrintf(y * 127.0f);
+	}
+}
+
+void __DS5W::Conditioning::sticksF(const DS5W::AnalogConditioningTables& tables, const unsigned char* hidInBuffer, float* ptrAxes)
+{
+	for (int axis = 0; axis < 4; axis++) {
+		ptrAxes[axis] = tables.stickAxis[axis][hidInBuffer[axis]];
+	}
+
+	for (int stick = 0; stick < 2; stick++) {
+		if (tables.radial[stick]) {
+			radialStick(tables, stick, &ptrAxes[stick * 2], &ptrAxes[stick * 2 + 1]);
+		}
+	}
+}
+
+unsigned int __DS5W::Conditioning::triggerButtons(DS5W::AnalogConditioningTables& tables, const unsigned char* hidInBuffer, unsigned int buttonMap)
+{
+	const unsigned int buttons[2] = { DS5W_ISTATE_BTN_TRIGGER_LEFT, DS5W_ISTATE_BTN_TRIGGER_RIGHT };
+	buttonMap &= ~(buttons[0] | buttons[1]);
+
+	for (int trigger = 0; trigger < 2; trigger++) {
+		const unsigned char raw = hidInBuffer[0x04 + trigger];
+
+		// Hysteresis, released only once the trigger drops below the lower threshold
+		if (tables.triggerPressed[trigger])
+			tables.triggerPressed[trigger] = raw >= tables.releaseThreshold[trigger];
+		else
+			tables.triggerPressed[trigger] = raw >= tables.pressThreshold[trigger];
+
+		if (tables.triggerPressed[trigger])
+			buttonMap |= buttons[trigger];
+	}
+
+	return buttonMap;
+}
@@ -0,0 +1,46 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace Conditioning {
+		/// <summary>
+		/// Largest stick magnitude covered by the radial gain tables (corner of the square stick range)
+		/// </summary>
+		const float STICK_GAIN_RANGE = 1.4143f;
+
+		/// <summary>
+		/// Check a configuration can be compiled
+		/// </summary>
+		bool isValid(const DS5W::DS5AnalogConditioning* ptrConditioning);
+
+		/// <summary>
+		/// Build the lookup tables of a valid configuration and enable them
+		/// </summary>
+		void compile(const DS5W::DS5AnalogConditioning* ptrConditioning, DS5W::AnalogConditioningTables* ptrTables);
+
+		/// <summary>
+		/// Conditioned sticks in the integer input state range
+		/// </summary>
+		void sticks(const DS5W::AnalogConditioningTables& tables, const unsigned char* hidInBuffer, DS5W::AnalogStick* ptrLeft, DS5W::AnalogStick* ptrRight);
+
+		/// <summary>
+		/// Conditioned sticks in [-1, 1] (left x, left y, right x, right y)
+		/// </summary>
+		void sticksF(const DS5W::AnalogConditioningTables& tables, const unsigned char* hidInBuffer, float* ptrAxes);
+
+		/// <summary>
+		/// Replace the trigger buttons of a button map with the thresholded triggers
+		/// </summary>
+		/// <returns>New button map</returns>
+		unsigned int triggerButtons(DS5W::AnalogConditioningTables& tables, const unsigned char* hidInBuffer, unsigned int buttonMap);
+	}
+}
@@ -0,0 +1,47 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include <DualSenseWindows/DS5_Cpu.h>
+
+#include <intrin.h>
+
+namespace {
+	// Feature bits read once from CPUID
+	struct CpuFeatures {
+		bool ssse3;
+		bool pclmul;
+
+		CpuFeatures() : ssse3(false), pclmul(false)
+		{
+			int info[4];
+
+			__cpuid(info, 0);
+			if (info[0] < 1)
+				return;
+
+			__cpuid(info, 1);
+			pclmul = (info[2] & (1 << 1)) != 0;
+			ssse3 = (info[2] & (1 << 9)) != 0;
+		}
+	};
+
+	const CpuFeatures& features()
+	{
+		static const CpuFeatures cpu;
+		return cpu;
+	}
+}
+
+bool __DS5W::Cpu::hasSSSE3()
+{
+	return features().ssse3;
+}
+
+bool __DS5W::Cpu::hasPCLMUL()
+{
+	return features().pclmul;
+}
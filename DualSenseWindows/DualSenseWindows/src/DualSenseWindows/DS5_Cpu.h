@@ -0,0 +1,21 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+namespace __DS5W {
+	namespace Cpu {
+		/// <summary>
+		/// Returns true if the CPU supports SSSE3 (pshufb)
+		/// </summary>
+		bool hasSSSE3();
+
+		/// <summary>
+		/// Returns true if the CPU supports carry-less multiplication (PCLMULQDQ)
+		/// </summary>
+		bool hasPCLMUL();
+	}
+}
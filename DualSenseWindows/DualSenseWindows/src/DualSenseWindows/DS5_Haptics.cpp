@@ -0,0 +1,367 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Haptics.h"
+#include "DS5_Internal.h"
+
+#include <DualSenseWindows/DS_CRC32.h>
+
+#include <Windows.h>
+#include <string.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace {
+	// Packets of the report, the content of the control packet is copied from captures
+	const unsigned char PACKET_LENGTH_PRESENT = 0x80;
+	const unsigned char PACKET_CONTROL = 0x11;
+	const unsigned char PACKET_CONTROL_LENGTH = 7;
+	const unsigned char PACKET_SAMPLES = 0x12;
+	const unsigned char PACKET_SAMPLES_LENGTH = DS_HAPTICS_FRAMES_PER_REPORT * 2;
+
+	const unsigned int RING_MASK = DS5W_HAPTICS_RING_FRAMES - 1;
+
+	// Interlocked read, the counters are shared between the application and the stream thread
+	LONG load(volatile LONG* value)
+	{
+		return InterlockedCompareExchange(value, 0, 0);
+	}
+
+	LONG64 load64(volatile LONG64* value)
+	{
+		return InterlockedExchangeAdd64(value, 0);
+	}
+
+	DS5W_ReturnValue writeReport(DS5W::DeviceContext* ptrContext)
+	{
+		DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+		ResetEvent(stream.olWrite.hEvent);
+		if (WriteFile(ptrContext->_internal.deviceHandle, stream.report, DS_OUTPUT_REPORT_BT_HAPTICS_SIZE, NULL, &stream.olWrite))
+			return DS5W_OK;
+
+		const DWORD err = GetLastError();
+		if (err != ERROR_IO_PENDING)
+			return DS5W::convertSystemErrorCode(err);
+
+		return DS5W::awaitIORequest(ptrContext, &stream.olWrite, IO_TIMEOUT_MILLISECONDS);
+	}
+
+	// Send the next report if there are frames
+	// Returns false once the device is gone
+	bool sendNext(DS5W::DeviceContext* ptrContext)
+	{
+		DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+		// Nothing to play, the actuators stay quiet without reports
+		signed char samples[DS_HAPTICS_FRAMES_PER_REPORT][2];
+		if (!__DS5W::Haptics::takeReportFrames(ptrContext, &samples[0][0]))
+			return true;
+
+		__DS5W::Haptics::encodeReport(stream.report, stream.sequence++, &samples[0][0]);
+		DS5W_RV err = writeReport(ptrContext);
+
+		if (DS5W_SUCCESS(err))
+			InterlockedIncrement64(&stream.reportsWritten);
+		else
+			InterlockedIncrement64(&stream.failed);
+
+		return err != DS5W_E_DEVICE_REMOVED;
+	}
+
+	DWORD WINAPI streamThread(LPVOID param)
+	{
+		DS5W::DeviceContext* ptrContext = (DS5W::DeviceContext*)param;
+		DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+		const HANDLE handles[2] = { stream.stopEvent, stream.timer };
+		bool removed = false;
+
+		LARGE_INTEGER frequency, start, now;
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&start);
+		const long long reportTicks = frequency.QuadPart * DS_HAPTICS_FRAMES_PER_REPORT / DS_HAPTICS_SAMPLE_RATE;
+		unsigned long long reports = 0;
+
+		for (;;) {
+			if (!sendNext(ptrContext)) {
+				removed = true;
+				break;
+			}
+
+			// Due times are counted from the start so timer rounding does not add up
+			reports++;
+			long long due = start.QuadPart + (long long)(reports * DS_HAPTICS_FRAMES_PER_REPORT * frequency.QuadPart / DS_HAPTICS_SAMPLE_RATE);
+			QueryPerformanceCounter(&now);
+
+			// Fell behind by more than a report, continue from now instead of catching up in a burst
+			if (now.QuadPart - due > reportTicks) {
+				start = now;
+				reports = 0;
+				due = now.QuadPart;
+			}
+
+			// Relative due time in 100 nanosecond units
+			const long long wait = due > now.QuadPart ? due - now.QuadPart : 0;
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -(LONGLONG)(wait * 10000000 / frequency.QuadPart);
+
+			if (!SetWaitableTimer(stream.timer, &dueTime, 0, NULL, NULL, FALSE))
+				break;
+
+			if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0 + 1)
+				break;
+		}
+
+		// Disconnecting is left to the threads using the context
+		InterlockedExchange(&stream.deviceRemoved, removed ? TRUE : FALSE);
+		InterlockedExchange(&stream.running, FALSE);
+
+		return 0;
+	}
+}
+
+void __DS5W::Haptics::encodeReport(unsigned char* report, unsigned char sequence, const signed char* samples)
+{
+	memset(report, 0, DS_OUTPUT_REPORT_BT_HAPTICS_SIZE);
+	sequence &= 0x0F;
+
+	report[0x00] = DS_OUTPUT_REPORT_BT_HAPTICS;
+	report[0x01] = sequence << 4;
+
+	report[0x02] = PACKET_CONTROL | PACKET_LENGTH_PRESENT;
+	report[0x03] = PACKET_CONTROL_LENGTH;
+	report[0x04] = 0xFE;
+	report[0x09] = 0xFF;
+	report[0x0A] = sequence;
+
+	report[0x0B] = PACKET_SAMPLES | PACKET_LENGTH_PRESENT;
+	report[0x0C] = PACKET_SAMPLES_LENGTH;
+	memcpy(&report[0x0D], samples, PACKET_SAMPLES_LENGTH);
+
+	// Last 4 bytes are the hash of all bytes before, as in DS_OUTPUT_REPORT_BT
+	const size_t len = DS_OUTPUT_REPORT_BT_HAPTICS_SIZE - sizeof(UINT32);
+	const UINT32 hash = __DS5W::CRC32::compute(report, len);
+	memcpy(&report[len], &hash, sizeof(UINT32));
+}
+
+void __DS5W::Haptics::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+	stream.thread = NULL;
+	stream.timer = NULL;
+	stream.stopEvent = NULL;
+	memset(&stream.olWrite, 0, sizeof(OVERLAPPED));
+	stream.running = FALSE;
+	stream.deviceRemoved = FALSE;
+}
+
+DS5W_ReturnValue __DS5W::Haptics::start(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+	// USB haptics are played through the audio interface, not HID reports
+	if (ptrContext->_internal.connectionType != DS5W::DeviceConnection::BT)
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+
+	stop(ptrContext);
+
+	// High resolution timers need Windows 10 1803, older versions fall back to the system timer resolution
+	stream.timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (!stream.timer)
+		stream.timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+	stream.stopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	memset(&stream.olWrite, 0, sizeof(OVERLAPPED));
+	stream.olWrite.hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+	if (!stream.timer || !stream.stopEvent || !stream.olWrite.hEvent) {
+		if (stream.timer) CloseHandle(stream.timer);
+		if (stream.stopEvent) CloseHandle(stream.stopEvent);
+		if (stream.olWrite.hEvent) CloseHandle(stream.olWrite.hEvent);
+		stream.timer = NULL;
+		stream.stopEvent = NULL;
+		stream.olWrite.hEvent = NULL;
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	// Thread is not running yet, no interlocked access needed
+	stream.sequence = 0;
+	stream.writeCount = 0;
+	stream.readCount = 0;
+	stream.inputRate = 0;
+	stream.phase = 0;
+	stream.sum[0] = 0;
+	stream.sum[1] = 0;
+	stream.sumCount = 0;
+	stream.last[0] = 0;
+	stream.last[1] = 0;
+	stream.streaming = false;
+	stream.reportsWritten = 0;
+	stream.underruns = 0;
+	stream.overruns = 0;
+	stream.droppedFrames = 0;
+	stream.failed = 0;
+	stream.running = TRUE;
+	stream.deviceRemoved = FALSE;
+
+	stream.thread = CreateThread(NULL, 0, streamThread, ptrContext, 0, NULL);
+	if (!stream.thread) {
+		stream.running = FALSE;
+		CloseHandle(stream.timer);
+		CloseHandle(stream.stopEvent);
+		CloseHandle(stream.olWrite.hEvent);
+		stream.timer = NULL;
+		stream.stopEvent = NULL;
+		stream.olWrite.hEvent = NULL;
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	return DS5W_OK;
+}
+
+void __DS5W::Haptics::stop(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+	if (!stream.thread)
+		return;
+
+	SetEvent(stream.stopEvent);
+	WaitForSingleObject(stream.thread, INFINITE);
+
+	CloseHandle(stream.thread);
+	CloseHandle(stream.timer);
+	CloseHandle(stream.stopEvent);
+	CloseHandle(stream.olWrite.hEvent);
+	stream.thread = NULL;
+	stream.timer = NULL;
+	stream.stopEvent = NULL;
+	stream.olWrite.hEvent = NULL;
+}
+
+bool __DS5W::Haptics::write(DS5W::DeviceContext* ptrContext, const short* frames, unsigned int frameCount, unsigned int sampleRate)
+{
+	DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+	if (!load(&stream.running))
+		return false;
+
+	queueFrames(ptrContext, frames, frameCount, sampleRate);
+
+	return true;
+}
+
+void __DS5W::Haptics::queueFrames(DS5W::DeviceContext* ptrContext, const short* frames, unsigned int frameCount, unsigned int sampleRate)
+{
+	DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+	// Rate changed, resample afresh
+	if (sampleRate != stream.inputRate) {
+		stream.inputRate = sampleRate;
+		stream.phase = 0;
+		stream.sum[0] = 0;
+		stream.sum[1] = 0;
+		stream.sumCount = 0;
+	}
+
+	// Only this thread moves writeCount, the reader may free more frames meanwhile
+	const unsigned int readCount = (unsigned int)load(&stream.readCount);
+	unsigned int writeCount = (unsigned int)stream.writeCount;
+	LONG64 dropped = 0;
+
+	for (unsigned int i = 0; i < frameCount; i++) {
+		stream.sum[0] += frames[i * 2 + 0];
+		stream.sum[1] += frames[i * 2 + 1];
+		stream.sumCount++;
+
+		// Every input frame moves the output clock DS_HAPTICS_SAMPLE_RATE / sampleRate frames
+		stream.phase += DS_HAPTICS_SAMPLE_RATE;
+		while (stream.phase >= sampleRate) {
+			stream.phase -= sampleRate;
+
+			// Downsampling averages the frames since the last output, upsampling repeats the last output
+			if (stream.sumCount) {
+				stream.last[0] = (signed char)((stream.sum[0] / (int)stream.sumCount) >> 8);
+				stream.last[1] = (signed char)((stream.sum[1] / (int)stream.sumCount) >> 8);
+				stream.sum[0] = 0;
+				stream.sum[1] = 0;
+				stream.sumCount = 0;
+			}
+
+			if (writeCount - readCount >= DS5W_HAPTICS_RING_FRAMES) {
+				dropped++;
+				continue;
+			}
+
+			stream.frames[writeCount & RING_MASK][0] = stream.last[0];
+			stream.frames[writeCount & RING_MASK][1] = stream.last[1];
+			writeCount++;
+		}
+	}
+
+	// Frames become visible to the reader all at once
+	InterlockedExchange(&stream.writeCount, (LONG)writeCount);
+
+	if (dropped) {
+		InterlockedIncrement64(&stream.overruns);
+		InterlockedExchangeAdd64(&stream.droppedFrames, dropped);
+	}
+}
+
+unsigned int __DS5W::Haptics::takeReportFrames(DS5W::DeviceContext* ptrContext, signed char* samples)
+{
+	DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+	// Only this thread moves readCount
+	const unsigned int readCount = (unsigned int)stream.readCount;
+	const unsigned int available = (unsigned int)load(&stream.writeCount) - readCount;
+
+	if (available == 0) {
+		if (stream.streaming)
+			InterlockedIncrement64(&stream.underruns);
+		stream.streaming = false;
+		return 0;
+	}
+
+	// Short reports are filled with silence
+	const unsigned int count = available < DS_HAPTICS_FRAMES_PER_REPORT ? available : DS_HAPTICS_FRAMES_PER_REPORT;
+	memset(samples, 0, DS_HAPTICS_FRAMES_PER_REPORT * 2);
+	for (unsigned int i = 0; i < count; i++) {
+		const unsigned int index = (readCount + i) & RING_MASK;
+		samples[i * 2 + 0] = stream.frames[index][0];
+		samples[i * 2 + 1] = stream.frames[index][1];
+	}
+	InterlockedExchange(&stream.readCount, (LONG)(readCount + count));
+
+	stream.streaming = count == DS_HAPTICS_FRAMES_PER_REPORT;
+	if (!stream.streaming)
+		InterlockedIncrement64(&stream.underruns);
+
+	return count;
+}
+
+bool __DS5W::Haptics::deviceRemoved(DS5W::DeviceContext* ptrContext)
+{
+	return load(&ptrContext->_internal.hapticsStream.deviceRemoved) != FALSE;
+}
+
+void __DS5W::Haptics::getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5HapticsStreamStatistics* ptrStatistics)
+{
+	DS5W::HapticsStreamState& stream = ptrContext->_internal.hapticsStream;
+
+	ptrStatistics->reportsWritten = (unsigned long long)load64(&stream.reportsWritten);
+	ptrStatistics->underruns = (unsigned long long)load64(&stream.underruns);
+	ptrStatistics->overruns = (unsigned long long)load64(&stream.overruns);
+	ptrStatistics->droppedFrames = (unsigned long long)load64(&stream.droppedFrames);
+	ptrStatistics->failed = (unsigned long long)load64(&stream.failed);
+	// Read count first, it never passes the write count
+	const unsigned int readCount = (unsigned int)load(&stream.readCount);
+	ptrStatistics->queuedFrames = (unsigned int)load(&stream.writeCount) - readCount;
+	ptrStatistics->running = load(&stream.running) != FALSE;
+}
@@ -0,0 +1,75 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace Haptics {
+		/// <summary>
+		/// Highest input sample rate, keeps the resampler sums in range
+		/// </summary>
+		const unsigned int MAX_INPUT_RATE = 192000;
+
+		/// <summary>
+		/// Encode one haptics report, does not touch any device
+		/// </summary>
+		/// <param name="report">Buffer of DS_OUTPUT_REPORT_BT_HAPTICS_SIZE bytes</param>
+		/// <param name="sequence">Report sequence number, only the lower 4 bits are sent</param>
+		/// <param name="samples">DS_HAPTICS_FRAMES_PER_REPORT frames of left, right samples</param>
+		void encodeReport(unsigned char* report, unsigned char sequence, const signed char* samples);
+
+		/// <summary>
+		/// Prepare the stream state of a new context
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Start the stream thread with an empty buffer, stopping a running one first
+		/// </summary>
+		/// <returns>Error code, DS5W_E_CURRENTLY_NOT_SUPPORTED over USB</returns>
+		DS5W_ReturnValue start(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Stop the stream thread, frames not yet sent are discarded. Does nothing if not started
+		/// </summary>
+		void stop(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Resample interleaved stereo frames and queue them, frames that do not fit are dropped
+		/// Must only be called from one thread at a time
+		/// </summary>
+		/// <returns>False if the stream is not running</returns>
+		bool write(DS5W::DeviceContext* ptrContext, const short* frames, unsigned int frameCount, unsigned int sampleRate);
+
+		/// <summary>
+		/// Resample interleaved stereo frames to DS_HAPTICS_SAMPLE_RATE into the frame ring
+		/// Frames that do not fit are dropped and counted as one overrun per call, only called by the thread writing the stream
+		/// </summary>
+		void queueFrames(DS5W::DeviceContext* ptrContext, const short* frames, unsigned int frameCount, unsigned int sampleRate);
+
+		/// <summary>
+		/// Take the frames of the next report from the frame ring, only called by the stream thread
+		/// A short report is filled with silence and counted as an underrun, as is running dry after full reports
+		/// </summary>
+		/// <param name="samples">Receives DS_HAPTICS_FRAMES_PER_REPORT frames of left, right samples</param>
+		/// <returns>Frames taken, 0 if the ring is empty and no report is sent</returns>
+		unsigned int takeReportFrames(DS5W::DeviceContext* ptrContext, signed char* samples);
+
+		/// <summary>
+		/// Whether the stream stopped itself as the device was removed
+		/// </summary>
+		bool deviceRemoved(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Copy the stream counters
+		/// </summary>
+		void getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5HapticsStreamStatistics* ptrStatistics);
+	}
+}
@@ -1,106 +1,176 @@
 #include "DS5_Input.h"
+#include "DS5_Clock.h"
+#include "DS5_Conditioning.h"
+#include "DS5_Motion.h"
+#include "DS5_Touch.h"
+
+const unsigned char __DS5W::Input::dpadLookup[16] = {
+	DS5W_ISTATE_BTN_DPAD_UP,								// 0x0 Up
+	DS5W_ISTATE_BTN_DPAD_RIGHT | DS5W_ISTATE_BTN_DPAD_UP,	// 0x1 Right Up
+	DS5W_ISTATE_BTN_DPAD_RIGHT,								// 0x2 Right
+	DS5W_ISTATE_BTN_DPAD_RIGHT | DS5W_ISTATE_BTN_DPAD_DOWN,	// 0x3 Right Down
+	DS5W_ISTATE_BTN_DPAD_DOWN,								// 0x4 Down
+	DS5W_ISTATE_BTN_DPAD_LEFT | DS5W_ISTATE_BTN_DPAD_DOWN,	// 0x5 Left Down
+	DS5W_ISTATE_BTN_DPAD_LEFT,								// 0x6 Left
+	DS5W_ISTATE_BTN_DPAD_LEFT | DS5W_ISTATE_BTN_DPAD_UP,	// 0x7 Left Up
+	0, 0, 0, 0, 0, 0, 0, 0									// 0x8 Released
+};
 
 void __DS5W::Input::evaluateHidInputBuffer(unsigned char* hidInBuffer, DS5W::DS5InputState* ptrInputState, DS5W::DeviceContext* ptrContext) {
-	// Convert sticks to signed range
-	ptrInputState->leftStick.x = (char)(((short)(hidInBuffer[0x00] - 128)));
-	ptrInputState->leftStick.y = (char)(((short)(hidInBuffer[0x01] - 127)) * -1);
-	ptrInputState->rightStick.x = (char)(((short)(hidInBuffer[0x02] - 128)));
-	ptrInputState->rightStick.y = (char)(((short)(hidInBuffer[0x03] - 127)) * -1);
-
-	// Convert trigger to unsigned range
-	ptrInputState->leftTrigger = hidInBuffer[0x04];
-	ptrInputState->rightTrigger = hidInBuffer[0x05];
-
-	// Buttons
-	unsigned char buttonsAndDpad = hidInBuffer[0x07] & 0xF0;
-	unsigned char buttonsA = hidInBuffer[0x08];
-	unsigned char buttonsB = hidInBuffer[0x09];
-
-	// Dpad
-	switch (hidInBuffer[0x07] & 0x0F) {
-		
-	case 0x0: // Up
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_UP;
-		break;
-	case 0x2: // Right
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_RIGHT;
-		break;
-	case 0x4: // Down
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_DOWN;
-		break;
-	case 0x6: // Left
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_LEFT;
-		break;
-	case 0x1: // Right Up
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_RIGHT | DS5W_ISTATE_BTN_DPAD_UP;
-		break;
-	case 0x3: // Right Down
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_RIGHT | DS5W_ISTATE_BTN_DPAD_DOWN;
-		break;
-	case 0x5: // Left Down
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_LEFT | DS5W_ISTATE_BTN_DPAD_DOWN;
-		break;
-	case 0x7: // Left Up
-		buttonsAndDpad |= DS5W_ISTATE_BTN_DPAD_LEFT | DS5W_ISTATE_BTN_DPAD_UP;
-		break;
+	evaluateHidInputBufferMasked(hidInBuffer, ptrInputState, ptrContext, DS5W_ISTATE_FIELD_ALL);
+}
+
+unsigned char* __DS5W::Input::heldReportBody(DS5W::DeviceContext* ptrContext) {
+	// bluetooth HID report is offset by 2, usb by 1
+	return &ptrContext->_internal.hidInBuffer[ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT ? 2 : 1];
+}
+
+const unsigned char* __DS5W::Input::heldReportBody(const DS5W::DeviceContext* ptrContext) {
+	return heldReportBody(const_cast<DS5W::DeviceContext*>(ptrContext));
+}
+
+void __DS5W::Input::decodeReport(DS5W::DeviceContext* ptrContext, unsigned char* hidInBuffer, DS5W::DS5InputState* ptrInputState, unsigned int fieldMask) {
+	evaluateHidInputBufferMasked(hidInBuffer, ptrInputState, ptrContext, fieldMask);
+
+	// Update orientation and touch tracking with the new report
+	__DS5W::Motion::updateFusion(ptrContext);
+	__DS5W::Touch::update(ptrContext);
+}
+
+void __DS5W::Input::decodeReport(DS5W::DeviceContext* ptrContext, unsigned char* hidInBuffer, DS5W::DS5InputStateF* ptrInputState) {
+	evaluateHidInputBufferF(hidInBuffer, ptrInputState, ptrContext);
+
+	// Update orientation and touch tracking with the new report
+	__DS5W::Motion::updateFusion(ptrContext);
+	__DS5W::Touch::update(ptrContext);
+}
+
+unsigned int __DS5W::Input::decodeReportEvents(DS5W::DeviceContext* ptrContext, unsigned char* hidInBuffer, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents) {
+	const unsigned int count = evaluateHidInputEvents(hidInBuffer, ptrEvents, maxEvents, ptrContext);
+
+	// Update orientation and touch tracking with the new report
+	__DS5W::Motion::updateFusion(ptrContext);
+	__DS5W::Touch::update(ptrContext);
+
+	return count;
+}
+
+void __DS5W::Input::evaluateHidInputBufferMasked(unsigned char* hidInBuffer, DS5W::DS5InputState* ptrInputState, DS5W::DeviceContext* ptrContext, unsigned int fieldMask, bool conditioned) {
+	const DS5W::AnalogConditioningTables& conditioning = ptrContext->_internal.conditioning;
+	conditioned = conditioned && conditioning.enabled;
+
+	if ((fieldMask & DS5W_ISTATE_FIELD_STICKS) && conditioned) {
+		// Deadzones and curves from the configured tables
+		__DS5W::Conditioning::sticks(conditioning, hidInBuffer, &ptrInputState->leftStick, &ptrInputState->rightStick);
+	}
+	else if (fieldMask & DS5W_ISTATE_FIELD_STICKS) {
+		// Convert sticks to signed range
+		ptrInputState->leftStick.x = (char)(((short)(hidInBuffer[0x00] - 128)));
+		ptrInputState->leftStick.y = (char)(((short)(hidInBuffer[0x01] - 127)) * -1);
+		ptrInputState->rightStick.x = (char)(((short)(hidInBuffer[0x02] - 128)));
+		ptrInputState->rightStick.y = (char)(((short)(hidInBuffer[0x03] - 127)) * -1);
 	}
 
-	ptrInputState->buttonMap = (buttonsB << 16) | (buttonsA << 8) | buttonsAndDpad;
+	if ((fieldMask & DS5W_ISTATE_FIELD_TRIGGERS) && conditioned) {
+		ptrInputState->leftTrigger = conditioning.triggerI[0][hidInBuffer[0x04]];
+		ptrInputState->rightTrigger = conditioning.triggerI[1][hidInBuffer[0x05]];
+	}
+	else if (fieldMask & DS5W_ISTATE_FIELD_TRIGGERS) {
+		// Convert trigger to unsigned range
+		ptrInputState->leftTrigger = hidInBuffer[0x04];
+		ptrInputState->rightTrigger = hidInBuffer[0x05];
+	}
 
-	// pointer to raw data in Hid report
-	const short* raw_accelerometer = (short*)&hidInBuffer[0x15];
-	const short* raw_gyroscope = (short*)&hidInBuffer[0x0F];
+	if (fieldMask & DS5W_ISTATE_FIELD_BUTTONS) {
+		// Buttons
+		unsigned char buttonsAndDpad = hidInBuffer[0x07] & 0xF0;
+		unsigned char buttonsA = hidInBuffer[0x08];
+		unsigned char buttonsB = hidInBuffer[0x09];
 
-	// parse + calibrate accelerometer
-	ptrInputState->accelerometer.x = ptrContext->_internal.calibrationData.accelerometer[0].calibrate(raw_accelerometer[0]);
-	ptrInputState->accelerometer.y = ptrContext->_internal.calibrationData.accelerometer[1].calibrate(raw_accelerometer[1]);
-	ptrInputState->accelerometer.z = ptrContext->_internal.calibrationData.accelerometer[2].calibrate(raw_accelerometer[2]);
+		// Dpad
+		buttonsAndDpad |= dpadLookup[hidInBuffer[0x07] & 0x0F];
 
-	// parse + calibrate gyroscope
-	ptrInputState->gyroscope.x = ptrContext->_internal.calibrationData.gyroscope[0].calibrate(raw_gyroscope[0]);
-	ptrInputState->gyroscope.y = ptrContext->_internal.calibrationData.gyroscope[1].calibrate(raw_gyroscope[1]);
-	ptrInputState->gyroscope.z = ptrContext->_internal.calibrationData.gyroscope[2].calibrate(raw_gyroscope[2]);
+		ptrInputState->buttonMap = (buttonsB << 16) | (buttonsA << 8) | buttonsAndDpad;
 
-	// Evaluate touch state 1
-	UINT32 touchpad1Raw = *(UINT32*)(&hidInBuffer[0x20]);
-	ptrInputState->touchPoint1.y = (touchpad1Raw & 0xFFF00000) >> 20;
-	ptrInputState->touchPoint1.x = (touchpad1Raw & 0x000FFF00) >> 8;
-	ptrInputState->touchPoint1.down = (touchpad1Raw & (1 << 7)) == 0;
-	ptrInputState->touchPoint1.id = (touchpad1Raw & 127);
+		// Trigger buttons from the configured thresholds instead of the device's
+		if (conditioned) {
+			ptrInputState->buttonMap = __DS5W::Conditioning::triggerButtons(ptrContext->_internal.conditioning, hidInBuffer, ptrInputState->buttonMap);
+		}
+	}
 
-	// Evaluate touch state 2
-	UINT32 touchpad2Raw = *(UINT32*)(&hidInBuffer[0x24]);
-	ptrInputState->touchPoint2.y = (touchpad2Raw & 0xFFF00000) >> 20;
-	ptrInputState->touchPoint2.x = (touchpad2Raw & 0x000FFF00) >> 8;
-	ptrInputState->touchPoint2.down = (touchpad2Raw & (1 << 7)) == 0;
-	ptrInputState->touchPoint2.id = (touchpad2Raw & 127);
+	if (fieldMask & DS5W_ISTATE_FIELD_ACCELEROMETER) {
+		// parse + calibrate accelerometer
+		const short* raw_accelerometer = (short*)&hidInBuffer[0x15];
+		ptrInputState->accelerometer.x = ptrContext->_internal.calibrationData.accelerometer[0].calibrate(raw_accelerometer[0]);
+		ptrInputState->accelerometer.y = ptrContext->_internal.calibrationData.accelerometer[1].calibrate(raw_accelerometer[1]);
+		ptrInputState->accelerometer.z = ptrContext->_internal.calibrationData.accelerometer[2].calibrate(raw_accelerometer[2]);
+	}
 
-	// Evaluate headphone input
-	ptrInputState->headPhoneConnected = hidInBuffer[0x35] & 0x01;
+	if (fieldMask & DS5W_ISTATE_FIELD_GYROSCOPE) {
+		// parse + calibrate gyroscope
+		const short* raw_gyroscope = (short*)&hidInBuffer[0x0F];
+		ptrInputState->gyroscope.x = ptrContext->_internal.calibrationData.gyroscope[0].calibrate(raw_gyroscope[0]);
+		ptrInputState->gyroscope.y = ptrContext->_internal.calibrationData.gyroscope[1].calibrate(raw_gyroscope[1]);
+		ptrInputState->gyroscope.z = ptrContext->_internal.calibrationData.gyroscope[2].calibrate(raw_gyroscope[2]);
+	}
+
+	if (fieldMask & DS5W_ISTATE_FIELD_TOUCH) {
+		// Evaluate touch state 1
+		UINT32 touchpad1Raw = *(UINT32*)(&hidInBuffer[0x20]);
+		ptrInputState->touchPoint1.y = (touchpad1Raw & 0xFFF00000) >> 20;
+		ptrInputState->touchPoint1.x = (touchpad1Raw & 0x000FFF00) >> 8;
+		ptrInputState->touchPoint1.down = (touchpad1Raw & (1 << 7)) == 0;
+		ptrInputState->touchPoint1.id = (touchpad1Raw & 127);
+
+		// Evaluate touch state 2
+		UINT32 touchpad2Raw = *(UINT32*)(&hidInBuffer[0x24]);
+		ptrInputState->touchPoint2.y = (touchpad2Raw & 0xFFF00000) >> 20;
+		ptrInputState->touchPoint2.x = (touchpad2Raw & 0x000FFF00) >> 8;
+		ptrInputState->touchPoint2.down = (touchpad2Raw & (1 << 7)) == 0;
+		ptrInputState->touchPoint2.id = (touchpad2Raw & 127);
+	}
 
-	// Trigger force feedback
-	ptrInputState->leftTriggerFeedback = hidInBuffer[0x2A];
-	ptrInputState->rightTriggerFeedback = hidInBuffer[0x29];
+	if (fieldMask & DS5W_ISTATE_FIELD_HEADPHONE) {
+		// Evaluate headphone input
+		ptrInputState->headPhoneConnected = hidInBuffer[0x35] & 0x01;
+	}
 
+	if (fieldMask & DS5W_ISTATE_FIELD_TRIGGER_FEEDBACK) {
+		// Trigger force feedback
+		ptrInputState->leftTriggerFeedback = hidInBuffer[0x2A];
+		ptrInputState->rightTriggerFeedback = hidInBuffer[0x29];
+	}
+
+	// Timing is always tracked so later reports get the right delta even if this one did not ask for it
 	unsigned int currentTime = *(unsigned int*)&hidInBuffer[0x1B];
 	unsigned int previousTime = ptrContext->_internal.timestamp;
 
-	// absolute difference between current and last timestamp
-	unsigned int deltaTime; 
-	if (previousTime > currentTime)
-		deltaTime = (0xFFFFFFFF - previousTime) + currentTime;
-	else
-		deltaTime = currentTime - previousTime;
-
-	ptrInputState->currentTime = currentTime;
-	ptrInputState->deltaTime = deltaTime;
+	// a report already seen keeps its delta so the held report can be decoded again
+	if (currentTime != previousTime) {
+		// absolute difference between current and last timestamp
+		unsigned int deltaTime;
+		if (previousTime > currentTime)
+			deltaTime = (0xFFFFFFFF - previousTime) + currentTime;
+		else
+			deltaTime = currentTime - previousTime;
+
+		ptrContext->_internal.timestamp = currentTime;
+		ptrContext->_internal.deltaTime = deltaTime;
+	}
 
-	ptrContext->_internal.timestamp = currentTime;
+	if (fieldMask & DS5W_ISTATE_FIELD_TIME) {
+		ptrInputState->currentTime = currentTime;
+		ptrInputState->deltaTime = ptrContext->_internal.deltaTime;
+		ptrInputState->hostTimestamp = __DS5W::Clock::deviceToHost(ptrContext, currentTime);
+		ptrInputState->reportGap = ptrContext->_internal.reportSequence.lastGap;
+	}
 
-	// Battery
-	ptrInputState->battery.charging = (hidInBuffer[0x35] & 0x08) != 0;
-	ptrInputState->battery.fullyCharged = (hidInBuffer[0x34] & 0x20) != 0;
-	ptrInputState->battery.level = ((hidInBuffer[0x34] & 0x0F) * 100) / 8;
+	if (fieldMask & DS5W_ISTATE_FIELD_BATTERY) {
+		// Battery
+		ptrInputState->battery.charging = (hidInBuffer[0x35] & 0x08) != 0;
+		ptrInputState->battery.fullyCharged = (hidInBuffer[0x34] & 0x20) != 0;
+		ptrInputState->battery.level = ((hidInBuffer[0x34] & 0x0F) * 100) / 8;
+	}
 }
 
 void __DS5W::Input::parseCalibrationData(DS5W::DeviceCalibrationData* ptrCalibrationData, short* data)
@@ -161,4 +231,10 @@ void __DS5W::Input::parseCalibrationData(DS5W::DeviceCalibrationData* ptrCalibra
 	ptrCalibrationData->accelerometer[2].bias = acc_z_plus - range_2g / 2;
 	ptrCalibrationData->accelerometer[2].sens_numer = 2 * DS_ACC_RES_PER_G;
 	ptrCalibrationData->accelerometer[2].sens_denom = range_2g;
+
+	// Replace per report divisions with multiplies
+	for (int i = 0; i < 3; i++) {
+		ptrCalibrationData->gyroscope[i].precompute();
+		ptrCalibrationData->accelerometer[i].precompute();
+	}
 }
@@ -26,6 +26,95 @@ namespace __DS5W {
 		/// <returns></returns>
 		void evaluateHidInputBuffer(unsigned char* hidInBuffer, DS5W::DS5InputState* ptrInputState, DS5W::DeviceContext* ptrContext);
 
+		/// <summary>
+		/// Body of the report held in the context's input buffer
+		/// </summary>
+		/// <returns>First byte after the report ID, and after the bluetooth header</returns>
+		unsigned char* heldReportBody(DS5W::DeviceContext* ptrContext);
+		const unsigned char* heldReportBody(const DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Interprete only the requested fields of the hid returned buffer
+		/// Fields not in the mask are left untouched, timing is tracked either way
+		/// </summary>
+		/// <param name="hidInBuffer">Input buffer</param>
+		/// <param name="ptrInputState">Input state to be set</param>
+		/// <param name="fieldMask">DS5W_ISTATE_FIELD_* flags of fields to write</param>
+		/// <param name="conditioned">Apply the stick and trigger conditioning if enabled, the batch decoder reports raw values</param>
+		void evaluateHidInputBufferMasked(unsigned char* hidInBuffer, DS5W::DS5InputState* ptrInputState, DS5W::DeviceContext* ptrContext, unsigned int fieldMask, bool conditioned = true);
+
+		/// <summary>
+		/// Interprete the hid returned buffer into floats in SI units
+		/// </summary>
+		/// <param name="hidInBuffer">Input buffer</param>
+		/// <param name="ptrInputState">Input state to be set</param>
+		void evaluateHidInputBufferF(unsigned char* hidInBuffer, DS5W::DS5InputStateF* ptrInputState, DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Interprete many hid input buffers into column arrays
+		/// </summary>
+		/// <param name="hidInBuffers">First input buffer</param>
+		/// <param name="stride">Bytes between consecutive input buffers</param>
+		/// <param name="count">Number of input buffers</param>
+		/// <param name="ptrBatch">Columns to be set</param>
+		void evaluateHidInputBatch(const unsigned char* hidInBuffers, unsigned int stride, unsigned int count, DS5W::DS5InputBatch* ptrBatch, DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Compare the hid input buffer against the last one and list what changed
+		/// </summary>
+		/// <param name="hidInBuffer">Input buffer</param>
+		/// <param name="ptrEvents">Events to be set</param>
+		/// <param name="maxEvents">Length of the event array</param>
+		/// <returns>Number of events generated, can be more than maxEvents</returns>
+		unsigned int evaluateHidInputEvents(unsigned char* hidInBuffer, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents, DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Interprete a newly read report and move orientation and touch tracking forward with it
+		/// </summary>
+		/// <param name="hidInBuffer">Input buffer</param>
+		/// <param name="ptrInputState">Input state to be set</param>
+		/// <param name="fieldMask">DS5W_ISTATE_FIELD_* flags of fields to write</param>
+		void decodeReport(DS5W::DeviceContext* ptrContext, unsigned char* hidInBuffer, DS5W::DS5InputState* ptrInputState, unsigned int fieldMask = DS5W_ISTATE_FIELD_ALL);
+		void decodeReport(DS5W::DeviceContext* ptrContext, unsigned char* hidInBuffer, DS5W::DS5InputStateF* ptrInputState);
+
+		/// <summary>
+		/// List what changed in a newly read report and move orientation and touch tracking forward with it
+		/// </summary>
+		/// <returns>Number of events generated, can be more than maxEvents</returns>
+		unsigned int decodeReportEvents(DS5W::DeviceContext* ptrContext, unsigned char* hidInBuffer, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents);
+
+		/// <summary>
+		/// Forget the last input report so the next one starts a new event stream
+		/// </summary>
+		void resetInputEvents(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Count lost and duplicated reports using the sequence counter and timestamp of a newly read report
+		/// Must be called once per completed read, not per decode
+		/// </summary>
+		/// <param name="hidInBuffer">Input buffer</param>
+		void trackReportSequence(const unsigned char* hidInBuffer, DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Start counting from the next report without a gap, used after (re)connecting
+		/// </summary>
+		void restartReportSequence(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Clear the lost and duplicated report counters
+		/// </summary>
+		void resetReportStatistics(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Copy the lost and duplicated report counters
+		/// </summary>
+		void getReportStatistics(const DS5W::DeviceContext* ptrContext, DS5W::DS5ReportStatistics* ptrStatistics);
+
+		/// <summary>
+		/// Dpad button flags indexed by the dpad nibble of the report
+		/// </summary>
+		extern const unsigned char dpadLookup[16];
+
 		/// <summary>
 		/// Extract necessary values from calibration report
 		/// </summary>
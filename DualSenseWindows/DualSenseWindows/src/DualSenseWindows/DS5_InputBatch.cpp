@@ -0,0 +1,292 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Input.h"
+#include "DS5_Cpu.h"
+
+#include <string.h>
+#include <intrin.h>
+
+namespace {
+	// Reports decoded per SIMD block (one 16 byte register of stick / trigger bytes)
+	const unsigned int BLOCK_SIZE = 16;
+
+	// Unaligned little endian loads from a report body
+	inline unsigned int load32(const unsigned char* ptr)
+	{
+		unsigned int value;
+		memcpy(&value, ptr, sizeof(value));
+		return value;
+	}
+
+	inline int load16s(const unsigned char* ptr)
+	{
+		short value;
+		memcpy(&value, ptr, sizeof(value));
+		return value;
+	}
+
+	/// <summary>
+	/// Division free calibration constants of all 6 motion axes, see AxisCalibrationData::precompute
+	/// </summary>
+	struct BatchCalibration {
+		const DS5W::AxisCalibrationData* axis[6];
+		__m128i bias[6];
+		__m128i quot[6];
+		__m128i rem[6];
+		__m128i magic[6];
+		__m128i shift[6];
+	};
+
+	void prepareCalibration(BatchCalibration* ptrCal, const DS5W::DeviceCalibrationData* ptrData)
+	{
+		// axis order: gyro x y z, accel x y z
+		for (int i = 0; i < 6; i++) {
+			const DS5W::AxisCalibrationData* ptrAxis = i < 3 ? &ptrData->gyroscope[i] : &ptrData->accelerometer[i - 3];
+			ptrCal->axis[i] = ptrAxis;
+			ptrCal->bias[i] = _mm_set1_epi32(ptrAxis->bias);
+			ptrCal->quot[i] = _mm_set1_epi32(ptrAxis->sens_quot);
+			ptrCal->rem[i] = _mm_set1_epi32((int)ptrAxis->sens_rem);
+			ptrCal->magic[i] = _mm_set1_epi32((int)ptrAxis->sens_magic);
+			ptrCal->shift[i] = _mm_cvtsi32_si128((int)ptrAxis->sens_shift);
+		}
+	}
+
+	// quot * |x| + ((rem * |x| * magic) >> shift) of the even lanes, results in the low half of each 64-bit lane
+	inline __m128i calibrateEven(__m128i absX, __m128i quot, __m128i rem, __m128i magic, __m128i shift)
+	{
+		const __m128i frac = _mm_srl_epi64(_mm_mul_epu32(_mm_mul_epu32(absX, rem), magic), shift);
+		return _mm_add_epi64(_mm_mul_epu32(absX, quot), frac);
+	}
+
+	// 4 reports of one axis with 32x32->64 bit multiplies, same result as AxisCalibrationData::calibrate
+	inline __m128i calibrate4(__m128i raw, const BatchCalibration* ptrCal, int axis)
+	{
+		const __m128i x = _mm_sub_epi32(raw, ptrCal->bias[axis]);
+
+		// out of range calibration has no reciprocal
+		if (ptrCal->axis[axis]->sens_magic == 0) {
+			alignas(16) int lanes[4];
+			_mm_store_si128((__m128i*)lanes, raw);
+			for (int i = 0; i < 4; i++)
+				lanes[i] = ptrCal->axis[axis]->calibrate(lanes[i]);
+			return _mm_load_si128((const __m128i*)lanes);
+		}
+
+		// |x| is at most 65535 as raw values and bias are both 16 bit
+		const __m128i sign = _mm_srai_epi32(x, 31);
+		const __m128i absX = _mm_sub_epi32(_mm_xor_si128(x, sign), sign);
+
+		const __m128i even = calibrateEven(absX, ptrCal->quot[axis], ptrCal->rem[axis], ptrCal->magic[axis], ptrCal->shift[axis]);
+		const __m128i odd = calibrateEven(_mm_srli_epi64(absX, 32), ptrCal->quot[axis], ptrCal->rem[axis], ptrCal->magic[axis], ptrCal->shift[axis]);
+
+		// results fit 32 bits, so the high halves are zero
+		const __m128i value = _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+		return _mm_sub_epi32(_mm_xor_si128(value, sign), sign);
+	}
+
+	// Gather one 32-bit field from 4 consecutive reports into the lanes of a register
+	inline __m128i gather4(const unsigned char* ptr, unsigned int stride, unsigned int offset)
+	{
+		return _mm_setr_epi32(
+			(int)load32(ptr + offset),
+			(int)load32(ptr + stride + offset),
+			(int)load32(ptr + 2 * stride + offset),
+			(int)load32(ptr + 3 * stride + offset));
+	}
+
+	inline __m128i gather4s(const unsigned char* ptr, unsigned int stride, unsigned int offset)
+	{
+		return _mm_setr_epi32(
+			load16s(ptr + offset),
+			load16s(ptr + stride + offset),
+			load16s(ptr + 2 * stride + offset),
+			load16s(ptr + 3 * stride + offset));
+	}
+
+	/// <summary>
+	/// Sticks and triggers of 16 reports
+	/// Each report's 4 bytes are transposed into 16 byte columns with pshufb and dword unpacks
+	/// </summary>
+	void sticksAndTriggers16(const unsigned char* ptr, unsigned int stride, unsigned int index, DS5W::DS5InputBatch* ptrBatch)
+	{
+		// reorders 4 lanes of 4 bytes into 4 runs of the same byte from each lane
+		const __m128i columns = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+		// x axis bytes are offset by 128, y axis bytes are offset by 127 and inverted
+		const __m128i yMask = _mm_set1_epi32((int)0xFF00FF00);
+		const __m128i xOffset = _mm_set1_epi8((char)0x80);
+		const __m128i yOffset = _mm_set1_epi8(127);
+
+		__m128i sticks[4];
+		__m128i triggers[4];
+		for (int i = 0; i < 4; i++) {
+			const unsigned char* ptrGroup = ptr + 4 * i * stride;
+
+			__m128i raw = gather4(ptrGroup, stride, 0x00);
+			const __m128i x = _mm_xor_si128(raw, xOffset);
+			const __m128i y = _mm_sub_epi8(yOffset, raw);
+			raw = _mm_or_si128(_mm_and_si128(yMask, y), _mm_andnot_si128(yMask, x));
+			sticks[i] = _mm_shuffle_epi8(raw, columns);
+
+			triggers[i] = _mm_shuffle_epi8(gather4(ptrGroup, stride, 0x04), columns);
+		}
+
+		__m128i lo = _mm_unpacklo_epi32(sticks[0], sticks[1]);
+		__m128i hi = _mm_unpacklo_epi32(sticks[2], sticks[3]);
+		_mm_storeu_si128((__m128i*)&ptrBatch->leftStickX[index], _mm_unpacklo_epi64(lo, hi));
+		_mm_storeu_si128((__m128i*)&ptrBatch->leftStickY[index], _mm_unpackhi_epi64(lo, hi));
+
+		lo = _mm_unpackhi_epi32(sticks[0], sticks[1]);
+		hi = _mm_unpackhi_epi32(sticks[2], sticks[3]);
+		_mm_storeu_si128((__m128i*)&ptrBatch->rightStickX[index], _mm_unpacklo_epi64(lo, hi));
+		_mm_storeu_si128((__m128i*)&ptrBatch->rightStickY[index], _mm_unpackhi_epi64(lo, hi));
+
+		lo = _mm_unpacklo_epi32(triggers[0], triggers[1]);
+		hi = _mm_unpacklo_epi32(triggers[2], triggers[3]);
+		_mm_storeu_si128((__m128i*)&ptrBatch->leftTrigger[index], _mm_unpacklo_epi64(lo, hi));
+		_mm_storeu_si128((__m128i*)&ptrBatch->rightTrigger[index], _mm_unpackhi_epi64(lo, hi));
+	}
+
+	void sticksAndTriggers1(const unsigned char* ptr, unsigned int index, DS5W::DS5InputBatch* ptrBatch)
+	{
+		ptrBatch->leftStickX[index] = (char)(ptr[0x00] ^ 0x80);
+		ptrBatch->leftStickY[index] = (char)(127 - ptr[0x01]);
+		ptrBatch->rightStickX[index] = (char)(ptr[0x02] ^ 0x80);
+		ptrBatch->rightStickY[index] = (char)(127 - ptr[0x03]);
+		ptrBatch->leftTrigger[index] = ptr[0x04];
+		ptrBatch->rightTrigger[index] = ptr[0x05];
+	}
+
+	/// <summary>
+	/// Buttons, motion, touch and time of 4 reports
+	/// </summary>
+	void motionTouchTime4(const unsigned char* ptr, unsigned int stride, unsigned int index, DS5W::DS5InputBatch* ptrBatch, const BatchCalibration* ptrCal, unsigned int* ptrPreviousTime)
+	{
+		// Buttons, low nibble of the first byte is the dpad direction
+		for (unsigned int i = 0; i < 4; i++) {
+			const unsigned int raw = load32(ptr + i * stride + 0x07);
+			ptrBatch->buttonMap[index + i] = (raw & 0x00FFFFF0) | __DS5W::Input::dpadLookup[raw & 0x0F];
+		}
+
+		// Motion, gyroscope then accelerometer
+		int* const ptrAxes[6] = {
+			ptrBatch->gyroscopeX, ptrBatch->gyroscopeY, ptrBatch->gyroscopeZ,
+			ptrBatch->accelerometerX, ptrBatch->accelerometerY, ptrBatch->accelerometerZ
+		};
+		for (int axis = 0; axis < 6; axis++) {
+			const unsigned int offset = (axis < 3 ? 0x0F : 0x15) + 2 * (axis % 3);
+			const __m128i raw = gather4s(ptr, stride, offset);
+			_mm_storeu_si128((__m128i*)&ptrAxes[axis][index], calibrate4(raw, ptrCal, axis));
+		}
+
+		// Touch points
+		DS5W::Touch* const ptrTouches[2] = { ptrBatch->touchPoint1, ptrBatch->touchPoint2 };
+		for (int point = 0; point < 2; point++) {
+			const __m128i raw = gather4(ptr, stride, 0x20 + 4 * point);
+
+			unsigned int x[4], y[4], id[4], up[4];
+			_mm_storeu_si128((__m128i*)y, _mm_srli_epi32(raw, 20));
+			_mm_storeu_si128((__m128i*)x, _mm_and_si128(_mm_srli_epi32(raw, 8), _mm_set1_epi32(0xFFF)));
+			_mm_storeu_si128((__m128i*)id, _mm_and_si128(raw, _mm_set1_epi32(0x7F)));
+			_mm_storeu_si128((__m128i*)up, _mm_and_si128(raw, _mm_set1_epi32(0x80)));
+
+			for (int i = 0; i < 4; i++) {
+				DS5W::Touch* ptrTouch = &ptrTouches[point][index + i];
+				ptrTouch->x = x[i];
+				ptrTouch->y = y[i];
+				ptrTouch->down = up[i] == 0;
+				ptrTouch->id = (unsigned char)id[i];
+			}
+		}
+
+		// Timestamps, previous time of each lane is the lane before it
+		const __m128i current = gather4(ptr, stride, 0x1B);
+		const __m128i previous = _mm_or_si128(_mm_slli_si128(current, 4), _mm_cvtsi32_si128((int)*ptrPreviousTime));
+
+		// wrapped timestamps are one less than the modular difference, see evaluateHidInputBuffer
+		const __m128i sign = _mm_set1_epi32((int)0x80000000);
+		const __m128i wrapped = _mm_cmpgt_epi32(_mm_xor_si128(previous, sign), _mm_xor_si128(current, sign));
+		const __m128i delta = _mm_add_epi32(_mm_sub_epi32(current, previous), wrapped);
+
+		_mm_storeu_si128((__m128i*)&ptrBatch->currentTime[index], current);
+		_mm_storeu_si128((__m128i*)&ptrBatch->deltaTime[index], delta);
+		*ptrPreviousTime = (unsigned int)_mm_cvtsi128_si32(_mm_shuffle_epi32(current, _MM_SHUFFLE(3, 3, 3, 3)));
+	}
+
+	unsigned int decodeBlocks(const unsigned char* ptr, unsigned int stride, unsigned int count, DS5W::DS5InputBatch* ptrBatch, const BatchCalibration* ptrCal, unsigned int* ptrPreviousTime)
+	{
+		const bool useSSSE3 = __DS5W::Cpu::hasSSSE3();
+
+		unsigned int index = 0;
+		for (; index + BLOCK_SIZE <= count; index += BLOCK_SIZE) {
+			const unsigned char* ptrBlock = ptr + (size_t)index * stride;
+
+			if (useSSSE3) {
+				sticksAndTriggers16(ptrBlock, stride, index, ptrBatch);
+			}
+			else {
+				for (unsigned int i = 0; i < BLOCK_SIZE; i++)
+					sticksAndTriggers1(ptrBlock + i * stride, index + i, ptrBatch);
+			}
+
+			for (unsigned int i = 0; i < BLOCK_SIZE; i += 4)
+				motionTouchTime4(ptrBlock + i * stride, stride, index + i, ptrBatch, ptrCal, ptrPreviousTime);
+		}
+
+		return index;
+	}
+}
+
+void __DS5W::Input::evaluateHidInputBatch(const unsigned char* hidInBuffers, unsigned int stride, unsigned int count, DS5W::DS5InputBatch* ptrBatch, DS5W::DeviceContext* ptrContext)
+{
+	BatchCalibration calibration;
+	prepareCalibration(&calibration, &ptrContext->_internal.calibrationData);
+
+	const unsigned int firstPreviousTime = ptrContext->_internal.timestamp;
+	unsigned int previousTime = firstPreviousTime;
+
+	// Whole blocks with SIMD
+	unsigned int index = decodeBlocks(hidInBuffers, stride, count, ptrBatch, &calibration, &previousTime);
+
+	// Repeated timestamps keep the previous delta like the scalar decoder does
+	unsigned int previousDelta = ptrContext->_internal.deltaTime;
+	unsigned int repeatTime = firstPreviousTime;
+	for (unsigned int i = 0; i < index; i++) {
+		if (ptrBatch->currentTime[i] == repeatTime) {
+			ptrBatch->deltaTime[i] = previousDelta;
+		}
+		previousDelta = ptrBatch->deltaTime[i];
+		repeatTime = ptrBatch->currentTime[i];
+	}
+
+	// Remaining reports one at a time through the scalar decoder, unconditioned like the SIMD blocks
+	ptrContext->_internal.timestamp = previousTime;
+	ptrContext->_internal.deltaTime = previousDelta;
+	for (; index < count; index++) {
+		DS5W::DS5InputState state;
+		evaluateHidInputBufferMasked((unsigned char*)hidInBuffers + (size_t)index * stride, &state, ptrContext, DS5W_ISTATE_FIELD_ALL, false);
+
+		ptrBatch->leftStickX[index] = state.leftStick.x;
+		ptrBatch->leftStickY[index] = state.leftStick.y;
+		ptrBatch->rightStickX[index] = state.rightStick.x;
+		ptrBatch->rightStickY[index] = state.rightStick.y;
+		ptrBatch->leftTrigger[index] = state.leftTrigger;
+		ptrBatch->rightTrigger[index] = state.rightTrigger;
+		ptrBatch->buttonMap[index] = state.buttonMap;
+		ptrBatch->gyroscopeX[index] = state.gyroscope.x;
+		ptrBatch->gyroscopeY[index] = state.gyroscope.y;
+		ptrBatch->gyroscopeZ[index] = state.gyroscope.z;
+		ptrBatch->accelerometerX[index] = state.accelerometer.x;
+		ptrBatch->accelerometerY[index] = state.accelerometer.y;
+		ptrBatch->accelerometerZ[index] = state.accelerometer.z;
+		ptrBatch->touchPoint1[index] = state.touchPoint1;
+		ptrBatch->touchPoint2[index] = state.touchPoint2;
+		ptrBatch->currentTime[index] = state.currentTime;
+		ptrBatch->deltaTime[index] = state.deltaTime;
+	}
+}
@@ -0,0 +1,186 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Input.h"
+
+#include <emmintrin.h>
+#include <string.h>
+
+namespace {
+	// Bytes of the report body that can generate events
+	// sequence number, motion sensors, timestamp and unknown bytes are ignored
+	alignas(16) const unsigned char eventByteMask[64] = {
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00 sticks, triggers, buttons
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10 motion, timestamp
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x20 touch points
+		0x00, 0x00, 0x00, 0x00, 0x2F, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x30 battery, headphones
+	};
+
+	// True if any byte covered by eventByteMask differs
+	inline bool reportChanged(const unsigned char* a, const unsigned char* b)
+	{
+		__m128i diff = _mm_setzero_si128();
+		for (int i = 0; i < 64; i += 16) {
+			const __m128i mask = _mm_load_si128((const __m128i*)&eventByteMask[i]);
+			const __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&a[i]), _mm_loadu_si128((const __m128i*)&b[i]));
+			diff = _mm_or_si128(diff, _mm_and_si128(x, mask));
+		}
+
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF;
+	}
+
+	inline unsigned int buttonMapOf(const unsigned char* hidInBuffer)
+	{
+		unsigned char buttonsAndDpad = (hidInBuffer[0x07] & 0xF0) | __DS5W::Input::dpadLookup[hidInBuffer[0x07] & 0x0F];
+		return (hidInBuffer[0x09] << 16) | (hidInBuffer[0x08] << 8) | buttonsAndDpad;
+	}
+
+	inline void touchOf(const unsigned char* hidInBuffer, DS5W::Touch* ptrTouch)
+	{
+		UINT32 touchRaw = *(UINT32*)hidInBuffer;
+		ptrTouch->y = (touchRaw & 0xFFF00000) >> 20;
+		ptrTouch->x = (touchRaw & 0x000FFF00) >> 8;
+		ptrTouch->down = (touchRaw & (1 << 7)) == 0;
+		ptrTouch->id = (touchRaw & 127);
+	}
+
+	inline int distance(int a, int b)
+	{
+		return a > b ? a - b : b - a;
+	}
+
+	// Appends to the event list, events past the end are only counted
+	struct EventWriter {
+		DS5W::DS5InputEvent* events;
+		unsigned int maxEvents;
+		unsigned int count;
+		unsigned int currentTime;
+		DS5W::DS5InputEvent overflow;
+
+		DS5W::DS5InputEvent* next(DS5W::InputEventType type)
+		{
+			DS5W::DS5InputEvent* ptrEvent = count < maxEvents ? &events[count] : &overflow;
+			count++;
+
+			ptrEvent->type = type;
+			ptrEvent->currentTime = currentTime;
+			return ptrEvent;
+		}
+	};
+}
+
+void __DS5W::Input::resetInputEvents(DS5W::DeviceContext* ptrContext)
+{
+	ptrContext->_internal.inputEvents.valid = false;
+}
+
+unsigned int __DS5W::Input::evaluateHidInputEvents(unsigned char* hidInBuffer, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents, DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputEventTracker& tracker = ptrContext->_internal.inputEvents;
+
+	// First report only sets the starting point
+	if (!tracker.valid) {
+		memcpy(tracker.lastReport, hidInBuffer, sizeof(tracker.lastReport));
+		tracker.sticks[0] = (char)(hidInBuffer[0x00] - 128);
+		tracker.sticks[1] = (char)((hidInBuffer[0x01] - 127) * -1);
+		tracker.sticks[2] = (char)(hidInBuffer[0x02] - 128);
+		tracker.sticks[3] = (char)((hidInBuffer[0x03] - 127) * -1);
+		tracker.triggers[0] = hidInBuffer[0x04];
+		tracker.triggers[1] = hidInBuffer[0x05];
+		tracker.valid = true;
+		return 0;
+	}
+
+	// Fast path for idle controllers
+	const unsigned char* last = tracker.lastReport;
+	if (!reportChanged(hidInBuffer, last)) {
+		return 0;
+	}
+
+	EventWriter writer;
+	writer.events = ptrEvents;
+	writer.maxEvents = maxEvents;
+	writer.count = 0;
+	writer.currentTime = *(unsigned int*)&hidInBuffer[0x1B];
+
+	// Button edges, one event per changed bit
+	const unsigned int buttons = buttonMapOf(hidInBuffer);
+	unsigned int changed = buttons ^ buttonMapOf(last);
+	while (changed) {
+		const unsigned int bit = changed & (0u - changed);
+		changed ^= bit;
+
+		writer.next((buttons & bit) ? DS5W::InputEventType::ButtonDown : DS5W::InputEventType::ButtonUp)->button = bit;
+	}
+
+	// Sticks, compared against the last reported position so slow drift still adds up
+	const char sticks[4] = {
+		(char)(hidInBuffer[0x00] - 128),
+		(char)((hidInBuffer[0x01] - 127) * -1),
+		(char)(hidInBuffer[0x02] - 128),
+		(char)((hidInBuffer[0x03] - 127) * -1),
+	};
+	const int stickThreshold = tracker.stickThreshold ? tracker.stickThreshold : 1;
+	for (int stick = 0; stick < 2; stick++) {
+		const int x = stick * 2;
+		const int y = stick * 2 + 1;
+		if (distance(sticks[x], tracker.sticks[x]) >= stickThreshold || distance(sticks[y], tracker.sticks[y]) >= stickThreshold) {
+			DS5W::DS5InputEvent* ptrEvent = writer.next(stick == 0 ? DS5W::InputEventType::LeftStickMoved : DS5W::InputEventType::RightStickMoved);
+			ptrEvent->stick.x = sticks[x];
+			ptrEvent->stick.y = sticks[y];
+
+			tracker.sticks[x] = sticks[x];
+			tracker.sticks[y] = sticks[y];
+		}
+	}
+
+	// Triggers
+	const int triggerThreshold = tracker.triggerThreshold ? tracker.triggerThreshold : 1;
+	for (int trigger = 0; trigger < 2; trigger++) {
+		const unsigned char value = hidInBuffer[0x04 + trigger];
+		if (distance(value, tracker.triggers[trigger]) >= triggerThreshold) {
+			writer.next(trigger == 0 ? DS5W::InputEventType::LeftTriggerMoved : DS5W::InputEventType::RightTriggerMoved)->trigger = value;
+			tracker.triggers[trigger] = value;
+		}
+	}
+
+	// Touch points, a new finger id without a lift in between counts as up then down
+	for (unsigned char point = 0; point < 2; point++) {
+		DS5W::Touch previous, current;
+		touchOf(&last[0x20 + point * 4], &previous);
+		touchOf(&hidInBuffer[0x20 + point * 4], &current);
+
+		if (previous.down && (!current.down || previous.id != current.id)) {
+			DS5W::DS5InputEvent* ptrEvent = writer.next(DS5W::InputEventType::TouchUp);
+			ptrEvent->touch.index = point;
+			ptrEvent->touch.point = previous;
+			ptrEvent->touch.point.down = false;
+		}
+
+		if (current.down && (!previous.down || previous.id != current.id)) {
+			DS5W::DS5InputEvent* ptrEvent = writer.next(DS5W::InputEventType::TouchDown);
+			ptrEvent->touch.index = point;
+			ptrEvent->touch.point = current;
+		}
+	}
+
+	// Headphones
+	if ((hidInBuffer[0x35] ^ last[0x35]) & 0x01) {
+		writer.next(DS5W::InputEventType::HeadphoneChanged)->headPhoneConnected = hidInBuffer[0x35] & 0x01;
+	}
+
+	// Battery
+	if (((hidInBuffer[0x34] ^ last[0x34]) & 0x2F) || ((hidInBuffer[0x35] ^ last[0x35]) & 0x08)) {
+		DS5W::DS5InputEvent* ptrEvent = writer.next(DS5W::InputEventType::BatteryChanged);
+		ptrEvent->battery.charging = (hidInBuffer[0x35] & 0x08) != 0;
+		ptrEvent->battery.fullyCharged = (hidInBuffer[0x34] & 0x20) != 0;
+		ptrEvent->battery.level = ((hidInBuffer[0x34] & 0x0F) * 100) / 8;
+	}
+
+	memcpy(tracker.lastReport, hidInBuffer, sizeof(tracker.lastReport));
+	return writer.count;
+}
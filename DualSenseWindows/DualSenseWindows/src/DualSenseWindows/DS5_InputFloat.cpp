@@ -0,0 +1,115 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Input.h"
+#include "DS5_Conditioning.h"
+
+#include <emmintrin.h>
+#include <stddef.h>
+
+namespace {
+	// 1/1024 deg/s -> rad/s
+	const float GYRO_TO_RAD_S = 3.14159265358979f / (180.0f * DS_GYRO_RES_PER_DEG_S);
+
+	// 1/8192 g -> m/s^2
+	const float ACCEL_TO_M_S2 = 9.80665f / DS_ACC_RES_PER_G;
+
+	// Integer fields that need no conversion
+	const unsigned int INTEGER_FIELDS = DS5W_ISTATE_FIELD_BUTTONS | DS5W_ISTATE_FIELD_TIME | DS5W_ISTATE_FIELD_BATTERY | DS5W_ISTATE_FIELD_HEADPHONE | DS5W_ISTATE_FIELD_TRIGGER_FEEDBACK;
+
+	// Vector stores below write across these fields
+	static_assert(offsetof(DS5W::DS5InputStateF, rightStick) == offsetof(DS5W::DS5InputStateF, leftStick) + 2 * sizeof(float), "sticks must be consecutive");
+	static_assert(offsetof(DS5W::DS5InputStateF, accelerometer) == offsetof(DS5W::DS5InputStateF, gyroscope) + 3 * sizeof(float), "motion must be consecutive");
+	static_assert(offsetof(DS5W::DS5InputStateF, leftTrigger) == offsetof(DS5W::DS5InputStateF, accelerometer) + 3 * sizeof(float), "triggers must follow motion");
+	static_assert(offsetof(DS5W::DS5InputStateF, rightTrigger) == offsetof(DS5W::DS5InputStateF, leftTrigger) + sizeof(float), "triggers must be consecutive");
+}
+
+void __DS5W::Input::evaluateHidInputBufferF(unsigned char* hidInBuffer, DS5W::DS5InputStateF* ptrInputState, DS5W::DeviceContext* ptrContext)
+{
+	// Integer fields and time tracking are shared with the integer decoder
+	DS5W::DS5InputState state;
+	evaluateHidInputBufferMasked(hidInBuffer, &state, ptrContext, INTEGER_FIELDS);
+
+	ptrInputState->buttonMap = state.buttonMap;
+	ptrInputState->currentTime = state.currentTime;
+	ptrInputState->deltaTime = state.deltaTime;
+	ptrInputState->deltaSeconds = (float)state.deltaTime * (1.0f / DS_SENSOR_TIMESTAMP_PER_SECOND);
+	ptrInputState->hostTimestamp = state.hostTimestamp;
+	ptrInputState->reportGap = state.reportGap;
+	ptrInputState->battery = state.battery;
+	ptrInputState->headPhoneConnected = state.headPhoneConnected;
+	ptrInputState->leftTriggerFeedback = state.leftTriggerFeedback;
+	ptrInputState->rightTriggerFeedback = state.rightTriggerFeedback;
+
+	// Sticks, leftStick and rightStick are 4 consecutive floats
+	const __m128i sticks = _mm_setr_epi32(
+		hidInBuffer[0x00] - 128,
+		127 - hidInBuffer[0x01],
+		hidInBuffer[0x02] - 128,
+		127 - hidInBuffer[0x03]);
+	__m128 sticksF = _mm_mul_ps(_mm_cvtepi32_ps(sticks), _mm_set1_ps(1.0f / 127.0f));
+	sticksF = _mm_min_ps(_mm_max_ps(sticksF, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+	_mm_storeu_ps(&ptrInputState->leftStick.x, sticksF);
+
+	// Motion, gyroscope and accelerometer are 6 consecutive floats followed by both triggers
+	const DS5W::DeviceCalibrationData& calibration = ptrContext->_internal.calibrationData;
+	const short* raw_gyroscope = (short*)&hidInBuffer[0x0F];
+	const short* raw_accelerometer = (short*)&hidInBuffer[0x15];
+
+	const __m128i motionA = _mm_setr_epi32(
+		calibration.gyroscope[0].calibrate(raw_gyroscope[0]),
+		calibration.gyroscope[1].calibrate(raw_gyroscope[1]),
+		calibration.gyroscope[2].calibrate(raw_gyroscope[2]),
+		calibration.accelerometer[0].calibrate(raw_accelerometer[0]));
+	const __m128i motionB = _mm_setr_epi32(
+		calibration.accelerometer[1].calibrate(raw_accelerometer[1]),
+		calibration.accelerometer[2].calibrate(raw_accelerometer[2]),
+		hidInBuffer[0x04],
+		hidInBuffer[0x05]);
+
+	const __m128 scaleA = _mm_setr_ps(GYRO_TO_RAD_S, GYRO_TO_RAD_S, GYRO_TO_RAD_S, ACCEL_TO_M_S2);
+	const __m128 scaleB = _mm_setr_ps(ACCEL_TO_M_S2, ACCEL_TO_M_S2, 1.0f / 255.0f, 1.0f / 255.0f);
+	_mm_storeu_ps(&ptrInputState->gyroscope.x, _mm_mul_ps(_mm_cvtepi32_ps(motionA), scaleA));
+
+	const __m128 motionBF = _mm_mul_ps(_mm_cvtepi32_ps(motionB), scaleB);
+	_mm_storel_pi((__m64*)&ptrInputState->accelerometer.y, motionBF);
+	_mm_storeh_pi((__m64*)&ptrInputState->leftTrigger, motionBF);
+
+	// Deadzones and curves from the configured tables
+	const DS5W::AnalogConditioningTables& conditioning = ptrContext->_internal.conditioning;
+	if (conditioning.enabled) {
+		__DS5W::Conditioning::sticksF(conditioning, hidInBuffer, &ptrInputState->leftStick.x);
+		ptrInputState->leftTrigger = conditioning.trigger[0][hidInBuffer[0x04]];
+		ptrInputState->rightTrigger = conditioning.trigger[1][hidInBuffer[0x05]];
+	}
+
+	// Touch positions of both points in one register
+	const UINT32 touchpad1Raw = *(UINT32*)(&hidInBuffer[0x20]);
+	const UINT32 touchpad2Raw = *(UINT32*)(&hidInBuffer[0x24]);
+	const __m128i touchRaw = _mm_setr_epi32(touchpad1Raw, touchpad1Raw, touchpad2Raw, touchpad2Raw);
+
+	// x is bits 8-19, y is bits 20-31
+	const __m128i touch = _mm_or_si128(
+		_mm_and_si128(_mm_srli_epi32(touchRaw, 8), _mm_setr_epi32(0xFFF, 0, 0xFFF, 0)),
+		_mm_and_si128(_mm_srli_epi32(touchRaw, 20), _mm_setr_epi32(0, 0xFFF, 0, 0xFFF)));
+	const __m128 touchScale = _mm_setr_ps(
+		1.0f / (DS_TOUCHPAD_WIDTH - 1), 1.0f / (DS_TOUCHPAD_HEIGHT - 1),
+		1.0f / (DS_TOUCHPAD_WIDTH - 1), 1.0f / (DS_TOUCHPAD_HEIGHT - 1));
+
+	alignas(16) float touchF[4];
+	_mm_store_ps(touchF, _mm_min_ps(_mm_mul_ps(_mm_cvtepi32_ps(touch), touchScale), _mm_set1_ps(1.0f)));
+
+	ptrInputState->touchPoint1.x = touchF[0];
+	ptrInputState->touchPoint1.y = touchF[1];
+	ptrInputState->touchPoint1.down = (touchpad1Raw & (1 << 7)) == 0;
+	ptrInputState->touchPoint1.id = (touchpad1Raw & 127);
+
+	ptrInputState->touchPoint2.x = touchF[2];
+	ptrInputState->touchPoint2.y = touchF[3];
+	ptrInputState->touchPoint2.down = (touchpad2Raw & (1 << 7)) == 0;
+	ptrInputState->touchPoint2.id = (touchpad2Raw & 127);
+}
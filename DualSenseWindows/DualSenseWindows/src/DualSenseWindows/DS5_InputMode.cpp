@@ -0,0 +1,110 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_InputMode.h"
+#include "DS5_Internal.h"
+
+#include <Windows.h>
+#include <hidsdi.h>
+
+namespace {
+	void resetStatistics(DS5W::InputModeState& inputMode)
+	{
+		inputMode.skipped = 0;
+		inputMode.drained = 0;
+		inputMode.drains = 0;
+		inputMode.largestDrain = 0;
+	}
+}
+
+void __DS5W::InputMode::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputModeState& inputMode = ptrContext->_internal.inputMode;
+
+	inputMode.mode = DS5W::InputMode::Flush;
+	inputMode.queueLength = SYSTEM_QUEUE_LENGTH;
+	resetStatistics(inputMode);
+}
+
+DS5W_ReturnValue __DS5W::InputMode::set(DS5W::DeviceContext* ptrContext, DS5W::InputMode mode, unsigned int queueLength)
+{
+	DS5W::InputModeState& inputMode = ptrContext->_internal.inputMode;
+
+	switch (mode) {
+	case DS5W::InputMode::Flush:
+		queueLength = SYSTEM_QUEUE_LENGTH;
+		break;
+
+	// Windows does not accept a queue of one, the read takes the older of the two
+	case DS5W::InputMode::LatestOnly:
+		queueLength = DS5W_INPUT_QUEUE_MIN;
+		break;
+
+	case DS5W::InputMode::EveryReport:
+		if (queueLength == 0)
+			queueLength = DS5W_INPUT_QUEUE_DEFAULT;
+		if (queueLength < DS5W_INPUT_QUEUE_MIN || queueLength > DS5W_INPUT_QUEUE_MAX)
+			return DS5W_E_INVALID_ARGS;
+		break;
+
+	default:
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	inputMode.mode = mode;
+	inputMode.queueLength = queueLength;
+	resetStatistics(inputMode);
+
+	// Set on reconnect otherwise
+	if (!ptrContext->_internal.connected)
+		return DS5W_OK;
+
+	return apply(ptrContext);
+}
+
+DS5W_ReturnValue __DS5W::InputMode::apply(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputModeState& inputMode = ptrContext->_internal.inputMode;
+
+	if (!HidD_SetNumInputBuffers(ptrContext->_internal.deviceHandle, inputMode.queueLength))
+		return DS5W::convertSystemErrorCode(GetLastError());
+
+	// Reports queued under the previous mode are not wanted by the new one
+	HidD_FlushQueue(ptrContext->_internal.deviceHandle);
+
+	return DS5W_OK;
+}
+
+void __DS5W::InputMode::onInputReport(DS5W::DeviceContext* ptrContext)
+{
+	ptrContext->_internal.inputMode.skipped += ptrContext->_internal.reportSequence.lastGap;
+}
+
+void __DS5W::InputMode::onDrain(DS5W::DeviceContext* ptrContext, unsigned int reportCount)
+{
+	DS5W::InputModeState& inputMode = ptrContext->_internal.inputMode;
+
+	if (reportCount == 0)
+		return;
+
+	inputMode.drained += reportCount;
+	inputMode.drains++;
+	if (reportCount > inputMode.largestDrain)
+		inputMode.largestDrain = reportCount;
+}
+
+void __DS5W::InputMode::getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputModeStatistics* ptrStatistics)
+{
+	DS5W::InputModeState& inputMode = ptrContext->_internal.inputMode;
+
+	ptrStatistics->skipped = inputMode.skipped;
+	ptrStatistics->drained = inputMode.drained;
+	ptrStatistics->drains = inputMode.drains;
+	ptrStatistics->largestDrain = inputMode.largestDrain;
+	ptrStatistics->queueLength = inputMode.queueLength;
+	ptrStatistics->mode = inputMode.mode;
+}
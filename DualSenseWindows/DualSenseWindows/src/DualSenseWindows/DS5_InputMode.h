@@ -0,0 +1,60 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace InputMode {
+		/// <summary>
+		/// HID queue length Windows gives a newly opened device, restored by the flush mode
+		/// </summary>
+		const unsigned int SYSTEM_QUEUE_LENGTH = 32;
+
+		/// <summary>
+		/// Prepare the input mode of a new context, reads flush the queue
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Change the input mode and set the HID queue length it needs
+		/// </summary>
+		/// <param name="queueLength">Queue length of EveryReport, 0 for DS5W_INPUT_QUEUE_DEFAULT</param>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue set(DS5W::DeviceContext* ptrContext, DS5W::InputMode mode, unsigned int queueLength);
+
+		/// <summary>
+		/// Set the queue length of the current mode again, after the device handle was opened
+		/// </summary>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue apply(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Whether reads flush the HID queue first
+		/// </summary>
+		inline bool flushesQueue(DS5W::DeviceContext* ptrContext) {
+			return ptrContext->_internal.inputMode.mode == DS5W::InputMode::Flush;
+		}
+
+		/// <summary>
+		/// Count the reports missed before a newly read report
+		/// </summary>
+		void onInputReport(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Count the reports returned by one drain
+		/// </summary>
+		void onDrain(DS5W::DeviceContext* ptrContext, unsigned int reportCount);
+
+		/// <summary>
+		/// Copy the input mode counters
+		/// </summary>
+		void getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputModeStatistics* ptrStatistics);
+	}
+}
@@ -0,0 +1,248 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_InputPipeline.h"
+#include "DS5_Internal.h"
+#include "DS5_HID.h"
+
+#include <Windows.h>
+#include <hidsdi.h>
+#include <string.h>
+
+namespace {
+	// Start the read of one slot
+	DS5W_ReturnValue post(DS5W::DeviceContext* ptrContext, unsigned int slot)
+	{
+		DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+
+		pipeline.buffers[slot][0] = ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT ? DS_INPUT_REPORT_BT : DS_INPUT_REPORT_USB;
+
+		ResetEvent(pipeline.overlapped[slot].hEvent);
+		BOOL res = ReadFile(
+			ptrContext->_internal.deviceHandle,
+			pipeline.buffers[slot],
+			pipeline.reportLen,
+			NULL,
+			&pipeline.overlapped[slot]);
+
+		// Reads finished right away still signal the overlapped struct
+		if (!res) {
+			DWORD err = GetLastError();
+			if (err != ERROR_IO_PENDING) {
+				return DS5W::convertSystemErrorCode(err);
+			}
+		}
+
+		pipeline.posted[slot] = true;
+		return DS5W_OK;
+	}
+
+	// Cancel the read of one slot and wait until the driver let go of its buffer
+	void settle(DS5W::DeviceContext* ptrContext, unsigned int slot)
+	{
+		DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+		if (!pipeline.posted[slot])
+			return;
+
+		DWORD bytes;
+		CancelIoEx(ptrContext->_internal.deviceHandle, &pipeline.overlapped[slot]);
+		GetOverlappedResult(ptrContext->_internal.deviceHandle, &pipeline.overlapped[slot], &bytes, TRUE);
+		pipeline.posted[slot] = false;
+	}
+
+	void resetStatistics(DS5W::InputPipelineState& pipeline)
+	{
+		pipeline.reports = 0;
+		pipeline.readyReports = 0;
+		pipeline.failed = 0;
+		pipeline.waitTotal = 0;
+		pipeline.waitMax = 0;
+	}
+}
+
+void __DS5W::InputPipeline::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+
+	memset(pipeline.overlapped, 0, sizeof(pipeline.overlapped));
+	for (unsigned int i = 0; i < DS5W_INPUT_PIPELINE_MAX_DEPTH; i++) {
+		pipeline.posted[i] = false;
+	}
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	pipeline.hostFrequency = frequency.QuadPart;
+
+	pipeline.depth = 0;
+	pipeline.next = 0;
+	pipeline.reportLen = 0;
+	pipeline.taken = false;
+	resetStatistics(pipeline);
+}
+
+DS5W_ReturnValue __DS5W::InputPipeline::setDepth(DS5W::DeviceContext* ptrContext, unsigned int depth)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+
+	release(ptrContext);
+
+	if (depth == 0)
+		return DS5W_OK;
+
+	for (unsigned int i = 0; i < depth; i++) {
+		memset(&pipeline.overlapped[i], 0, sizeof(OVERLAPPED));
+		pipeline.overlapped[i].hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (!pipeline.overlapped[i].hEvent) {
+			pipeline.depth = i;
+			release(ptrContext);
+			return DS5W_E_EXTERNAL_WINAPI;
+		}
+	}
+
+	pipeline.depth = depth;
+	resetStatistics(pipeline);
+
+	// Posted on reconnect otherwise
+	if (!ptrContext->_internal.connected)
+		return DS5W_OK;
+
+	return restart(ptrContext);
+}
+
+DS5W_ReturnValue __DS5W::InputPipeline::restart(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+
+	cancel(ptrContext);
+
+	pipeline.next = 0;
+	pipeline.taken = false;
+	pipeline.reportLen = ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT ? DS_INPUT_REPORT_BT_SIZE : DS_INPUT_REPORT_USB_SIZE;
+
+	// Reports queued by the driver while nothing was posted are old
+	HidD_FlushQueue(ptrContext->_internal.deviceHandle);
+
+	for (unsigned int i = 0; i < pipeline.depth; i++) {
+		DS5W_ReturnValue err = post(ptrContext, i);
+		if (DS5W_FAILED(err)) {
+			cancel(ptrContext);
+			return err;
+		}
+	}
+
+	return DS5W_OK;
+}
+
+void __DS5W::InputPipeline::cancel(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+
+	for (unsigned int i = 0; i < pipeline.depth; i++) {
+		settle(ptrContext, i);
+	}
+}
+
+void __DS5W::InputPipeline::release(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+
+	cancel(ptrContext);
+
+	for (unsigned int i = 0; i < pipeline.depth; i++) {
+		CloseHandle(pipeline.overlapped[i].hEvent);
+		pipeline.overlapped[i].hEvent = NULL;
+	}
+
+	pipeline.depth = 0;
+	pipeline.next = 0;
+	pipeline.taken = false;
+}
+
+DS5W_ReturnValue __DS5W::InputPipeline::take(DS5W::DeviceContext* ptrContext, int waitTime)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+	const unsigned int slot = pipeline.next;
+
+	// Read failed to post earlier, try again
+	if (!pipeline.posted[slot]) {
+		DS5W_ReturnValue err = post(ptrContext, slot);
+		if (DS5W_FAILED(err)) {
+			pipeline.failed++;
+			return err;
+		}
+	}
+
+	const bool ready = HasOverlappedIoCompleted(&pipeline.overlapped[slot]) != FALSE;
+
+	LARGE_INTEGER start, end;
+	QueryPerformanceCounter(&start);
+
+	DWORD err = DS5W::AwaitOverlappedTimeout(
+		ptrContext->_internal.deviceHandle,
+		&pipeline.overlapped[slot],
+		waitTime);
+
+	QueryPerformanceCounter(&end);
+
+	// Slot was cancelled on failure and is posted again behind the others
+	if (err) {
+		settle(ptrContext, slot);
+		pipeline.next = (slot + 1) % pipeline.depth;
+		pipeline.failed++;
+		post(ptrContext, slot);
+		return DS5W::convertSystemErrorCode(err);
+	}
+
+	// Decoders read the context's input buffer
+	memcpy(ptrContext->_internal.hidInBuffer, pipeline.buffers[slot], pipeline.reportLen);
+	pipeline.posted[slot] = false;
+	pipeline.next = (slot + 1) % pipeline.depth;
+
+	const unsigned long long wait = (unsigned long long)(end.QuadPart - start.QuadPart);
+	pipeline.reports++;
+	if (ready)
+		pipeline.readyReports++;
+	pipeline.waitTotal += wait;
+	if (wait > pipeline.waitMax)
+		pipeline.waitMax = wait;
+
+	// A failed post is retried when the slot comes round again
+	post(ptrContext, slot);
+
+	return DS5W_OK;
+}
+
+DS5W_ReturnValue __DS5W::InputPipeline::poll(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+	const unsigned int slot = pipeline.next;
+
+	// Read failed to post earlier, a report arrives with the next poll at the earliest
+	if (!pipeline.posted[slot]) {
+		DS5W_ReturnValue err = post(ptrContext, slot);
+		return DS5W_FAILED(err) ? err : DS5W_E_IO_PENDING;
+	}
+
+	if (!HasOverlappedIoCompleted(&pipeline.overlapped[slot]))
+		return DS5W_E_IO_PENDING;
+
+	return take(ptrContext, 0);
+}
+
+void __DS5W::InputPipeline::getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputPipelineStatistics* ptrStatistics)
+{
+	DS5W::InputPipelineState& pipeline = ptrContext->_internal.inputPipeline;
+
+	const double microsecondsPerTick = 1000000.0 / (double)pipeline.hostFrequency;
+
+	ptrStatistics->reports = pipeline.reports;
+	ptrStatistics->readyReports = pipeline.readyReports;
+	ptrStatistics->failed = pipeline.failed;
+	ptrStatistics->averageWaitMicroseconds = pipeline.reports ? (double)pipeline.waitTotal / (double)pipeline.reports * microsecondsPerTick : 0.0;
+	ptrStatistics->maxWaitMicroseconds = (double)pipeline.waitMax * microsecondsPerTick;
+	ptrStatistics->depth = pipeline.depth;
+}
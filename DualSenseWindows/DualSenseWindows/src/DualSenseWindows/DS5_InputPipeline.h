@@ -0,0 +1,62 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace InputPipeline {
+		/// <summary>
+		/// Prepare the pipeline state of a new context, reads stay one at a time
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Change the number of reads kept posted, 0 goes back to one read at a time
+		/// Reads are posted right away if the device is connected
+		/// </summary>
+		/// <returns>Error code of posting the reads</returns>
+		DS5W_ReturnValue setDepth(DS5W::DeviceContext* ptrContext, unsigned int depth);
+
+		/// <summary>
+		/// Post every read of the ring again, after the device handle was opened
+		/// </summary>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue restart(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Cancel posted reads and wait until the driver released their buffers
+		/// Must be called while the device handle is still open
+		/// </summary>
+		void cancel(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Cancel posted reads and free the events, the depth becomes 0
+		/// </summary>
+		void release(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Wait for the oldest read, copy its report to the input buffer and post the read again
+		/// </summary>
+		/// <param name="waitTime">Maximum time to wait in milliseconds</param>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue take(DS5W::DeviceContext* ptrContext, int waitTime);
+
+		/// <summary>
+		/// Take the oldest read only if it already completed
+		/// </summary>
+		/// <returns>DS5W_E_IO_PENDING if no report is waiting</returns>
+		DS5W_ReturnValue poll(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Copy the pipeline counters
+		/// </summary>
+		void getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputPipelineStatistics* ptrStatistics);
+	}
+}
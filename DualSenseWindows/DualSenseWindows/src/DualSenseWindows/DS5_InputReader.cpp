@@ -0,0 +1,122 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_InputReader.h"
+#include "DS5_Internal.h"
+#include "DS5_Input.h"
+#include "DS5_LatestInput.h"
+#include "DS5_ReportQueue.h"
+
+#include <Windows.h>
+
+namespace {
+	DWORD WINAPI readerThread(LPVOID param)
+	{
+		DS5W::DeviceContext* ptrContext = (DS5W::DeviceContext*)param;
+		DS5W::InputReaderState& reader = ptrContext->_internal.inputReader;
+
+		const bool bt = ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT;
+		const USHORT reportLen = bt ? DS_INPUT_REPORT_BT_SIZE : DS_INPUT_REPORT_USB_SIZE;
+		unsigned char* report = __DS5W::Input::heldReportBody(ptrContext);
+
+		DS5W::DS5InputState state;
+		bool removed = false;
+
+		// Device sends reports every few milliseconds, so stopping waits at most for one read
+		while (!reader.stopRequested) {
+			ptrContext->_internal.hidInBuffer[0] = bt ? DS_INPUT_REPORT_BT : DS_INPUT_REPORT_USB;
+			DS5W_ReturnValue err = DS5W::getInputReport(ptrContext, reportLen, IO_TIMEOUT_MILLISECONDS);
+
+			if (err == DS5W_E_DEVICE_REMOVED) {
+				removed = true;
+				break;
+			}
+
+			if (DS5W_FAILED(err)) {
+				InterlockedIncrement64(&reader.failed);
+
+				// Only timeouts wait on their own
+				if (err != DS5W_E_IO_TIMEDOUT)
+					Sleep(1);
+				continue;
+			}
+
+			// Input buffer, orientation and touch tracking belong to this thread while it runs
+			__DS5W::Input::decodeReport(ptrContext, report, &state);
+
+			__DS5W::LatestInput::publish(ptrContext, &state);
+
+			// Consumers needing every report pop them from the queue
+			if (ptrContext->_internal.reportQueue.enabled)
+				__DS5W::ReportQueue::push(ptrContext, &state);
+		}
+
+		// Disconnecting is left to the threads using the context
+		InterlockedExchange(&reader.deviceRemoved, removed ? TRUE : FALSE);
+		InterlockedExchange(&reader.running, FALSE);
+
+		return 0;
+	}
+}
+
+void __DS5W::InputReader::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputReaderState& reader = ptrContext->_internal.inputReader;
+
+	reader.thread = NULL;
+	reader.stopRequested = FALSE;
+	reader.failed = 0;
+	reader.running = FALSE;
+	reader.deviceRemoved = FALSE;
+}
+
+DS5W_ReturnValue __DS5W::InputReader::start(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputReaderState& reader = ptrContext->_internal.inputReader;
+
+	stop(ptrContext);
+
+	// Thread is not running yet, no interlocked access needed
+	reader.stopRequested = FALSE;
+	reader.failed = 0;
+	reader.running = TRUE;
+	reader.deviceRemoved = FALSE;
+
+	// Latest state starts with the reader's first report
+	__DS5W::LatestInput::reset(ptrContext);
+
+	reader.thread = CreateThread(NULL, 0, readerThread, ptrContext, 0, NULL);
+	if (!reader.thread) {
+		reader.running = FALSE;
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	return DS5W_OK;
+}
+
+void __DS5W::InputReader::stop(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::InputReaderState& reader = ptrContext->_internal.inputReader;
+	if (!reader.thread)
+		return;
+
+	InterlockedExchange(&reader.stopRequested, TRUE);
+	WaitForSingleObject(reader.thread, INFINITE);
+
+	CloseHandle(reader.thread);
+	reader.thread = NULL;
+}
+
+bool __DS5W::InputReader::running(DS5W::DeviceContext* ptrContext)
+{
+	return ptrContext->_internal.inputReader.running != FALSE;
+}
+
+bool __DS5W::InputReader::deviceRemoved(DS5W::DeviceContext* ptrContext)
+{
+	return ptrContext->_internal.inputReader.deviceRemoved != FALSE;
+}
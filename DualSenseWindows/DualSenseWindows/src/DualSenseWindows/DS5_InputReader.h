@@ -0,0 +1,41 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace InputReader {
+		/// <summary>
+		/// Prepare the reader state of a new context
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Start the reader thread, stopping a running one first
+		/// </summary>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue start(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Stop the reader thread after its current read. Does nothing if not started
+		/// </summary>
+		void stop(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Whether the reader thread owns input reads, other input reads must not be started
+		/// </summary>
+		bool running(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Whether the reader stopped itself as the device was removed
+		/// </summary>
+		bool deviceRemoved(DS5W::DeviceContext* ptrContext);
+	}
+}
@@ -0,0 +1,96 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Input.h"
+
+namespace {
+	// Weight of a new sample in the report interval average, as a shift
+	const int INTERVAL_SMOOTHING_SHIFT = 3;
+}
+
+void __DS5W::Input::restartReportSequence(DS5W::DeviceContext* ptrContext)
+{
+	ptrContext->_internal.reportSequence.valid = false;
+	ptrContext->_internal.reportSequence.lastGap = 0;
+}
+
+void __DS5W::Input::resetReportStatistics(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::ReportSequenceState& sequence = ptrContext->_internal.reportSequence;
+	sequence.received = 0;
+	sequence.lost = 0;
+	sequence.duplicated = 0;
+	sequence.largestGap = 0;
+	sequence.reportInterval = 0;
+}
+
+void __DS5W::Input::trackReportSequence(const unsigned char* hidInBuffer, DS5W::DeviceContext* ptrContext)
+{
+	DS5W::ReportSequenceState& sequence = ptrContext->_internal.reportSequence;
+	const unsigned char sequenceNumber = hidInBuffer[0x06];
+	const unsigned int timestamp = *(unsigned int*)&hidInBuffer[0x1B];
+
+	sequence.received++;
+
+	// First report after connecting has nothing to compare to
+	if (!sequence.valid) {
+		sequence.lastSequence = sequenceNumber;
+		sequence.lastTimestamp = timestamp;
+		sequence.lastGap = 0;
+		sequence.valid = true;
+		return;
+	}
+
+	// Modular differences handle wraparound of both counters
+	const unsigned int steps = (unsigned char)(sequenceNumber - sequence.lastSequence);
+	const unsigned int deltaTime = timestamp - sequence.lastTimestamp;
+
+	// Same report read twice, the held report keeps its gap
+	if (steps == 0 && deltaTime == 0) {
+		sequence.duplicated++;
+		return;
+	}
+
+	// A new report with the same counter value means a whole turn of the counter went by
+	const unsigned int sequenceSteps = steps ? steps : 256;
+	unsigned int gap = sequenceSteps - 1;
+
+	// The 8 bit counter cannot show gaps longer than 255 reports, the timestamp can
+	if (sequence.reportInterval) {
+		const unsigned int timeSteps = (deltaTime + sequence.reportInterval / 2) / sequence.reportInterval;
+		if (timeSteps > sequenceSteps) {
+			// Whole turns of the counter closest to the timestamp gap
+			gap += ((timeSteps - sequenceSteps + 128) / 256) * 256;
+		}
+	}
+
+	// Consecutive reports measure the interval the device sends at
+	if (sequenceSteps == 1) {
+		if (sequence.reportInterval)
+			sequence.reportInterval = (unsigned int)((int)sequence.reportInterval + (((int)deltaTime - (int)sequence.reportInterval) >> INTERVAL_SMOOTHING_SHIFT));
+		else
+			sequence.reportInterval = deltaTime;
+	}
+
+	sequence.lost += gap;
+	sequence.lastGap = gap;
+	if (gap > sequence.largestGap)
+		sequence.largestGap = gap;
+
+	sequence.lastSequence = sequenceNumber;
+	sequence.lastTimestamp = timestamp;
+}
+
+void __DS5W::Input::getReportStatistics(const DS5W::DeviceContext* ptrContext, DS5W::DS5ReportStatistics* ptrStatistics)
+{
+	const DS5W::ReportSequenceState& sequence = ptrContext->_internal.reportSequence;
+	ptrStatistics->received = sequence.received;
+	ptrStatistics->lost = sequence.lost;
+	ptrStatistics->duplicated = sequence.duplicated;
+	ptrStatistics->largestGap = sequence.largestGap;
+	ptrStatistics->reportInterval = sequence.reportInterval;
+}
@@ -12,7 +12,15 @@
 #include <DualSenseWindows/DS_CRC32.h>
 #include <DualSenseWindows/DS5_HID.h>
 #include <DualSenseWindows/DS5_Input.h>
+#include <DualSenseWindows/DS5_Clock.h>
 #include <DualSenseWindows/DS5_Output.h>
+#include <DualSenseWindows/DS5_OutputWriter.h>
+#include <DualSenseWindows/DS5_Haptics.h>
+#include <DualSenseWindows/DS5_OutputTimeline.h>
+#include <DualSenseWindows/DS5_InputPipeline.h>
+#include <DualSenseWindows/DS5_InputMode.h>
+#include <DualSenseWindows/DS5_InputReader.h>
+#include <DualSenseWindows/InputEngine.h>
 
 #include <MurmurHash3/MurmurHash3.h>
 
@@ -39,6 +47,9 @@ DS5W_ReturnValue DS5W::disableAllDeviceFeatures(DS5W::DeviceContext* ptrContext)
 	// Get output report length and build buffer
 	int outputReportLength = __DS5W::Output::createHIDOutputReportDisabled(ptrContext);
 
+	// Device no longer has the last output state
+	__DS5W::Output::forgetLastOutput(ptrContext);
+
 	// Write to controller
 	DS5W_RV err = setOutputReport(ptrContext, outputReportLength, IO_TIMEOUT_MILLISECONDS);
 
@@ -50,10 +61,23 @@ DS5W_ReturnValue DS5W::disableAllDeviceFeatures(DS5W::DeviceContext* ptrContext)
 
 void DS5W::disconnectDevice(DS5W::DeviceContext* ptrContext)
 {
+	// Threads must be done with the handle before it is closed
+	// Timeline first, it hands reports to the writer
+	if (ptrContext->_internal.inputEngine.engine) {
+		detachInputEngine(ptrContext);
+	}
+	__DS5W::InputReader::stop(ptrContext);
+	__DS5W::OutputTimeline::stop(ptrContext);
+	__DS5W::OutputWriter::stop(ptrContext);
+	__DS5W::Haptics::stop(ptrContext);
+
 	// Prevent further API IO calls by marking disconnected
 	// internal IO calls are still allowed
 	ptrContext->_internal.connected = false;
 
+	// Posted reads write into the context until the driver returns them
+	__DS5W::InputPipeline::cancel(ptrContext);
+
 	// Ensure no outstanding IO calls
 	CancelIoEx(ptrContext->_internal.deviceHandle, NULL);
 
@@ -137,6 +161,7 @@ DS5W_ReturnValue DS5W::getInitialTimestamp(DS5W::DeviceContext* ptrContext)
 		currentTime = *(unsigned int*)&ptrContext->_internal.hidInBuffer[0x1B + 1]; // USB buffer is offset by 1
 	}
 	ptrContext->_internal.timestamp = currentTime;
+	ptrContext->_internal.deltaTime = 0;
 
 	// OK
 	return DS5W_OK;
@@ -144,6 +169,15 @@ DS5W_ReturnValue DS5W::getInitialTimestamp(DS5W::DeviceContext* ptrContext)
 
 DS5W_ReturnValue DS5W::getInputReport(DS5W::DeviceContext* ptrContext, USHORT reportLen, int waitTime)
 {
+	// Take the next report from the posted reads instead of starting a new one
+	if (ptrContext->_internal.inputPipeline.depth) {
+		DS5W_ReturnValue err = __DS5W::InputPipeline::take(ptrContext, waitTime);
+		if (DS5W_SUCCESS(err)) {
+			inputReportReceived(ptrContext);
+		}
+		return err;
+	}
+
 	DS5W_ReturnValue res = startInputRequest(ptrContext, reportLen);
 
 	// result could have failed, or be running async
@@ -166,6 +200,9 @@ DS5W_ReturnValue DS5W::getInputReport(DS5W::DeviceContext* ptrContext, USHORT re
 		}
 	}
 
+	// Record arrival time while it is still accurate
+	inputReportReceived(ptrContext);
+
 	// OK
 	return DS5W_OK;
 }
@@ -201,9 +238,10 @@ DS5W_ReturnValue DS5W::setOutputReport(DS5W::DeviceContext* ptrContext, USHORT r
 DS5W_ReturnValue DS5W::startInputRequest(DS5W::DeviceContext* ptrContext, USHORT reportLen)
 {
 	// Get the most recent package
-	// This maybe should be removed? 
-	// It increases average BT waiting time by 25%
-	HidD_FlushQueue(ptrContext->_internal.deviceHandle);
+	// It increases average BT waiting time by 25%, the other input modes keep queued reports instead
+	if (__DS5W::InputMode::flushesQueue(ptrContext)) {
+		HidD_FlushQueue(ptrContext->_internal.deviceHandle);
+	}
 
 	// Start an overlapped read
 	ResetEvent(ptrContext->_internal.olRead.hEvent);
@@ -270,4 +308,53 @@ DS5W_ReturnValue DS5W::awaitIORequest(DS5W::DeviceContext* ptrContext, LPOVERLAP
 
 	// OK
 	return DS5W_OK;
-}
\ No newline at end of file
+}
+
+void DS5W::inputReportReceived(DS5W::DeviceContext* ptrContext)
+{
+	// Receive time for the clock model, before anything else delays it
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	__DS5W::Clock::onInputReport(ptrContext, now.QuadPart);
+
+	__DS5W::Input::trackReportSequence(__DS5W::Input::heldReportBody(ptrContext), ptrContext);
+	__DS5W::InputMode::onInputReport(ptrContext);
+}
+
+bool DS5W::inputReadsOwned(DS5W::DeviceContext* ptrContext)
+{
+	return __DS5W::InputReader::running(ptrContext) || ptrContext->_internal.inputEngine.engine != NULL;
+}
+
+DS5W_ReturnValue DS5W::pollInputReport(DS5W::DeviceContext* ptrContext, USHORT reportLen)
+{
+	DS5W_ReturnValue res;
+
+	if (ptrContext->_internal.inputPipeline.depth) {
+		res = __DS5W::InputPipeline::poll(ptrContext);
+	}
+	else {
+		res = startInputRequest(ptrContext, reportLen);
+
+		// Nothing was queued, take the read back
+		if (res == DS5W_E_IO_PENDING) {
+			DWORD bytes;
+			CancelIoEx(ptrContext->_internal.deviceHandle, &ptrContext->_internal.olRead);
+
+			// A report may have arrived before the cancel
+			if (GetOverlappedResult(ptrContext->_internal.deviceHandle, &ptrContext->_internal.olRead, &bytes, TRUE)) {
+				res = DS5W_OK;
+			}
+			else {
+				DWORD err = GetLastError();
+				res = err == ERROR_OPERATION_ABORTED ? DS5W_E_IO_PENDING : convertSystemErrorCode(err);
+			}
+		}
+	}
+
+	if (DS5W_SUCCESS(res)) {
+		inputReportReceived(ptrContext);
+	}
+
+	return res;
+}
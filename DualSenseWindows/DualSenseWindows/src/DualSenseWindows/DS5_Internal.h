@@ -54,6 +54,27 @@ namespace DS5W {
 	/// <returns>Error code</returns>
 	DS5W_ReturnValue getInputReport(DS5W::DeviceContext* ptrContext, USHORT reportLen, int waitTime);
 
+	/// <summary>
+	/// Get an input report only if one is already queued, never waits for the device
+	/// </summary>
+	/// <param name="ptrContext">Device to read from</param>
+	/// <param name="reportLen">Size of input report</param>
+	/// <returns>DS5W_E_IO_PENDING if no report was queued, else error code</returns>
+	DS5W_ReturnValue pollInputReport(DS5W::DeviceContext* ptrContext, USHORT reportLen);
+
+	/// <summary>
+	/// Whether the input reader or an input engine reads the device, input must not be read on the calling thread then
+	/// </summary>
+	/// <param name="ptrContext">Device to check</param>
+	bool inputReadsOwned(DS5W::DeviceContext* ptrContext);
+
+	/// <summary>
+	/// Stop the input engine reading a device that is being disconnected
+	/// From the engine callback the device is marked removed and the engine drops it once the callback returned
+	/// </summary>
+	/// <param name="ptrContext">Device registered with an engine</param>
+	void detachInputEngine(DS5W::DeviceContext* ptrContext);
+
 	/// <summary>
 	/// Parse an output state into an output report and send to the device synchronously by calling the needed async functions internally
 	/// </summary>
@@ -90,4 +111,10 @@ namespace DS5W {
 	/// <param name="waitTime">Maximum time to wait</param>
 	/// <returns>Error code</returns>
 	DS5W_ReturnValue awaitIORequest(DS5W::DeviceContext* ptrContext, LPOVERLAPPED ol, int waitTime);
+
+	/// <summary>
+	/// Per report bookkeeping (clock sync, lost report counting) of a read that just completed
+	/// </summary>
+	/// <param name="ptrContext">Device that was read from</param>
+	void inputReportReceived(DS5W::DeviceContext* ptrContext);
 }
\ No newline at end of file
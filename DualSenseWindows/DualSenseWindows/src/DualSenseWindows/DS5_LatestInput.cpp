@@ -0,0 +1,83 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_LatestInput.h"
+#include "DS5_Motion.h"
+#include "DS5_Touch.h"
+
+#include <Windows.h>
+
+namespace {
+	// Copy the trackers into the published state, sequence odd or no thread decoding
+	void copyTrackers(DS5W::DeviceContext* ptrContext)
+	{
+		DS5W::LatestInputState& latest = ptrContext->_internal.latestInput;
+		__DS5W::Motion::getMotionState(ptrContext, &latest.motion);
+		__DS5W::Touch::getTouchState(ptrContext, &latest.touch);
+	}
+
+	// Reader side of the sequence lock, retries only while a state is being published
+	// Volatile reads have acquire semantics with MSVC, the barrier keeps the copy before the second read
+	template <typename T>
+	LONG readPublished(const DS5W::LatestInputState& latest, const T& published, T* ptrCopy)
+	{
+		for (;;) {
+			const LONG before = latest.sequence;
+			if (before & 1) {
+				YieldProcessor();
+				continue;
+			}
+
+			*ptrCopy = published;
+			MemoryBarrier();
+
+			if (latest.sequence == before)
+				return before;
+		}
+	}
+}
+
+void __DS5W::LatestInput::reset(DS5W::DeviceContext* ptrContext)
+{
+	InterlockedExchange(&ptrContext->_internal.latestInput.sequence, 0);
+	copyTrackers(ptrContext);
+}
+
+// Writer side of the sequence lock
+// Interlocked increments are full barriers, readers see an odd sequence while the copy is in progress
+void __DS5W::LatestInput::publish(DS5W::DeviceContext* ptrContext, const DS5W::DS5InputState* ptrInputState)
+{
+	DS5W::LatestInputState& latest = ptrContext->_internal.latestInput;
+
+	InterlockedIncrement(&latest.sequence);
+	latest.input = *ptrInputState;
+	copyTrackers(ptrContext);
+	InterlockedIncrement(&latest.sequence);
+}
+
+bool __DS5W::LatestInput::read(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int* ptrVersion)
+{
+	DS5W::LatestInputState& latest = ptrContext->_internal.latestInput;
+	const LONG before = readPublished(latest, latest.input, ptrInputState);
+
+	if (ptrVersion)
+		*ptrVersion = (unsigned int)before / 2;
+
+	return before != 0;
+}
+
+void __DS5W::LatestInput::readMotion(DS5W::DeviceContext* ptrContext, DS5W::DS5MotionState* ptrMotionState)
+{
+	DS5W::LatestInputState& latest = ptrContext->_internal.latestInput;
+	readPublished(latest, latest.motion, ptrMotionState);
+}
+
+void __DS5W::LatestInput::readTouch(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchState* ptrTouchState)
+{
+	DS5W::LatestInputState& latest = ptrContext->_internal.latestInput;
+	readPublished(latest, latest.touch, ptrTouchState);
+}
@@ -0,0 +1,44 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace LatestInput {
+		/// <summary>
+		/// Forget the published state, used when input starts being read by the input reader or an input engine
+		/// Orientation and touch contacts are copied from the trackers, only call while no thread decodes reports
+		/// </summary>
+		void reset(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Publish a decoded input state with the orientation and touch contacts it moved the trackers to
+		/// Only called by the one thread owning input reads
+		/// </summary>
+		void publish(DS5W::DeviceContext* ptrContext, const DS5W::DS5InputState* ptrInputState);
+
+		/// <summary>
+		/// Copy the last published input state, never blocks or enters the kernel
+		/// </summary>
+		/// <param name="ptrVersion">Optional, receives the number of states published since the last reset</param>
+		/// <returns>False if nothing was published yet</returns>
+		bool read(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int* ptrVersion);
+
+		/// <summary>
+		/// Copy the orientation published with the last input state, never blocks or enters the kernel
+		/// </summary>
+		void readMotion(DS5W::DeviceContext* ptrContext, DS5W::DS5MotionState* ptrMotionState);
+
+		/// <summary>
+		/// Copy the touch contacts published with the last input state, never blocks or enters the kernel
+		/// </summary>
+		void readTouch(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchState* ptrTouchState);
+	}
+}
@@ -0,0 +1,290 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Motion.h"
+#include "DS5_Input.h"
+
+#include <emmintrin.h>
+#include <math.h>
+
+namespace {
+	// 1/1024 deg/s -> rad/s
+	const float GYRO_TO_RAD_S = 3.14159265358979f / (180.0f * DS_GYRO_RES_PER_DEG_S);
+
+	// Longest step integrated at once, longer gaps (stalls, reconnects) would only add gyro error
+	const float MAX_DELTA_SECONDS = 0.1f;
+
+	/// <summary>
+	/// Motion sensor values of one input report
+	/// </summary>
+	struct MotionSample {
+		float gyro[3];
+		float accel[3];
+		float dt;
+	};
+
+	// Orientation that maps the measured gravity direction onto world up
+	void initializeFromAccelerometer(DS5W::MotionFusionState* ptrFusion, const float accel[3])
+	{
+		const float norm = sqrtf(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+		if (norm == 0.0f) {
+			ptrFusion->orientation[0] = 1.0f;
+			ptrFusion->orientation[1] = 0.0f;
+			ptrFusion->orientation[2] = 0.0f;
+			ptrFusion->orientation[3] = 0.0f;
+			return;
+		}
+
+		const float ax = accel[0] / norm;
+		const float ay = accel[1] / norm;
+		const float az = accel[2] / norm;
+
+		// shortest arc from a to (0, 0, 1), half way rotation when upside down
+		float q[4] = { 1.0f + az, ay, -ax, 0.0f };
+		if (q[0] < 1e-6f) {
+			q[0] = 0.0f;
+			q[1] = 1.0f;
+			q[2] = 0.0f;
+		}
+
+		const float qNorm = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+		for (int i = 0; i < 4; i++)
+			ptrFusion->orientation[i] = q[i] / qNorm;
+	}
+
+	// Reads the held report, returns true if it should be fused
+	bool readSample(DS5W::DeviceContext* ptrContext, MotionSample* ptrSample)
+	{
+		DS5W::MotionFusionState& fusion = ptrContext->_internal.motionFusion;
+		if (!fusion.enabled)
+			return false;
+
+		const unsigned char* hidInBuffer = __DS5W::Input::heldReportBody(ptrContext);
+		const unsigned int currentTime = *(unsigned int*)&hidInBuffer[0x1B];
+		if (fusion.initialized && currentTime == fusion.timestamp)
+			return false;
+
+		const DS5W::DeviceCalibrationData& calibration = ptrContext->_internal.calibrationData;
+		const short* raw_gyroscope = (short*)&hidInBuffer[0x0F];
+		const short* raw_accelerometer = (short*)&hidInBuffer[0x15];
+		for (int i = 0; i < 3; i++) {
+			ptrSample->gyro[i] = (float)calibration.gyroscope[i].calibrate(raw_gyroscope[i]) * GYRO_TO_RAD_S;
+			ptrSample->accel[i] = (float)calibration.accelerometer[i].calibrate(raw_accelerometer[i]);
+		}
+
+		const unsigned int previousTime = fusion.timestamp;
+		fusion.timestamp = currentTime;
+
+		if (!fusion.initialized) {
+			initializeFromAccelerometer(&fusion, ptrSample->accel);
+			fusion.initialized = true;
+			return false;
+		}
+
+		// same wrap handling as the input state's delta time
+		const unsigned int deltaTime = previousTime > currentTime ? (0xFFFFFFFF - previousTime) + currentTime : currentTime - previousTime;
+		ptrSample->dt = (float)deltaTime * (1.0f / DS_SENSOR_TIMESTAMP_PER_SECOND);
+		if (ptrSample->dt > MAX_DELTA_SECONDS)
+			ptrSample->dt = MAX_DELTA_SECONDS;
+
+		return true;
+	}
+
+	// Scalar lane
+	inline float invSqrt(float x)
+	{
+		return 1.0f / sqrtf(x);
+	}
+
+	inline float selectPositive(float test, float a, float b)
+	{
+		return test > 0.0f ? a : b;
+	}
+
+	// 4 lanes of SSE floats
+	struct Float4 {
+		__m128 v;
+
+		Float4() {}
+		Float4(__m128 value) : v(value) {}
+		Float4(float value) : v(_mm_set1_ps(value)) {}
+	};
+
+	inline Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+	inline Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+	inline Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+	inline Float4 operator-(Float4 a) { return _mm_sub_ps(_mm_setzero_ps(), a.v); }
+
+	inline Float4 invSqrt(Float4 x)
+	{
+		return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x.v));
+	}
+
+	inline Float4 selectPositive(Float4 test, Float4 a, Float4 b)
+	{
+		const __m128 mask = _mm_cmpgt_ps(test.v, _mm_setzero_ps());
+		return _mm_or_ps(_mm_and_ps(mask, a.v), _mm_andnot_ps(mask, b.v));
+	}
+
+	/// <summary>
+	/// Madgwick IMU update (gyroscope + accelerometer) for one lane type
+	/// q is (w, x, y, z), gyro in rad/s, accel in any unit
+	/// </summary>
+	template <typename T>
+	void madgwickUpdate(T q[4], const T g[3], const T a[3], T beta, T dt)
+	{
+		const T q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+
+		// Rate of change from gyroscope
+		T qDot0 = T(0.5f) * (-q1 * g[0] - q2 * g[1] - q3 * g[2]);
+		T qDot1 = T(0.5f) * (q0 * g[0] + q2 * g[2] - q3 * g[1]);
+		T qDot2 = T(0.5f) * (q0 * g[1] - q1 * g[2] + q3 * g[0]);
+		T qDot3 = T(0.5f) * (q0 * g[2] + q1 * g[1] - q2 * g[0]);
+
+		// Gradient descent step towards the measured gravity direction, skipped for a zero accelerometer
+		const T accelNorm2 = a[0] * a[0] + a[1] * a[1] + a[2] * a[2];
+		const T recipAccel = invSqrt(accelNorm2);
+		const T ax = a[0] * recipAccel;
+		const T ay = a[1] * recipAccel;
+		const T az = a[2] * recipAccel;
+
+		const T _2q0 = T(2.0f) * q0, _2q1 = T(2.0f) * q1, _2q2 = T(2.0f) * q2, _2q3 = T(2.0f) * q3;
+		const T _4q0 = T(4.0f) * q0, _4q1 = T(4.0f) * q1, _4q2 = T(4.0f) * q2;
+		const T _8q1 = T(8.0f) * q1, _8q2 = T(8.0f) * q2;
+		const T q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+
+		T s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+		T s1 = _4q1 * q3q3 - _2q3 * ax + T(4.0f) * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+		T s2 = T(4.0f) * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+		T s3 = T(4.0f) * q1q1 * q3 - _2q1 * ax + T(4.0f) * q2q2 * q3 - _2q2 * ay;
+
+		const T stepNorm2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+		const T recipStep = beta * invSqrt(stepNorm2);
+		const T apply = selectPositive(accelNorm2, stepNorm2, T(0.0f));
+
+		qDot0 = selectPositive(apply, qDot0 - recipStep * s0, qDot0);
+		qDot1 = selectPositive(apply, qDot1 - recipStep * s1, qDot1);
+		qDot2 = selectPositive(apply, qDot2 - recipStep * s2, qDot2);
+		qDot3 = selectPositive(apply, qDot3 - recipStep * s3, qDot3);
+
+		// Integrate and renormalize
+		const T n0 = q0 + qDot0 * dt;
+		const T n1 = q1 + qDot1 * dt;
+		const T n2 = q2 + qDot2 * dt;
+		const T n3 = q3 + qDot3 * dt;
+
+		const T recipQ = invSqrt(n0 * n0 + n1 * n1 + n2 * n2 + n3 * n3);
+		q[0] = n0 * recipQ;
+		q[1] = n1 * recipQ;
+		q[2] = n2 * recipQ;
+		q[3] = n3 * recipQ;
+	}
+
+	// Transposes one value of 4 lanes into a register
+	inline Float4 lanes(float a, float b, float c, float d)
+	{
+		return _mm_setr_ps(a, b, c, d);
+	}
+}
+
+void __DS5W::Motion::resetFusion(DS5W::DeviceContext* ptrContext)
+{
+	ptrContext->_internal.motionFusion.initialized = false;
+	ptrContext->_internal.motionFusion.orientation[0] = 1.0f;
+	ptrContext->_internal.motionFusion.orientation[1] = 0.0f;
+	ptrContext->_internal.motionFusion.orientation[2] = 0.0f;
+	ptrContext->_internal.motionFusion.orientation[3] = 0.0f;
+}
+
+void __DS5W::Motion::updateFusion(DS5W::DeviceContext* ptrContext)
+{
+	// Left to updateFusionBatch
+	if (ptrContext->_internal.motionFusion.batched)
+		return;
+
+	MotionSample sample;
+	if (!readSample(ptrContext, &sample))
+		return;
+
+	DS5W::MotionFusionState& fusion = ptrContext->_internal.motionFusion;
+	madgwickUpdate<float>(fusion.orientation, sample.gyro, sample.accel, fusion.beta, sample.dt);
+}
+
+void __DS5W::Motion::updateFusionBatch(DS5W::DeviceContext** ptrContexts, unsigned int contextCount)
+{
+	unsigned int index = 0;
+	while (index < contextCount) {
+		// Collect up to 4 contexts with a new report
+		DS5W::DeviceContext* group[4];
+		MotionSample samples[4];
+		int count = 0;
+		for (; index < contextCount && count < 4; index++) {
+			DS5W::DeviceContext* ptrContext = ptrContexts[index];
+			if (ptrContext && readSample(ptrContext, &samples[count])) {
+				group[count] = ptrContext;
+				count++;
+			}
+		}
+
+		if (count == 0)
+			break;
+
+		// Unused lanes repeat the first one and are not written back
+		for (int i = count; i < 4; i++) {
+			group[i] = group[0];
+			samples[i] = samples[0];
+		}
+
+		float* q[4];
+		for (int i = 0; i < 4; i++)
+			q[i] = group[i]->_internal.motionFusion.orientation;
+
+		Float4 orientation[4], gyro[3], accel[3];
+		for (int c = 0; c < 4; c++)
+			orientation[c] = lanes(q[0][c], q[1][c], q[2][c], q[3][c]);
+		for (int c = 0; c < 3; c++) {
+			gyro[c] = lanes(samples[0].gyro[c], samples[1].gyro[c], samples[2].gyro[c], samples[3].gyro[c]);
+			accel[c] = lanes(samples[0].accel[c], samples[1].accel[c], samples[2].accel[c], samples[3].accel[c]);
+		}
+		const Float4 beta = lanes(
+			group[0]->_internal.motionFusion.beta, group[1]->_internal.motionFusion.beta,
+			group[2]->_internal.motionFusion.beta, group[3]->_internal.motionFusion.beta);
+		const Float4 dt = lanes(samples[0].dt, samples[1].dt, samples[2].dt, samples[3].dt);
+
+		madgwickUpdate<Float4>(orientation, gyro, accel, beta, dt);
+
+		alignas(16) float result[4][4];
+		for (int c = 0; c < 4; c++)
+			_mm_store_ps(result[c], orientation[c].v);
+		for (int i = 0; i < count; i++) {
+			for (int c = 0; c < 4; c++)
+				q[i][c] = result[c][i];
+		}
+	}
+}
+
+void __DS5W::Motion::getMotionState(const DS5W::DeviceContext* ptrContext, DS5W::DS5MotionState* ptrMotionState)
+{
+	const DS5W::MotionFusionState& fusion = ptrContext->_internal.motionFusion;
+	const float q0 = fusion.orientation[0];
+	const float q1 = fusion.orientation[1];
+	const float q2 = fusion.orientation[2];
+	const float q3 = fusion.orientation[3];
+
+	ptrMotionState->orientation.w = q0;
+	ptrMotionState->orientation.x = q1;
+	ptrMotionState->orientation.y = q2;
+	ptrMotionState->orientation.z = q3;
+
+	// World up rotated into controller axes
+	const float g = 9.80665f;
+	ptrMotionState->gravity.x = g * 2.0f * (q1 * q3 - q0 * q2);
+	ptrMotionState->gravity.y = g * 2.0f * (q0 * q1 + q2 * q3);
+	ptrMotionState->gravity.z = g * (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
+
+	ptrMotionState->currentTime = fusion.timestamp;
+}
@@ -0,0 +1,42 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace Motion {
+		/// <summary>
+		/// Default filter gain of the motion fusion
+		/// </summary>
+		const float DEFAULT_BETA = 0.1f;
+
+		/// <summary>
+		/// Restart the orientation estimate from the next accelerometer sample
+		/// </summary>
+		void resetFusion(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Update the orientation estimate with the context's held input report
+		/// Does nothing if fusion is disabled or batched, or the report was already used
+		/// </summary>
+		void updateFusion(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Update the orientation estimate of many contexts, 4 at a time with SSE
+		/// Applies the same update as calling updateFusion on each context, batched contexts included
+		/// </summary>
+		void updateFusionBatch(DS5W::DeviceContext** ptrContexts, unsigned int contextCount);
+
+		/// <summary>
+		/// Copy the orientation and derived gravity vector of a context
+		/// </summary>
+		void getMotionState(const DS5W::DeviceContext* ptrContext, DS5W::DS5MotionState* ptrMotionState);
+	}
+}
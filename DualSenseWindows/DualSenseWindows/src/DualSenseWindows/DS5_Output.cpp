@@ -1,175 +1,181 @@
 #include "DS5_Output.h"
 
-void __DS5W::Output::createHidOutputBuffer(unsigned char* hidOutBuffer, DS5W::DS5OutputState* ptrOutputState) {
+namespace {
+	void hashBtOutputReport(DS5W::DeviceContext* ptrContext)
+	{
+		const size_t len = DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32);
+		unsigned char* report = ptrContext->_internal.hidOutBuffer;
+
+		// Consecutive reports mostly differ in a few bytes, only those are hashed
+		UINT32 hash;
+		if (ptrContext->_internal.btOutputCrcValid)
+			hash = __DS5W::CRC32::update(ptrContext->_internal.btOutputCrc, ptrContext->_internal.btOutputReport, report, len);
+		else
+			hash = __DS5W::CRC32::compute(report, len);
+
+		memcpy(ptrContext->_internal.btOutputReport, report, len);
+		ptrContext->_internal.btOutputCrc = hash;
+		ptrContext->_internal.btOutputCrcValid = true;
+
+		memcpy(&report[len], &hash, sizeof(UINT32));
+	}
+
+	// Third byte of feature flags (body byte 0x26)
+	const unsigned char FEATURES3_PLAYER_LED_BRIGHTNESS = 0x01;
+	const unsigned char FEATURES3_LIGHTBAR_SETUP = 0x02;
 
-	// Feature flags 
-	const unsigned char FEATURES1 = DS5W::DefaultOutputFlags & 0x00FF;
-	const unsigned char FEATURES2 = (DS5W::DefaultOutputFlags & 0xFF00) >> 8;
-	hidOutBuffer[0x00] = FEATURES1;
-	hidOutBuffer[0x01] = FEATURES2;
+	// Flags of unknown purpose, sent with every report as before subsystems could be picked
+	const unsigned short ALWAYS_OUTPUT_FLAGS =
+		(unsigned short)DS5W::OutputFlags::UnknownFlag1 |
+		(unsigned short)DS5W::OutputFlags::UnknownFlag2;
 
-	// Rumble motors
-	hidOutBuffer[0x02] = ptrOutputState->rightRumble;
-	hidOutBuffer[0x03] = ptrOutputState->leftRumble;
+	// Report images copied over the output buffer before the body is written
+	// USB: report ID, then body
+	constexpr unsigned char USB_REPORT_TEMPLATE[DS_OUTPUT_REPORT_USB_SIZE] = { DS_OUTPUT_REPORT_USB };
+	// BT: report ID, magic value?, then body and CRC
+	constexpr unsigned char BT_REPORT_TEMPLATE[DS_OUTPUT_REPORT_BT_SIZE] = { DS_OUTPUT_REPORT_BT, 0x02 };
 
-	// Mic led
-	hidOutBuffer[0x08] = (unsigned char)ptrOutputState->microphoneLed;
+	const int USB_BODY_OFFSET = 1;
+	const int BT_BODY_OFFSET = 2;
 
-	// strength multiplier for controller/trigger haptics
-	hidOutBuffer[0x24] = ptrOutputState->rumbleStrength;
+	int bodyOffset(DS5W::DeviceContext* ptrContext)
+	{
+		return ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT ? BT_BODY_OFFSET : USB_BODY_OFFSET;
+	}
+}
 
-	// Player led brightness
-	hidOutBuffer[0x26] = 0x03;
-	hidOutBuffer[0x29] = ptrOutputState->disableLeds ? 0x01 : 0x2;
-	hidOutBuffer[0x2A] = ptrOutputState->playerLeds.brightness;
+unsigned short __DS5W::Output::outputFlags(unsigned int subsystems)
+{
+	unsigned short flags = ALWAYS_OUTPUT_FLAGS;
+
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_RUMBLE)
+		flags |= (unsigned short)DS5W::OutputFlags::SetMainMotorsA | (unsigned short)DS5W::OutputFlags::SetMainMotorsB;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_RIGHT_TRIGGER)
+		flags |= (unsigned short)DS5W::OutputFlags::SetTriggerMotorsA;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_LEFT_TRIGGER)
+		flags |= (unsigned short)DS5W::OutputFlags::SetTriggerMotorsB;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_MIC_LED)
+		flags |= (unsigned short)DS5W::OutputFlags::SetMicrophoneLED | (unsigned short)DS5W::OutputFlags::SetAudioMicMute;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_LIGHTBAR)
+		flags |= (unsigned short)DS5W::OutputFlags::SetColorLED;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS)
+		flags |= (unsigned short)DS5W::OutputFlags::SetPlayerLED;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_MOTOR_STRENGTH)
+		flags |= (unsigned short)DS5W::OutputFlags::SetMotorStrength;
+
+	return flags;
+}
 
-	// Player led mask
-	hidOutBuffer[0x2B] = ptrOutputState->playerLeds.bitmask;
-	if (ptrOutputState->playerLeds.playerLedFade) {
-		hidOutBuffer[0x2B] &= ~(0x20);
+void __DS5W::Output::mergeOutputState(DS5W::DS5OutputState* ptrTarget, const DS5W::DS5OutputState* ptrSource, unsigned int subsystems)
+{
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_RUMBLE) {
+		ptrTarget->leftRumble = ptrSource->leftRumble;
+		ptrTarget->rightRumble = ptrSource->rightRumble;
 	}
-	else {
-		hidOutBuffer[0x2B] |= 0x20;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_LEFT_TRIGGER)
+		ptrTarget->leftTriggerEffect = ptrSource->leftTriggerEffect;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_RIGHT_TRIGGER)
+		ptrTarget->rightTriggerEffect = ptrSource->rightTriggerEffect;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_MIC_LED)
+		ptrTarget->microphoneLed = ptrSource->microphoneLed;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_LIGHTBAR) {
+		ptrTarget->lightbar = ptrSource->lightbar;
+		ptrTarget->disableLeds = ptrSource->disableLeds;
 	}
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS)
+		ptrTarget->playerLeds = ptrSource->playerLeds;
+	if (subsystems & DS5W_OSTATE_SUBSYSTEM_MOTOR_STRENGTH)
+		ptrTarget->rumbleStrength = ptrSource->rumbleStrength;
+}
 
-	// Lightbar
-	hidOutBuffer[0x2C] = ptrOutputState->lightbar.r;
-	hidOutBuffer[0x2D] = ptrOutputState->lightbar.g;
-	hidOutBuffer[0x2E] = ptrOutputState->lightbar.b;
+void __DS5W::Output::OutputReportView::writeState(const DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems)
+{
+	// Feature flags, the device ignores fields of subsystems without their flag
+	setFlags(outputFlags(subsystems));
+
+	setRumble(ptrOutputState->leftRumble, ptrOutputState->rightRumble);
+	setMicrophoneLed(ptrOutputState->microphoneLed);
+	setRumbleStrength(ptrOutputState->rumbleStrength);
+
+	// LED setup bytes are only applied with their feature bit
+	setFeatures3(((subsystems & DS5W_OSTATE_SUBSYSTEM_PLAYER_LEDS) ? FEATURES3_PLAYER_LED_BRIGHTNESS : 0) |
+		((subsystems & DS5W_OSTATE_SUBSYSTEM_LIGHTBAR) ? FEATURES3_LIGHTBAR_SETUP : 0));
+	setLightbarSetup(ptrOutputState->disableLeds);
+	setPlayerLeds(ptrOutputState->playerLeds);
+	setLightbar(ptrOutputState->lightbar);
 
 	// Adaptive Triggers
-	memcpy(&hidOutBuffer[0x0A], &ptrOutputState->rightTriggerEffect, 11);
-	memcpy(&hidOutBuffer[0x15], &ptrOutputState->leftTriggerEffect, 11);
-	
-	//processTrigger(&ptrOutputState->leftTriggerEffect, &hidOutBuffer[0x15]);
-	//processTrigger(&ptrOutputState->rightTriggerEffect, &hidOutBuffer[0x0A]);
+	setRightTriggerEffect(ptrOutputState->rightTriggerEffect);
+	setLeftTriggerEffect(ptrOutputState->leftTriggerEffect);
 }
 
-void __DS5W::Output::createHidOutputBufferDisabled(UCHAR* hidOutBuffer)
+void __DS5W::Output::OutputReportView::writeDisabled()
 {
 	// Feature flags allow setting all device parameters
 	// Enable flag to disable LEDs
-	hidOutBuffer[0x00] = DS5W::DefaultOutputFlags & 0x00FF;
-	hidOutBuffer[0x01] = ((DS5W::DefaultOutputFlags | (USHORT)DS5W::OutputFlags::DisableAllLED) & 0xFF00) >> 8;
+	setFlags(DS5W::DefaultOutputFlags | (unsigned short)DS5W::OutputFlags::DisableAllLED);
 
 	// set trigger effect to released instead of disabled
 	// this will make them relax instantly
-	hidOutBuffer[0x0A] = (UCHAR)DS5W::TriggerEffectType::ReleaseAll;
-	hidOutBuffer[0x15] = (UCHAR)DS5W::TriggerEffectType::ReleaseAll;
+	body[OFFSET_RIGHT_TRIGGER] = (unsigned char)DS5W::TriggerEffectType::ReleaseAll;
+	body[OFFSET_LEFT_TRIGGER] = (unsigned char)DS5W::TriggerEffectType::ReleaseAll;
 }
 
-int __DS5W::Output::createHIDOutputReport(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState)
+__DS5W::Output::OutputReportView __DS5W::Output::beginOutputReport(DS5W::DeviceContext* ptrContext)
 {
-	// Convert output state to device's expected form
-	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
+	unsigned char* report = ptrContext->_internal.hidOutBuffer;
 
-		// BT needs the first byte to be the report ID
-		ZeroMemory(ptrContext->_internal.hidOutBuffer, DS_OUTPUT_REPORT_BT_SIZE);
-		ptrContext->_internal.hidOutBuffer[0x00] = DS_OUTPUT_REPORT_BT;
-		ptrContext->_internal.hidOutBuffer[0x01] = 0x02;	// magic value?
-		__DS5W::Output::createHidOutputBuffer(&ptrContext->_internal.hidOutBuffer[2], ptrOutputState);
+	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT)
+		memcpy(report, BT_REPORT_TEMPLATE, sizeof(BT_REPORT_TEMPLATE));
+	else
+		memcpy(report, USB_REPORT_TEMPLATE, sizeof(USB_REPORT_TEMPLATE));
 
+	return OutputReportView(&report[bodyOffset(ptrContext)]);
+}
+
+int __DS5W::Output::finishOutputReport(DS5W::DeviceContext* ptrContext)
+{
+	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
 		// BT buffer also needs to set last 4 bytes to be the hash of all bytes (minus last 4)
-		UINT32 hash = __DS5W::CRC32::compute(ptrContext->_internal.hidOutBuffer, DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32));
-		memcpy(&ptrContext->_internal.hidOutBuffer[DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32)], &hash, sizeof(UINT32));
+		hashBtOutputReport(ptrContext);
 
 		return DS_OUTPUT_REPORT_BT_SIZE;
 	}
-	else {
-		// USB needs the first byte set as the report ID
-		ZeroMemory(ptrContext->_internal.hidOutBuffer, DS_OUTPUT_REPORT_USB_SIZE);
-		ptrContext->_internal.hidOutBuffer[0x00] = DS_OUTPUT_REPORT_USB;
-		__DS5W::Output::createHidOutputBuffer(&ptrContext->_internal.hidOutBuffer[1], ptrOutputState);
 
-		return DS_OUTPUT_REPORT_USB_SIZE;
-	}
+	return DS_OUTPUT_REPORT_USB_SIZE;
+}
+
+int __DS5W::Output::createHIDOutputReport(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems)
+{
+	beginOutputReport(ptrContext).writeState(ptrOutputState, subsystems);
+	return finishOutputReport(ptrContext);
 }
 
 int __DS5W::Output::createHIDOutputReportDisabled(DS5W::DeviceContext* ptrContext)
 {
-	// Convert output state to device's expected form
-	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
+	beginOutputReport(ptrContext).writeDisabled();
+	return finishOutputReport(ptrContext);
+}
 
-		// BT needs the first byte to be the report ID
-		ZeroMemory(ptrContext->_internal.hidOutBuffer, DS_OUTPUT_REPORT_BT_SIZE);
-		ptrContext->_internal.hidOutBuffer[0x00] = DS_OUTPUT_REPORT_BT;
-		ptrContext->_internal.hidOutBuffer[0x01] = 0x02;	// magic value?
-		__DS5W::Output::createHidOutputBufferDisabled(&ptrContext->_internal.hidOutBuffer[2]);
+bool __DS5W::Output::matchesLastOutput(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState)
+{
+	if (!ptrContext->_internal.lastOutputValid)
+		return false;
 
-		// BT buffer also needs to set last 4 bytes to be the hash of all bytes (minus last 4)
-		UINT32 hash = __DS5W::CRC32::compute(ptrContext->_internal.hidOutBuffer, DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32));
-		memcpy(&ptrContext->_internal.hidOutBuffer[DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32)], &hash, sizeof(UINT32));
+	// Compare encoded bodies, the state itself can hold unused bytes
+	unsigned char body[DS_OUTPUT_REPORT_BODY_SIZE] = {};
+	OutputReportView(body).writeState(ptrOutputState);
 
-		return DS_OUTPUT_REPORT_BT_SIZE;
-	}
-	else {
-		// USB needs the first byte set as the report ID
-		ZeroMemory(ptrContext->_internal.hidOutBuffer, DS_OUTPUT_REPORT_USB_SIZE);
-		ptrContext->_internal.hidOutBuffer[0x00] = DS_OUTPUT_REPORT_USB;
-		__DS5W::Output::createHidOutputBufferDisabled(&ptrContext->_internal.hidOutBuffer[1]);
+	return memcmp(body, ptrContext->_internal.lastOutputBody, sizeof(body)) == 0;
+}
 
-		return DS_OUTPUT_REPORT_USB_SIZE;
-	}
+void __DS5W::Output::rememberLastOutput(DS5W::DeviceContext* ptrContext)
+{
+	memcpy(ptrContext->_internal.lastOutputBody, &ptrContext->_internal.hidOutBuffer[bodyOffset(ptrContext)], DS_OUTPUT_REPORT_BODY_SIZE);
+	ptrContext->_internal.lastOutputValid = true;
 }
 
-void __DS5W::Output::processTrigger(DS5W::TriggerEffect* ptrEffect, unsigned char* buffer) {
-	// Switch on effect
-	switch (ptrEffect->effectType) {
-		// Continious
-		case DS5W::TriggerEffectType::ContinuousResitance:
-			// Mode
-			buffer[0x00] = 0x01;
-			// Parameters
-			buffer[0x01] = ptrEffect->Continuous.startPosition;
-			buffer[0x02] = ptrEffect->Continuous.force;
-
-			break;
-
-		// Section
-		case DS5W::TriggerEffectType::SectionResitance:
-			// Mode
-			buffer[0x00] = 0x02;
-			// Parameters
-			buffer[0x01] = ptrEffect->Continuous.startPosition;
-			buffer[0x02] = ptrEffect->Continuous.force;
-
-			break;
-
-		// EffectEx
-		case DS5W::TriggerEffectType::EffectEx:
-			// Mode
-			buffer[0x00] = 0x02 | 0x20 | 0x04;
-			// Parameters
-			buffer[0x01] = 0xFF - ptrEffect->EffectEx.startPosition;
-			// Keep flag
-			if (ptrEffect->EffectEx.keepEffect) {
-				buffer[0x02] = 0x02;
-			}
-			// Forces
-			buffer[0x04] = ptrEffect->EffectEx.beginForce;
-			buffer[0x05] = ptrEffect->EffectEx.middleForce;
-			buffer[0x06] = ptrEffect->EffectEx.endForce;
-			// Frequency
-			buffer[0x09] = max(1, ptrEffect->EffectEx.frequency / 2);
-
-			break;
-
-		// Calibrate
-		case DS5W::TriggerEffectType::Calibrate:
-			// Mode 
-			buffer[0x00] = 0xFC;
-
-			break;
-
-		// No resistance / default
-		case DS5W::TriggerEffectType::NoResitance:
-			__fallthrough;
-		default:
-			// All zero
-			buffer[0x00] = 0x00;
-			buffer[0x01] = 0x00;
-			buffer[0x02] = 0x00;
-
-			break;
-	}		
+void __DS5W::Output::forgetLastOutput(DS5W::DeviceContext* ptrContext)
+{
+	ptrContext->_internal.lastOutputValid = false;
 }
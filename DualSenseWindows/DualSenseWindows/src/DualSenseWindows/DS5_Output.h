@@ -16,29 +16,135 @@
 #include <DualSenseWindows/DS_CRC32.h>
 
 #include <Windows.h>
+#include <string.h>
 
 namespace __DS5W {
 	namespace Output {
 		/// <summary>
-		/// Creates the hid output buffer
+		/// Output report flags that let the device apply a set of subsystems
 		/// </summary>
-		/// <param name="hidOutBuffer">HID Output buffer</param>
-		/// <param name="ptrOutputState">Pointer to state to read from</param>
-		void createHidOutputBuffer(unsigned char* hidOutBuffer, DS5W::DS5OutputState* ptrOutputState);
+		/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits</param>
+		unsigned short outputFlags(unsigned int subsystems);
 
 		/// <summary>
-		/// Creates the hid output buffer to disable all features (lights, rumble, etc.)
+		/// Copy the fields of a set of subsystems from one output state to another
 		/// </summary>
-		/// <param name="hidOutBuffer">Pointer to start of output report (skipping report id)</param>
-		void createHidOutputBufferDisabled(UCHAR* hidOutBuffer);
+		/// <param name="ptrTarget">State to write to</param>
+		/// <param name="ptrSource">State to read from</param>
+		/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits</param>
+		void mergeOutputState(DS5W::DS5OutputState* ptrTarget, const DS5W::DS5OutputState* ptrSource, unsigned int subsystems);
+
+		/// <summary>
+		/// Typed access to the body of an output report, fields are written in place at their wire offsets
+		/// </summary>
+		class OutputReportView {
+			public:
+				/// <summary>
+				/// Wire offsets of the fields, relative to the body (after report ID and BT header)
+				/// </summary>
+				static const int OFFSET_FLAGS = 0x00;
+				static const int OFFSET_RIGHT_RUMBLE = 0x02;
+				static const int OFFSET_LEFT_RUMBLE = 0x03;
+				static const int OFFSET_MIC_LED = 0x08;
+				static const int OFFSET_RIGHT_TRIGGER = 0x0A;
+				static const int OFFSET_LEFT_TRIGGER = 0x15;
+				static const int OFFSET_RUMBLE_STRENGTH = 0x24;
+				static const int OFFSET_FEATURES3 = 0x26;
+				static const int OFFSET_LIGHTBAR_SETUP = 0x29;
+				static const int OFFSET_PLAYER_LED_BRIGHTNESS = 0x2A;
+				static const int OFFSET_PLAYER_LEDS = 0x2B;
+				static const int OFFSET_LIGHTBAR = 0x2C;
+
+				/// <summary>
+				/// Size of a trigger effect on the wire
+				/// </summary>
+				static const int TRIGGER_EFFECT_SIZE = 11;
+
+				/// <summary>
+				/// View a report body of DS_OUTPUT_REPORT_BODY_SIZE bytes
+				/// </summary>
+				explicit OutputReportView(unsigned char* body) : body(body) {}
+
+				unsigned char* data() const { return body; }
+
+				void setFlags(unsigned short flags) {
+					body[OFFSET_FLAGS] = flags & 0x00FF;
+					body[OFFSET_FLAGS + 1] = (flags & 0xFF00) >> 8;
+				}
+
+				void setRumble(unsigned char left, unsigned char right) {
+					body[OFFSET_LEFT_RUMBLE] = left;
+					body[OFFSET_RIGHT_RUMBLE] = right;
+				}
+
+				void setMicrophoneLed(DS5W::MicLed led) { body[OFFSET_MIC_LED] = (unsigned char)led; }
+
+				void setRightTriggerEffect(const DS5W::TriggerEffect& effect) { memcpy(&body[OFFSET_RIGHT_TRIGGER], &effect, TRIGGER_EFFECT_SIZE); }
+				void setLeftTriggerEffect(const DS5W::TriggerEffect& effect) { memcpy(&body[OFFSET_LEFT_TRIGGER], &effect, TRIGGER_EFFECT_SIZE); }
+
+				/// <summary>
+				/// Strength multiplier for controller/trigger haptics
+				/// </summary>
+				void setRumbleStrength(unsigned char strength) { body[OFFSET_RUMBLE_STRENGTH] = strength; }
+
+				/// <summary>
+				/// Third byte of feature flags, which LED setup bytes the device should apply
+				/// </summary>
+				void setFeatures3(unsigned char features) { body[OFFSET_FEATURES3] = features; }
+
+				void setLightbarSetup(bool disableLeds) { body[OFFSET_LIGHTBAR_SETUP] = disableLeds ? 0x01 : 0x02; }
+
+				void setPlayerLeds(const DS5W::PlayerLeds& leds) {
+					body[OFFSET_PLAYER_LED_BRIGHTNESS] = leds.brightness;
+
+					// Fade bit is set to disable fading
+					body[OFFSET_PLAYER_LEDS] = leds.playerLedFade ? (leds.bitmask & ~0x20) : (leds.bitmask | 0x20);
+				}
+
+				void setLightbar(const DS5W::Color& color) {
+					body[OFFSET_LIGHTBAR + 0] = color.r;
+					body[OFFSET_LIGHTBAR + 1] = color.g;
+					body[OFFSET_LIGHTBAR + 2] = color.b;
+				}
+
+				/// <summary>
+				/// Write every field of an output state
+				/// </summary>
+				/// <param name="ptrOutputState">Pointer to state to read from</param>
+				/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits the device should apply</param>
+				void writeState(const DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems = DS5W_OSTATE_SUBSYSTEM_ALL);
+
+				/// <summary>
+				/// Write the fields that disable all features (lights, rumble, etc.)
+				/// </summary>
+				void writeDisabled();
+
+			private:
+				unsigned char* body;
+		};
+
+		/// <summary>
+		/// Reset the context's output buffer to the report template of its connection
+		/// </summary>
+		/// <param name="ptrContext">Context to write to</param>
+		/// <returns>View of the report body, fields not written stay zero</returns>
+		OutputReportView beginOutputReport(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Finish the report in the context's output buffer, only BT has a CRC to append
+		/// </summary>
+		/// <param name="ptrContext">Context to finish</param>
+		/// <returns>Length of the report</returns>
+		int finishOutputReport(DS5W::DeviceContext* ptrContext);
 
 		/// <summary>
 		/// Fills the context's output buffer with the HID report form of an output state
 		/// </summary>
 		/// <param name="ptrContext"></param>
 		/// <param name="ptrOutputState"></param>
+		/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits the device should apply</param>
 		/// <returns></returns>
-		int createHIDOutputReport(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState);
+		int createHIDOutputReport(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems = DS5W_OSTATE_SUBSYSTEM_ALL);
 
 		/// <summary>
 		/// Fills the context's output buffer with an output state that disables all features (lights, rumble, etc.)
@@ -49,10 +155,21 @@ namespace __DS5W {
 		int createHIDOutputReportDisabled(DS5W::DeviceContext* ptrContext);
 
 		/// <summary>
-		/// Process trigger
+		/// Check whether an output state would produce the report last sent to the device
+		/// </summary>
+		/// <param name="ptrContext">Context to compare against</param>
+		/// <param name="ptrOutputState">Pointer to state to compare</param>
+		/// <returns>True if sending the state would change nothing</returns>
+		bool matchesLastOutput(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState);
+
+		/// <summary>
+		/// Remember the report in the context's output buffer as the one the device has
+		/// </summary>
+		void rememberLastOutput(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Forget the last report so the next state is always sent
 		/// </summary>
-		/// <param name="ptrEffect">Pointer to effect to be applied</param>
-		/// <param name="buffer">Buffer for trigger parameters</param>
-		void processTrigger(DS5W::TriggerEffect* ptrEffect, unsigned char* buffer);
+		void forgetLastOutput(DS5W::DeviceContext* ptrContext);
 	}
 }
\ No newline at end of file
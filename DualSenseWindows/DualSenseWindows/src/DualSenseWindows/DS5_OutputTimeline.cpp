@@ -0,0 +1,393 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_OutputTimeline.h"
+#include "DS5_Internal.h"
+#include "DS5_Output.h"
+#include "DS5_OutputWriter.h"
+
+#include <Windows.h>
+#include <string.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace {
+	bool earlier(const DS5W::OutputTimelineEvent& a, const DS5W::OutputTimelineEvent& b)
+	{
+		return a.hostTime < b.hostTime || (a.hostTime == b.hostTime && a.order < b.order);
+	}
+
+	// Heap operations, timeline lock must be held
+	void push(DS5W::OutputTimelineState& timeline, const DS5W::OutputTimelineEvent& event)
+	{
+		unsigned int index = timeline.eventCount++;
+		while (index > 0) {
+			const unsigned int parent = (index - 1) / 2;
+			if (!earlier(event, timeline.events[parent]))
+				break;
+			timeline.events[index] = timeline.events[parent];
+			index = parent;
+		}
+		timeline.events[index] = event;
+	}
+
+	void pop(DS5W::OutputTimelineState& timeline, DS5W::OutputTimelineEvent* ptrEvent)
+	{
+		*ptrEvent = timeline.events[0];
+
+		const DS5W::OutputTimelineEvent& last = timeline.events[--timeline.eventCount];
+		const unsigned int count = timeline.eventCount;
+		unsigned int index = 0;
+		for (;;) {
+			unsigned int child = index * 2 + 1;
+			if (child >= count)
+				break;
+			if (child + 1 < count && earlier(timeline.events[child + 1], timeline.events[child]))
+				child++;
+			if (!earlier(timeline.events[child], last))
+				break;
+			timeline.events[index] = timeline.events[child];
+			index = child;
+		}
+		timeline.events[index] = last;
+	}
+
+	// Time between two reports the transport accepts
+	long long slotTicks(DS5W::DeviceContext* ptrContext)
+	{
+		const unsigned int rate = ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT ?
+			__DS5W::OutputWriter::MAX_RATE_BT : __DS5W::OutputWriter::MAX_RATE_USB;
+		return ptrContext->_internal.outputTimeline.hostFrequency / rate;
+	}
+
+	// Apply every change due by now with one report
+	// Returns false once the device is gone
+	bool dispatch(DS5W::DeviceContext* ptrContext, long long now)
+	{
+		DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+		const long long slot = slotTicks(ptrContext);
+
+		unsigned int subsystems = 0;
+		unsigned int count = 0;
+
+		AcquireSRWLockExclusive(&timeline.lock);
+		while (timeline.eventCount > 0 && timeline.events[0].hostTime <= now) {
+			DS5W::OutputTimelineEvent event;
+			pop(timeline, &event);
+			__DS5W::Output::mergeOutputState(&timeline.current, &event.state, event.subsystems);
+			subsystems |= event.subsystems;
+			count++;
+
+			const unsigned long long lateness = (unsigned long long)(now - event.hostTime);
+			timeline.latenessTotal += lateness;
+			timeline.latenessLast = lateness;
+			if (lateness > timeline.latenessMax)
+				timeline.latenessMax = lateness;
+			if ((long long)lateness > slot)
+				timeline.lateEvents++;
+		}
+		timeline.dispatched += count;
+		if (count > 1)
+			timeline.merged += count - 1;
+		if (count > 0)
+			timeline.sending = true;
+		ReleaseSRWLockExclusive(&timeline.lock);
+
+		timeline.lastDispatch = now;
+		if (count == 0)
+			return true;
+
+		// A running writer owns the output buffer and sends at its own rate
+		DS5W_RV err = DS5W_OK;
+		bool sent = false;
+		if (!__DS5W::OutputWriter::submit(ptrContext, &timeline.current, subsystems)) {
+			int outputReportLength = __DS5W::Output::createHIDOutputReport(ptrContext, &timeline.current, subsystems);
+			err = DS5W::setOutputReport(ptrContext, outputReportLength, IO_TIMEOUT_MILLISECONDS);
+			sent = true;
+		}
+
+		// Last output is compared under the lock by matchesLastOutput
+		AcquireSRWLockExclusive(&timeline.lock);
+		if (sent) {
+			if (DS5W_SUCCESS(err) && subsystems == DS5W_OSTATE_SUBSYSTEM_ALL)
+				__DS5W::Output::rememberLastOutput(ptrContext);
+			else
+				__DS5W::Output::forgetLastOutput(ptrContext);
+		}
+		if (DS5W_SUCCESS(err))
+			timeline.reports++;
+		else
+			timeline.failed++;
+		timeline.sending = false;
+		ReleaseSRWLockExclusive(&timeline.lock);
+
+		return err != DS5W_E_DEVICE_REMOVED;
+	}
+
+	DWORD WINAPI timelineThread(LPVOID param)
+	{
+		DS5W::DeviceContext* ptrContext = (DS5W::DeviceContext*)param;
+		DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+		const HANDLE handles[3] = { timeline.stopEvent, timeline.wakeEvent, timeline.timer };
+		const long long slot = slotTicks(ptrContext);
+		bool removed = false;
+
+		for (;;) {
+			AcquireSRWLockExclusive(&timeline.lock);
+			const bool pending = timeline.eventCount > 0;
+			long long due = pending ? timeline.events[0].hostTime : 0;
+			ReleaseSRWLockExclusive(&timeline.lock);
+
+			// The transport takes one report per slot, changes due before the next slot share it
+			if (pending && due < timeline.lastDispatch + slot)
+				due = timeline.lastDispatch + slot;
+
+			LARGE_INTEGER now;
+			QueryPerformanceCounter(&now);
+
+			DWORD wait;
+			if (!pending) {
+				wait = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+			}
+			else if (due > now.QuadPart) {
+				// Relative due time in 100 nanosecond units
+				LARGE_INTEGER dueTime;
+				dueTime.QuadPart = -(LONGLONG)((due - now.QuadPart) * 10000000 / timeline.hostFrequency);
+				if (!SetWaitableTimer(timeline.timer, &dueTime, 0, NULL, NULL, FALSE))
+					break;
+
+				wait = WaitForMultipleObjects(3, handles, FALSE, INFINITE);
+			}
+			else {
+				if (!dispatch(ptrContext, now.QuadPart)) {
+					removed = true;
+					break;
+				}
+				continue;
+			}
+
+			// Woken or timer fired, look at the timeline again
+			if (wait == WAIT_OBJECT_0 || wait == WAIT_FAILED)
+				break;
+		}
+
+		// Disconnecting is left to the threads using the context
+		AcquireSRWLockExclusive(&timeline.lock);
+		timeline.running = false;
+		timeline.deviceRemoved = removed;
+		timeline.eventCount = 0;
+		ReleaseSRWLockExclusive(&timeline.lock);
+
+		return 0;
+	}
+
+	double ticksToMicroseconds(unsigned long long ticks, long long frequency)
+	{
+		return frequency > 0 ? (double)ticks * 1000000.0 / (double)frequency : 0.0;
+	}
+}
+
+void __DS5W::OutputTimeline::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+	InitializeSRWLock(&timeline.lock);
+	timeline.thread = NULL;
+	timeline.timer = NULL;
+	timeline.stopEvent = NULL;
+	timeline.wakeEvent = NULL;
+	timeline.hostFrequency = 0;
+	timeline.eventCount = 0;
+	timeline.nextOrder = 0;
+	timeline.scheduled = 0;
+	timeline.dispatched = 0;
+	timeline.merged = 0;
+	timeline.reports = 0;
+	timeline.failed = 0;
+	timeline.lateEvents = 0;
+	timeline.latenessTotal = 0;
+	timeline.latenessMax = 0;
+	timeline.latenessLast = 0;
+	timeline.running = false;
+	timeline.deviceRemoved = false;
+	timeline.sending = false;
+}
+
+DS5W_ReturnValue __DS5W::OutputTimeline::start(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+	stop(ptrContext);
+
+	// High resolution timers need Windows 10 1803, older versions fall back to the system timer resolution
+	timeline.timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (!timeline.timer)
+		timeline.timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+	timeline.stopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	timeline.wakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+	if (!timeline.timer || !timeline.stopEvent || !timeline.wakeEvent) {
+		if (timeline.timer) CloseHandle(timeline.timer);
+		if (timeline.stopEvent) CloseHandle(timeline.stopEvent);
+		if (timeline.wakeEvent) CloseHandle(timeline.wakeEvent);
+		timeline.timer = NULL;
+		timeline.stopEvent = NULL;
+		timeline.wakeEvent = NULL;
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	// Thread is not running yet, no lock needed
+	timeline.hostFrequency = frequency.QuadPart;
+	timeline.eventCount = 0;
+	timeline.nextOrder = 0;
+	timeline.scheduled = 0;
+	timeline.dispatched = 0;
+	timeline.merged = 0;
+	timeline.reports = 0;
+	timeline.failed = 0;
+	timeline.lateEvents = 0;
+	timeline.latenessTotal = 0;
+	timeline.latenessMax = 0;
+	timeline.latenessLast = 0;
+	timeline.running = true;
+	timeline.deviceRemoved = false;
+	timeline.sending = false;
+	memset(&timeline.current, 0, sizeof(timeline.current));
+	timeline.lastDispatch = 0;
+
+	timeline.thread = CreateThread(NULL, 0, timelineThread, ptrContext, 0, NULL);
+	if (!timeline.thread) {
+		timeline.running = false;
+		CloseHandle(timeline.timer);
+		CloseHandle(timeline.stopEvent);
+		CloseHandle(timeline.wakeEvent);
+		timeline.timer = NULL;
+		timeline.stopEvent = NULL;
+		timeline.wakeEvent = NULL;
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	return DS5W_OK;
+}
+
+void __DS5W::OutputTimeline::stop(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+	if (!timeline.thread)
+		return;
+
+	SetEvent(timeline.stopEvent);
+	WaitForSingleObject(timeline.thread, INFINITE);
+
+	CloseHandle(timeline.thread);
+	CloseHandle(timeline.timer);
+	CloseHandle(timeline.stopEvent);
+	CloseHandle(timeline.wakeEvent);
+	timeline.thread = NULL;
+	timeline.timer = NULL;
+	timeline.stopEvent = NULL;
+	timeline.wakeEvent = NULL;
+}
+
+DS5W_ReturnValue __DS5W::OutputTimeline::schedule(DS5W::DeviceContext* ptrContext, long long hostTime, const DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+	DS5W_RV result = DS5W_OK;
+	bool first = false;
+
+	// Changes due already are late from now on, not from their due time
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	if (hostTime < now.QuadPart)
+		hostTime = now.QuadPart;
+
+	AcquireSRWLockExclusive(&timeline.lock);
+	if (!timeline.running) {
+		result = DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+	else if (timeline.eventCount == DS5W_OUTPUT_TIMELINE_CAPACITY) {
+		result = DS5W_E_INSUFFICIENT_BUFFER;
+	}
+	else {
+		DS5W::OutputTimelineEvent event;
+		event.hostTime = hostTime;
+		event.order = timeline.nextOrder++;
+		event.subsystems = subsystems;
+		event.state = *ptrOutputState;
+
+		push(timeline, event);
+		first = timeline.events[0].order == event.order;
+		timeline.scheduled++;
+	}
+	ReleaseSRWLockExclusive(&timeline.lock);
+
+	// Thread may be waiting for a later change
+	if (first)
+		SetEvent(timeline.wakeEvent);
+
+	return result;
+}
+
+bool __DS5W::OutputTimeline::matchesLastOutput(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+	// Waiting or unsent changes still modify what the device has
+	AcquireSRWLockExclusive(&timeline.lock);
+	const bool matches = timeline.running && timeline.eventCount == 0 && !timeline.sending &&
+		__DS5W::Output::matchesLastOutput(ptrContext, ptrOutputState);
+	ReleaseSRWLockExclusive(&timeline.lock);
+
+	return matches;
+}
+
+void __DS5W::OutputTimeline::clear(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+	AcquireSRWLockExclusive(&timeline.lock);
+	timeline.eventCount = 0;
+	ReleaseSRWLockExclusive(&timeline.lock);
+}
+
+bool __DS5W::OutputTimeline::deviceRemoved(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+	AcquireSRWLockExclusive(&timeline.lock);
+	const bool removed = timeline.deviceRemoved;
+	ReleaseSRWLockExclusive(&timeline.lock);
+
+	return removed;
+}
+
+void __DS5W::OutputTimeline::getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputTimelineStatistics* ptrStatistics)
+{
+	DS5W::OutputTimelineState& timeline = ptrContext->_internal.outputTimeline;
+
+	AcquireSRWLockExclusive(&timeline.lock);
+	ptrStatistics->scheduled = timeline.scheduled;
+	ptrStatistics->dispatched = timeline.dispatched;
+	ptrStatistics->merged = timeline.merged;
+	ptrStatistics->reports = timeline.reports;
+	ptrStatistics->failed = timeline.failed;
+	ptrStatistics->lateEvents = timeline.lateEvents;
+	ptrStatistics->averageLatenessMicroseconds = timeline.dispatched ?
+		ticksToMicroseconds(timeline.latenessTotal, timeline.hostFrequency) / (double)timeline.dispatched : 0.0;
+	ptrStatistics->maxLatenessMicroseconds = ticksToMicroseconds(timeline.latenessMax, timeline.hostFrequency);
+	ptrStatistics->lastLatenessMicroseconds = ticksToMicroseconds(timeline.latenessLast, timeline.hostFrequency);
+	ptrStatistics->queued = timeline.eventCount;
+	ptrStatistics->running = timeline.running;
+	ReleaseSRWLockExclusive(&timeline.lock);
+}
@@ -0,0 +1,60 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace OutputTimeline {
+		/// <summary>
+		/// Prepare the timeline state of a new context
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Start the timeline thread with an empty timeline, stopping a running one first
+		/// </summary>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue start(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Stop the timeline thread, changes not yet due are discarded. Does nothing if not started
+		/// Must not be called from the timeline thread
+		/// </summary>
+		void stop(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Queue subsystems of an output state to be applied at a host time
+		/// </summary>
+		/// <param name="hostTime">QueryPerformanceCounter ticks, times already passed (or 0) are due now and applied with the next report</param>
+		/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits to take from the state</param>
+		/// <returns>DS5W_E_CURRENTLY_NOT_SUPPORTED if the timeline is not running, DS5W_E_INSUFFICIENT_BUFFER if it is full</returns>
+		DS5W_ReturnValue schedule(DS5W::DeviceContext* ptrContext, long long hostTime, const DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems);
+
+		/// <summary>
+		/// Whether the timeline runs, no change is waiting or being sent and the device was last sent the state
+		/// </summary>
+		bool matchesLastOutput(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState);
+
+		/// <summary>
+		/// Drop all changes not yet dispatched
+		/// </summary>
+		void clear(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Whether the timeline stopped itself as the device was removed
+		/// </summary>
+		bool deviceRemoved(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Copy the timeline counters
+		/// </summary>
+		void getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputTimelineStatistics* ptrStatistics);
+	}
+}
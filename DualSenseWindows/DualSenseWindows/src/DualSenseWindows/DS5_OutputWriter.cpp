@@ -0,0 +1,244 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_OutputWriter.h"
+#include "DS5_Internal.h"
+#include "DS5_Output.h"
+
+#include <Windows.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace {
+	// Write the pending state if there is one
+	// Returns false once the device is gone
+	bool flush(DS5W::DeviceContext* ptrContext)
+	{
+		DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+
+		DS5W::DS5OutputState state;
+		unsigned int subsystems = 0;
+		AcquireSRWLockExclusive(&writer.lock);
+		const bool pending = writer.pendingValid;
+		if (pending) {
+			state = writer.pending;
+			subsystems = writer.pendingSubsystems;
+			writer.pendingValid = false;
+			writer.pendingSubsystems = 0;
+		}
+		ReleaseSRWLockExclusive(&writer.lock);
+
+		if (!pending)
+			return true;
+
+		// Device already has this state
+		const bool fullState = subsystems == DS5W_OSTATE_SUBSYSTEM_ALL;
+		if (fullState && __DS5W::Output::matchesLastOutput(ptrContext, &state)) {
+			AcquireSRWLockExclusive(&writer.lock);
+			writer.unchanged++;
+			ReleaseSRWLockExclusive(&writer.lock);
+			return true;
+		}
+
+		// Output buffer and write overlapped belong to this thread while it runs
+		int outputReportLength = __DS5W::Output::createHIDOutputReport(ptrContext, &state, subsystems);
+		DS5W_RV err = DS5W::setOutputReport(ptrContext, outputReportLength, IO_TIMEOUT_MILLISECONDS);
+
+		if (DS5W_SUCCESS(err) && fullState)
+			__DS5W::Output::rememberLastOutput(ptrContext);
+		else
+			__DS5W::Output::forgetLastOutput(ptrContext);
+
+		AcquireSRWLockExclusive(&writer.lock);
+		if (DS5W_SUCCESS(err))
+			writer.written++;
+		else
+			writer.failed++;
+		ReleaseSRWLockExclusive(&writer.lock);
+
+		return err != DS5W_E_DEVICE_REMOVED;
+	}
+
+	DWORD WINAPI writerThread(LPVOID param)
+	{
+		DS5W::DeviceContext* ptrContext = (DS5W::DeviceContext*)param;
+		DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+
+		const HANDLE handles[2] = { writer.stopEvent, writer.timer };
+		bool removed = false;
+
+		for (;;) {
+			const DWORD wait = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+
+			// The last state is still written when stopping
+			if (!flush(ptrContext)) {
+				removed = true;
+				break;
+			}
+
+			if (wait != WAIT_OBJECT_0 + 1)
+				break;
+		}
+
+		// Disconnecting is left to the threads using the context
+		AcquireSRWLockExclusive(&writer.lock);
+		writer.running = false;
+		writer.deviceRemoved = removed;
+		writer.pendingValid = false;
+		writer.pendingSubsystems = 0;
+		ReleaseSRWLockExclusive(&writer.lock);
+
+		return 0;
+	}
+}
+
+void __DS5W::OutputWriter::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+
+	InitializeSRWLock(&writer.lock);
+	writer.thread = NULL;
+	writer.timer = NULL;
+	writer.stopEvent = NULL;
+	writer.pendingValid = false;
+	writer.pendingSubsystems = 0;
+	writer.rate = 0;
+	writer.submitted = 0;
+	writer.coalesced = 0;
+	writer.written = 0;
+	writer.unchanged = 0;
+	writer.failed = 0;
+	writer.running = false;
+	writer.deviceRemoved = false;
+}
+
+DS5W_ReturnValue __DS5W::OutputWriter::start(DS5W::DeviceContext* ptrContext, unsigned int rate)
+{
+	DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+
+	stop(ptrContext);
+
+	// Faster than the transport only queues reports in the driver
+	const unsigned int maxRate = ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT ? MAX_RATE_BT : MAX_RATE_USB;
+	if (rate == 0 || rate > maxRate)
+		rate = maxRate;
+
+	// Periodic timers run in whole milliseconds
+	LONG periodMilliseconds = (LONG)((1000 + rate / 2) / rate);
+	if (periodMilliseconds < 1)
+		periodMilliseconds = 1;
+
+	// High resolution timers need Windows 10 1803, older versions fall back to the system timer resolution
+	writer.timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (!writer.timer)
+		writer.timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+	writer.stopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	LARGE_INTEGER dueTime;
+	dueTime.QuadPart = -(LONGLONG)periodMilliseconds * 10000;
+	if (!writer.timer || !writer.stopEvent || !SetWaitableTimer(writer.timer, &dueTime, periodMilliseconds, NULL, NULL, FALSE)) {
+		if (writer.timer) CloseHandle(writer.timer);
+		if (writer.stopEvent) CloseHandle(writer.stopEvent);
+		writer.timer = NULL;
+		writer.stopEvent = NULL;
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	// Thread is not running yet, no lock needed
+	writer.pendingValid = false;
+	writer.pendingSubsystems = 0;
+	writer.rate = 1000 / (unsigned int)periodMilliseconds;
+	writer.submitted = 0;
+	writer.coalesced = 0;
+	writer.written = 0;
+	writer.unchanged = 0;
+	writer.failed = 0;
+	writer.running = true;
+	writer.deviceRemoved = false;
+
+	writer.thread = CreateThread(NULL, 0, writerThread, ptrContext, 0, NULL);
+	if (!writer.thread) {
+		writer.running = false;
+		CloseHandle(writer.timer);
+		CloseHandle(writer.stopEvent);
+		writer.timer = NULL;
+		writer.stopEvent = NULL;
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	return DS5W_OK;
+}
+
+void __DS5W::OutputWriter::stop(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+	if (!writer.thread)
+		return;
+
+	SetEvent(writer.stopEvent);
+	WaitForSingleObject(writer.thread, INFINITE);
+
+	CloseHandle(writer.thread);
+	CloseHandle(writer.timer);
+	CloseHandle(writer.stopEvent);
+	writer.thread = NULL;
+	writer.timer = NULL;
+	writer.stopEvent = NULL;
+}
+
+bool __DS5W::OutputWriter::submit(DS5W::DeviceContext* ptrContext, const DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems)
+{
+	DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+
+	AcquireSRWLockExclusive(&writer.lock);
+	const bool running = writer.running;
+	if (running) {
+		// Only the latest value of each subsystem is kept, subsystems submitted by others stay pending
+		if (writer.pendingValid) {
+			writer.coalesced++;
+			__DS5W::Output::mergeOutputState(&writer.pending, ptrOutputState, subsystems);
+		}
+		else {
+			writer.pending = *ptrOutputState;
+		}
+
+		writer.pendingSubsystems |= subsystems;
+		writer.pendingValid = true;
+		writer.submitted++;
+	}
+	ReleaseSRWLockExclusive(&writer.lock);
+
+	return running;
+}
+
+bool __DS5W::OutputWriter::deviceRemoved(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+
+	AcquireSRWLockExclusive(&writer.lock);
+	const bool removed = writer.deviceRemoved;
+	ReleaseSRWLockExclusive(&writer.lock);
+
+	return removed;
+}
+
+void __DS5W::OutputWriter::getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputWriterStatistics* ptrStatistics)
+{
+	DS5W::OutputWriterState& writer = ptrContext->_internal.outputWriter;
+
+	AcquireSRWLockExclusive(&writer.lock);
+	ptrStatistics->submitted = writer.submitted;
+	ptrStatistics->coalesced = writer.coalesced;
+	ptrStatistics->written = writer.written;
+	ptrStatistics->unchanged = writer.unchanged;
+	ptrStatistics->failed = writer.failed;
+	ptrStatistics->rate = writer.rate;
+	ptrStatistics->running = writer.running;
+	ReleaseSRWLockExclusive(&writer.lock);
+}
@@ -0,0 +1,57 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace OutputWriter {
+		/// <summary>
+		/// Highest flush rate of each transport, in Hz
+		/// </summary>
+		const unsigned int MAX_RATE_BT = 250;
+		const unsigned int MAX_RATE_USB = 1000;
+
+		/// <summary>
+		/// Prepare the writer state of a new context
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Start the writer thread, stopping a running one first
+		/// </summary>
+		/// <param name="ptrContext">Context to write to</param>
+		/// <param name="rate">Flush rate in Hz, 0 or above the transport maximum uses the maximum</param>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue start(DS5W::DeviceContext* ptrContext, unsigned int rate);
+
+		/// <summary>
+		/// Write the pending output state and stop the writer thread, does nothing if not started
+		/// Must not be called from the writer thread
+		/// </summary>
+		void stop(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Hand subsystems of an output state to the writer, replacing those still pending
+		/// </summary>
+		/// <param name="subsystems">DS5W_OSTATE_SUBSYSTEM_ bits to take from the state</param>
+		/// <returns>False if the writer is not running</returns>
+		bool submit(DS5W::DeviceContext* ptrContext, const DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems);
+
+		/// <summary>
+		/// Whether the writer stopped itself as the device was removed
+		/// </summary>
+		bool deviceRemoved(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Copy the writer counters
+		/// </summary>
+		void getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputWriterStatistics* ptrStatistics);
+	}
+}
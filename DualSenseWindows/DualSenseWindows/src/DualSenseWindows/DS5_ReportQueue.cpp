@@ -0,0 +1,203 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_ReportQueue.h"
+
+#include <Windows.h>
+
+namespace {
+	const LONG QUEUE_MASK = DS5W_REPORT_QUEUE_CAPACITY - 1;
+
+	// How long the input reader sleeps between checks for room and for being stopped
+	const DWORD BLOCK_WAIT_MILLISECONDS = 1;
+
+	// Interlocked read, the counters are shared between the input reader and the consumer
+	LONG load(volatile LONG* value)
+	{
+		return InterlockedCompareExchange(value, 0, 0);
+	}
+
+	LONG64 load64(volatile LONG64* value)
+	{
+		return InterlockedExchangeAdd64(value, 0);
+	}
+
+	unsigned int queued(LONG writeCount, LONG readCount)
+	{
+		return (unsigned int)((ULONG)writeCount - (ULONG)readCount);
+	}
+
+	// Wait until the consumer made room or the reader or engine stops reading the device
+	// Returns false if the queue is still full
+	bool waitForRoom(DS5W::DeviceContext* ptrContext, LONG writeCount)
+	{
+		DS5W::ReportQueueState& queue = ptrContext->_internal.reportQueue;
+
+		InterlockedIncrement64(&queue.blocked);
+		InterlockedExchange(&queue.producerWaiting, TRUE);
+
+		bool room = false;
+		while (!ptrContext->_internal.inputReader.stopRequested && !ptrContext->_internal.inputEngine.stopRequested) {
+			// Checked after announcing the wait, a pop in between is not missed for longer than one timeout
+			if (queued(writeCount, load(&queue.readCount)) < DS5W_REPORT_QUEUE_CAPACITY) {
+				room = true;
+				break;
+			}
+
+			WaitForSingleObject(queue.spaceEvent, BLOCK_WAIT_MILLISECONDS);
+		}
+
+		InterlockedExchange(&queue.producerWaiting, FALSE);
+		return room;
+	}
+}
+
+void __DS5W::ReportQueue::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::ReportQueueState& queue = ptrContext->_internal.reportQueue;
+
+	queue.writeCount = 0;
+	queue.readCount = 0;
+	queue.spaceEvent = NULL;
+	queue.producerWaiting = FALSE;
+	queue.policy = DS5W::ReportQueuePolicy::DropOldest;
+	queue.enabled = false;
+	queue.pushed = 0;
+	queue.popped = 0;
+	queue.dropped = 0;
+	queue.blocked = 0;
+	queue.highWater = 0;
+}
+
+DS5W_ReturnValue __DS5W::ReportQueue::configure(DS5W::DeviceContext* ptrContext, bool enabled, DS5W::ReportQueuePolicy policy)
+{
+	DS5W::ReportQueueState& queue = ptrContext->_internal.reportQueue;
+
+	if (policy != DS5W::ReportQueuePolicy::DropOldest && policy != DS5W::ReportQueuePolicy::DropNewest && policy != DS5W::ReportQueuePolicy::Block)
+		return DS5W_E_INVALID_ARGS;
+
+	// Only the Block policy waits
+	if (enabled && policy == DS5W::ReportQueuePolicy::Block && !queue.spaceEvent) {
+		queue.spaceEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (!queue.spaceEvent)
+			return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	// Input reader is stopped, no interlocked access needed
+	queue.writeCount = 0;
+	queue.readCount = 0;
+	queue.producerWaiting = FALSE;
+	queue.policy = policy;
+	queue.enabled = enabled;
+	queue.pushed = 0;
+	queue.popped = 0;
+	queue.dropped = 0;
+	queue.blocked = 0;
+	queue.highWater = 0;
+
+	return DS5W_OK;
+}
+
+void __DS5W::ReportQueue::release(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::ReportQueueState& queue = ptrContext->_internal.reportQueue;
+
+	if (queue.spaceEvent)
+		CloseHandle(queue.spaceEvent);
+	queue.spaceEvent = NULL;
+	queue.enabled = false;
+}
+
+void __DS5W::ReportQueue::push(DS5W::DeviceContext* ptrContext, const DS5W::DS5InputState* ptrInputState)
+{
+	DS5W::ReportQueueState& queue = ptrContext->_internal.reportQueue;
+
+	// Only this thread writes writeCount
+	const LONG writeCount = queue.writeCount;
+	const LONG readCount = load(&queue.readCount);
+
+	if (queued(writeCount, readCount) >= DS5W_REPORT_QUEUE_CAPACITY) {
+		switch (queue.policy) {
+		case DS5W::ReportQueuePolicy::DropNewest:
+			InterlockedIncrement64(&queue.dropped);
+			return;
+
+		// Fails only if the consumer popped the oldest report first, there is room either way
+		case DS5W::ReportQueuePolicy::DropOldest:
+			if (InterlockedCompareExchange(&queue.readCount, readCount + 1, readCount) == readCount)
+				InterlockedIncrement64(&queue.dropped);
+			break;
+
+		case DS5W::ReportQueuePolicy::Block:
+			if (!waitForRoom(ptrContext, writeCount)) {
+				InterlockedIncrement64(&queue.dropped);
+				return;
+			}
+			break;
+		}
+	}
+
+	DS5W::DS5QueuedReport& report = queue.reports[writeCount & QUEUE_MASK];
+	report.state = *ptrInputState;
+	report.receiveTime = ptrContext->_internal.clockSync.lastReceiveTime;
+
+	// Publish after the report is written
+	InterlockedExchange(&queue.writeCount, writeCount + 1);
+	InterlockedIncrement64(&queue.pushed);
+
+	// Only this thread writes highWater
+	const LONG count = (LONG)queued(writeCount + 1, load(&queue.readCount));
+	if (count > queue.highWater)
+		InterlockedExchange(&queue.highWater, count);
+}
+
+unsigned int __DS5W::ReportQueue::pop(DS5W::DeviceContext* ptrContext, DS5W::DS5QueuedReport* ptrReports, unsigned int maxReports)
+{
+	DS5W::ReportQueueState& queue = ptrContext->_internal.reportQueue;
+
+	unsigned int count;
+	for (;;) {
+		const LONG readCount = load(&queue.readCount);
+		const LONG writeCount = load(&queue.writeCount);
+
+		count = queued(writeCount, readCount);
+		if (count > maxReports)
+			count = maxReports;
+		if (count == 0)
+			return 0;
+
+		for (unsigned int i = 0; i < count; i++) {
+			ptrReports[i] = queue.reports[(readCount + (LONG)i) & QUEUE_MASK];
+		}
+
+		// Input reader dropped the oldest report while copying, copied reports may have been overwritten
+		if (InterlockedCompareExchange(&queue.readCount, readCount + (LONG)count, readCount) == readCount)
+			break;
+	}
+
+	InterlockedExchangeAdd64(&queue.popped, count);
+
+	// Wake the input reader only if it waits
+	if (queue.policy == DS5W::ReportQueuePolicy::Block && load(&queue.producerWaiting))
+		SetEvent(queue.spaceEvent);
+
+	return count;
+}
+
+void __DS5W::ReportQueue::getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5ReportQueueStatistics* ptrStatistics)
+{
+	DS5W::ReportQueueState& queue = ptrContext->_internal.reportQueue;
+
+	ptrStatistics->pushed = (unsigned long long)load64(&queue.pushed);
+	ptrStatistics->popped = (unsigned long long)load64(&queue.popped);
+	ptrStatistics->dropped = (unsigned long long)load64(&queue.dropped);
+	ptrStatistics->blocked = (unsigned long long)load64(&queue.blocked);
+	ptrStatistics->highWater = (unsigned int)load(&queue.highWater);
+	ptrStatistics->queued = queued(load(&queue.writeCount), load(&queue.readCount));
+	ptrStatistics->policy = queue.policy;
+	ptrStatistics->enabled = queue.enabled;
+}
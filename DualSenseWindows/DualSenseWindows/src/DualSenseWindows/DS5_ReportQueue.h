@@ -0,0 +1,48 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace ReportQueue {
+		/// <summary>
+		/// Prepare the queue state of a new context, reports are not queued
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Enable or disable queueing and empty the queue
+		/// Must only be called while the input reader is stopped
+		/// </summary>
+		/// <returns>Error code</returns>
+		DS5W_ReturnValue configure(DS5W::DeviceContext* ptrContext, bool enabled, DS5W::ReportQueuePolicy policy);
+
+		/// <summary>
+		/// Free the event of the Block policy
+		/// </summary>
+		void release(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Queue a decoded report with the receive time of the last read, only called from the input reader thread
+		/// </summary>
+		void push(DS5W::DeviceContext* ptrContext, const DS5W::DS5InputState* ptrInputState);
+
+		/// <summary>
+		/// Take up to maxReports of the oldest reports, only called from one thread at a time
+		/// </summary>
+		/// <returns>Number of reports copied</returns>
+		unsigned int pop(DS5W::DeviceContext* ptrContext, DS5W::DS5QueuedReport* ptrReports, unsigned int maxReports);
+
+		/// <summary>
+		/// Copy the queue counters
+		/// </summary>
+		void getStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5ReportQueueStatistics* ptrStatistics);
+	}
+}
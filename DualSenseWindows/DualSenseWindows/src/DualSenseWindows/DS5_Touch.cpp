@@ -0,0 +1,376 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include "DS5_Touch.h"
+#include "DS5_Input.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace {
+	// Distances are in touchpad pixels (DS_TOUCHPAD_WIDTH x DS_TOUCHPAD_HEIGHT), times in seconds of sensor time
+
+	// Longest report gap velocity is measured over, longer gaps restart the measurement
+	// 25 reports over USB, a stalled read would otherwise turn a whole movement into one sample
+	const float MAX_DELTA_SECONDS = 0.1f;
+
+	// Weight of a new sample in the velocity and acceleration averages
+	// Damps the jitter of the positions while still following a flick within a few reports
+	const float SMOOTHING = 0.5f;
+
+	// Tap: short touch that stays in place
+	// 30 pixels covers the wobble of a resting finger
+	const float TAP_MAX_SECONDS = 0.25f;
+	const float TAP_MAX_TRAVEL = 30.0f;
+
+	// Swipe: long, quick movement
+	// About an eighth of the pad width, slower or shorter movements are left to the contact positions
+	const float SWIPE_MAX_SECONDS = 0.6f;
+	const float SWIPE_MIN_TRAVEL = 250.0f;
+
+	// Movement of two fingers before deciding between pinch and scroll
+	// Fingers drift apart a little while scrolling, so the finger distance must change further than the center moves
+	const float PINCH_THRESHOLD = 60.0f;
+	const float SCROLL_THRESHOLD = 40.0f;
+
+	/// <summary>
+	/// Two finger gesture state of TouchTrackerState::pairMode
+	/// </summary>
+	enum PairMode : unsigned char {
+		// Less than two fingers down
+		PAIR_NONE = 0,
+
+		// Two fingers down, not moved far enough to tell the gesture
+		PAIR_UNDECIDED = 1,
+
+		PAIR_PINCH = 2,
+		PAIR_SCROLL = 3,
+	};
+
+	/// <summary>
+	/// Touch point as read from the report
+	/// </summary>
+	struct RawTouch {
+		float x;
+		float y;
+		unsigned char id;
+		bool down;
+	};
+
+	RawTouch readTouch(const unsigned char* hidInBuffer, int offset)
+	{
+		const UINT32 raw = *(UINT32*)(&hidInBuffer[offset]);
+
+		RawTouch touch;
+		touch.x = (float)((raw & 0x000FFF00) >> 8);
+		touch.y = (float)((raw & 0xFFF00000) >> 20);
+		touch.id = raw & 127;
+		touch.down = (raw & (1 << 7)) == 0;
+		return touch;
+	}
+
+	float secondsBetween(unsigned int from, unsigned int to)
+	{
+		// Modular difference handles wraparound
+		return (float)(to - from) * (1.0f / DS_SENSOR_TIMESTAMP_PER_SECOND);
+	}
+
+	void pushGesture(DS5W::TouchTrackerState& tracker, const DS5W::DS5TouchGesture& gesture)
+	{
+		AcquireSRWLockExclusive(&tracker.gestureLock);
+
+		// Full queue drops the oldest gesture
+		if (tracker.gestureCount == DS5W_TOUCH_GESTURE_QUEUE) {
+			tracker.gestureHead = (tracker.gestureHead + 1) % DS5W_TOUCH_GESTURE_QUEUE;
+			tracker.gestureCount--;
+			tracker.droppedGestures++;
+		}
+
+		tracker.gestures[(tracker.gestureHead + tracker.gestureCount) % DS5W_TOUCH_GESTURE_QUEUE] = gesture;
+		tracker.gestureCount++;
+
+		ReleaseSRWLockExclusive(&tracker.gestureLock);
+	}
+
+	DS5W::DS5TouchGesture makeGesture(DS5W::TouchGestureType type, DS5W::TouchGesturePhase phase, unsigned int currentTime, float x, float y)
+	{
+		DS5W::DS5TouchGesture gesture;
+		gesture.type = type;
+		gesture.phase = phase;
+		gesture.currentTime = currentTime;
+		gesture.x = x;
+		gesture.y = y;
+		gesture.deltaX = 0.0f;
+		gesture.deltaY = 0.0f;
+		gesture.velocityX = 0.0f;
+		gesture.velocityY = 0.0f;
+		gesture.scale = 1.0f;
+		return gesture;
+	}
+
+	void startContact(DS5W::TouchTrackerState& tracker, int index, const RawTouch& touch, unsigned int currentTime)
+	{
+		DS5W::DS5TouchContact& contact = tracker.contacts[index];
+		contact.x = touch.x;
+		contact.y = touch.y;
+		contact.velocityX = 0.0f;
+		contact.velocityY = 0.0f;
+		contact.accelerationX = 0.0f;
+		contact.accelerationY = 0.0f;
+		contact.id = touch.id;
+		contact.down = true;
+
+		tracker.startX[index] = touch.x;
+		tracker.startY[index] = touch.y;
+		tracker.startTime[index] = currentTime;
+	}
+
+	void moveContact(DS5W::DS5TouchContact& contact, const RawTouch& touch, float dt)
+	{
+		if (dt > 0.0f) {
+			const float velocityX = contact.velocityX + ((touch.x - contact.x) / dt - contact.velocityX) * SMOOTHING;
+			const float velocityY = contact.velocityY + ((touch.y - contact.y) / dt - contact.velocityY) * SMOOTHING;
+			contact.accelerationX += ((velocityX - contact.velocityX) / dt - contact.accelerationX) * SMOOTHING;
+			contact.accelerationY += ((velocityY - contact.velocityY) / dt - contact.accelerationY) * SMOOTHING;
+			contact.velocityX = velocityX;
+			contact.velocityY = velocityY;
+		}
+
+		contact.x = touch.x;
+		contact.y = touch.y;
+	}
+
+	// Single finger gestures are decided when the finger lifts
+	void releaseContact(DS5W::TouchTrackerState& tracker, int index, unsigned int currentTime)
+	{
+		DS5W::DS5TouchContact& contact = tracker.contacts[index];
+		contact.down = false;
+
+		if (tracker.sessionContacts != 1)
+			return;
+
+		const float seconds = secondsBetween(tracker.startTime[index], currentTime);
+		const float deltaX = contact.x - tracker.startX[index];
+		const float deltaY = contact.y - tracker.startY[index];
+		const float travel = sqrtf(deltaX * deltaX + deltaY * deltaY);
+
+		if (seconds <= TAP_MAX_SECONDS && travel <= TAP_MAX_TRAVEL) {
+			pushGesture(tracker, makeGesture(DS5W::TouchGestureType::Tap, DS5W::TouchGesturePhase::End, currentTime, tracker.startX[index], tracker.startY[index]));
+		}
+		else if (seconds <= SWIPE_MAX_SECONDS && travel >= SWIPE_MIN_TRAVEL) {
+			DS5W::DS5TouchGesture gesture = makeGesture(DS5W::TouchGestureType::Swipe, DS5W::TouchGesturePhase::End, currentTime, tracker.startX[index], tracker.startY[index]);
+			gesture.deltaX = deltaX;
+			gesture.deltaY = deltaY;
+			gesture.velocityX = contact.velocityX;
+			gesture.velocityY = contact.velocityY;
+			pushGesture(tracker, gesture);
+		}
+	}
+
+	void updatePair(DS5W::TouchTrackerState& tracker, unsigned int currentTime, float dt)
+	{
+		const DS5W::DS5TouchContact& a = tracker.contacts[0];
+		const DS5W::DS5TouchContact& b = tracker.contacts[1];
+		const float distance = sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+		const float centerX = (a.x + b.x) * 0.5f;
+		const float centerY = (a.y + b.y) * 0.5f;
+
+		// Second finger just touched down
+		if (tracker.pairMode == PAIR_NONE) {
+			tracker.pairMode = PAIR_UNDECIDED;
+			tracker.pairStartDistance = distance;
+			tracker.pairStartCenterX = centerX;
+			tracker.pairStartCenterY = centerY;
+			tracker.pairCenterX = centerX;
+			tracker.pairCenterY = centerY;
+			return;
+		}
+
+		const float deltaX = centerX - tracker.pairCenterX;
+		const float deltaY = centerY - tracker.pairCenterY;
+		const float scale = tracker.pairStartDistance > 0.0f ? distance / tracker.pairStartDistance : 1.0f;
+		DS5W::TouchGesturePhase phase = DS5W::TouchGesturePhase::Update;
+
+		if (tracker.pairMode == PAIR_UNDECIDED) {
+			const float movedX = centerX - tracker.pairStartCenterX;
+			const float movedY = centerY - tracker.pairStartCenterY;
+			if (fabsf(distance - tracker.pairStartDistance) > PINCH_THRESHOLD)
+				tracker.pairMode = PAIR_PINCH;
+			else if (movedX * movedX + movedY * movedY > SCROLL_THRESHOLD * SCROLL_THRESHOLD)
+				tracker.pairMode = PAIR_SCROLL;
+			else
+				return;
+
+			phase = DS5W::TouchGesturePhase::Begin;
+		}
+
+		if (tracker.pairMode == PAIR_PINCH) {
+			if (scale != tracker.pairScale || phase == DS5W::TouchGesturePhase::Begin) {
+				DS5W::DS5TouchGesture gesture = makeGesture(DS5W::TouchGestureType::Pinch, phase, currentTime, centerX, centerY);
+				gesture.scale = scale;
+				pushGesture(tracker, gesture);
+				tracker.pairScale = scale;
+			}
+		}
+		else if (deltaX != 0.0f || deltaY != 0.0f || phase == DS5W::TouchGesturePhase::Begin) {
+			DS5W::DS5TouchGesture gesture = makeGesture(DS5W::TouchGestureType::Scroll, phase, currentTime, centerX, centerY);
+			gesture.deltaX = deltaX;
+			gesture.deltaY = deltaY;
+			if (dt > 0.0f) {
+				gesture.velocityX = deltaX / dt;
+				gesture.velocityY = deltaY / dt;
+			}
+			pushGesture(tracker, gesture);
+		}
+
+		tracker.pairCenterX = centerX;
+		tracker.pairCenterY = centerY;
+	}
+
+	// A pinch or scroll ends when either finger lifts, contacts still hold their last positions
+	void endPair(DS5W::TouchTrackerState& tracker, unsigned int currentTime)
+	{
+		if (tracker.pairMode == PAIR_PINCH) {
+			const DS5W::DS5TouchContact& a = tracker.contacts[0];
+			const DS5W::DS5TouchContact& b = tracker.contacts[1];
+			const float distance = sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+
+			DS5W::DS5TouchGesture gesture = makeGesture(DS5W::TouchGestureType::Pinch, DS5W::TouchGesturePhase::End, currentTime, tracker.pairCenterX, tracker.pairCenterY);
+			gesture.scale = tracker.pairStartDistance > 0.0f ? distance / tracker.pairStartDistance : 1.0f;
+			pushGesture(tracker, gesture);
+		}
+		else if (tracker.pairMode == PAIR_SCROLL) {
+			pushGesture(tracker, makeGesture(DS5W::TouchGestureType::Scroll, DS5W::TouchGesturePhase::End, currentTime, tracker.pairCenterX, tracker.pairCenterY));
+		}
+
+		tracker.pairMode = PAIR_NONE;
+	}
+}
+
+void __DS5W::Touch::init(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::TouchTrackerState& tracker = ptrContext->_internal.touchTracker;
+	InitializeSRWLock(&tracker.gestureLock);
+	tracker.enabled = false;
+	reset(ptrContext);
+}
+
+void __DS5W::Touch::reset(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::TouchTrackerState& tracker = ptrContext->_internal.touchTracker;
+	memset(tracker.contacts, 0, sizeof(tracker.contacts));
+	tracker.pairMode = PAIR_NONE;
+	tracker.sessionContacts = 0;
+	tracker.timestamp = 0;
+	tracker.initialized = false;
+
+	AcquireSRWLockExclusive(&tracker.gestureLock);
+	tracker.gestureHead = 0;
+	tracker.gestureCount = 0;
+	tracker.droppedGestures = 0;
+	ReleaseSRWLockExclusive(&tracker.gestureLock);
+}
+
+void __DS5W::Touch::update(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::TouchTrackerState& tracker = ptrContext->_internal.touchTracker;
+	if (!tracker.enabled)
+		return;
+
+	const unsigned char* hidInBuffer = __DS5W::Input::heldReportBody(ptrContext);
+	const unsigned int currentTime = *(unsigned int*)&hidInBuffer[0x1B];
+	if (tracker.initialized && currentTime == tracker.timestamp)
+		return;
+
+	float dt = tracker.initialized ? secondsBetween(tracker.timestamp, currentTime) : 0.0f;
+	if (dt > MAX_DELTA_SECONDS)
+		dt = 0.0f;
+
+	tracker.timestamp = currentTime;
+	tracker.initialized = true;
+
+	RawTouch touches[2] = { readTouch(hidInBuffer, 0x20), readTouch(hidInBuffer, 0x24) };
+	bool used[2] = { false, false };
+
+	// Follow contacts by id, lift those that disappeared
+	for (int i = 0; i < 2; i++) {
+		DS5W::DS5TouchContact& contact = tracker.contacts[i];
+		if (!contact.down)
+			continue;
+
+		int match = -1;
+		for (int j = 0; j < 2; j++) {
+			if (!used[j] && touches[j].down && touches[j].id == contact.id) {
+				match = j;
+				break;
+			}
+		}
+
+		if (match >= 0) {
+			used[match] = true;
+			moveContact(contact, touches[match], dt);
+		}
+		else {
+			endPair(tracker, currentTime);
+			releaseContact(tracker, i, currentTime);
+		}
+	}
+
+	// Keep contacts in touch down order
+	if (!tracker.contacts[0].down && tracker.contacts[1].down) {
+		tracker.contacts[0] = tracker.contacts[1];
+		tracker.startX[0] = tracker.startX[1];
+		tracker.startY[0] = tracker.startY[1];
+		tracker.startTime[0] = tracker.startTime[1];
+		tracker.contacts[1].down = false;
+	}
+
+	// Remaining touches are new fingers
+	for (int j = 0; j < 2; j++) {
+		if (used[j] || !touches[j].down)
+			continue;
+
+		const int index = tracker.contacts[0].down ? 1 : 0;
+		startContact(tracker, index, touches[j], currentTime);
+	}
+
+	const unsigned char downCount = (tracker.contacts[0].down ? 1 : 0) + (tracker.contacts[1].down ? 1 : 0);
+	if (downCount == 0)
+		tracker.sessionContacts = 0;
+	else if (downCount > tracker.sessionContacts)
+		tracker.sessionContacts = downCount;
+
+	if (downCount == 2)
+		updatePair(tracker, currentTime, dt);
+}
+
+void __DS5W::Touch::getTouchState(const DS5W::DeviceContext* ptrContext, DS5W::DS5TouchState* ptrTouchState)
+{
+	const DS5W::TouchTrackerState& tracker = ptrContext->_internal.touchTracker;
+	ptrTouchState->contacts[0] = tracker.contacts[0];
+	ptrTouchState->contacts[1] = tracker.contacts[1];
+	ptrTouchState->currentTime = tracker.timestamp;
+	ptrTouchState->droppedGestures = tracker.droppedGestures;
+}
+
+unsigned int __DS5W::Touch::popGestures(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchGesture* ptrGestures, unsigned int maxGestures)
+{
+	DS5W::TouchTrackerState& tracker = ptrContext->_internal.touchTracker;
+
+	AcquireSRWLockExclusive(&tracker.gestureLock);
+
+	unsigned int count = 0;
+	while (count < maxGestures && tracker.gestureCount) {
+		ptrGestures[count++] = tracker.gestures[tracker.gestureHead];
+		tracker.gestureHead = (tracker.gestureHead + 1) % DS5W_TOUCH_GESTURE_QUEUE;
+		tracker.gestureCount--;
+	}
+
+	ReleaseSRWLockExclusive(&tracker.gestureLock);
+
+	return count;
+}
@@ -0,0 +1,43 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+#pragma once
+
+#include <DualSenseWindows/DSW_Api.h>
+#include <DualSenseWindows/Device.h>
+#include <DualSenseWindows/DS5State.h>
+
+namespace __DS5W {
+	namespace Touch {
+		/// <summary>
+		/// Prepare the tracker of a new context, tracking starts disabled
+		/// </summary>
+		void init(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Forget all contacts and queued gestures
+		/// </summary>
+		void reset(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Follow the touch contacts of the context's held input report and queue recognized gestures
+		/// Does nothing if tracking is disabled or the report was already used
+		/// </summary>
+		void update(DS5W::DeviceContext* ptrContext);
+
+		/// <summary>
+		/// Copy the tracked contacts
+		/// </summary>
+		void getTouchState(const DS5W::DeviceContext* ptrContext, DS5W::DS5TouchState* ptrTouchState);
+
+		/// <summary>
+		/// Move queued gestures out of the context, oldest first
+		/// Safe to call while another thread decodes reports
+		/// </summary>
+		/// <returns>Number of gestures written</returns>
+		unsigned int popGestures(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchGesture* ptrGestures, unsigned int maxGestures);
+	}
+}
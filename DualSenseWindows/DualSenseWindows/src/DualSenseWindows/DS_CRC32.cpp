@@ -1,4 +1,9 @@
 #include "DS_CRC32.h"
+#include "DS5_Cpu.h"
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#include <string.h>
 
 // Hash tabel
 const UINT32 __DS5W::CRC32::hashTable[256] = {
@@ -39,7 +44,230 @@ const UINT32 __DS5W::CRC32::hashTable[256] = {
 // Hash seed
 const UINT32 __DS5W::CRC32::crcSeed = 0xeada2d49;
 
+namespace {
+    // The seeded table works on the inverted register of the standard reflected CRC32 (polynomial 0xEDB88320)
+    // and crcSeed is the register after the report header byte 0xA2, so the kernels below run the
+    // standard algorithm from ~crcSeed and invert the result
+    const UINT32 POLYNOMIAL = 0xEDB88320;
+
+    // Slicing tables, table[k][i] is the CRC of byte i followed by k zero bytes
+    struct SliceTables {
+        UINT32 table[16][256];
+
+        SliceTables()
+        {
+            for (UINT32 i = 0; i < 256; i++) {
+                UINT32 crc = i;
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+                }
+                table[0][i] = crc;
+            }
+
+            for (int k = 1; k < 16; k++) {
+                for (int i = 0; i < 256; i++) {
+                    table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    const SliceTables& sliceTables()
+    {
+        static const SliceTables tables;
+        return tables;
+    }
+
+    // Position tables, table[k][i] is the CRC of byte i followed by k zero bytes for every position of an update
+    // The CRC is linear, the hashes of two buffers differ by the sum of these for every byte that differs
+    struct PositionTables {
+        UINT32 table[__DS5W::CRC32::MAX_UPDATE_LENGTH][256];
+
+        PositionTables()
+        {
+            const SliceTables& slices = sliceTables();
+            memcpy(table, slices.table, sizeof(slices.table));
+
+            for (size_t k = 16; k < __DS5W::CRC32::MAX_UPDATE_LENGTH; k++) {
+                for (int i = 0; i < 256; i++) {
+                    table[k][i] = (table[k - 1][i] >> 8) ^ slices.table[0][table[k - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    const PositionTables& positionTables()
+    {
+        static const PositionTables tables;
+        return tables;
+    }
+
+    inline unsigned long long load64(const unsigned char* buffer)
+    {
+        unsigned long long value;
+        memcpy(&value, buffer, sizeof(value));
+        return value;
+    }
+
+    inline UINT32 load32(const unsigned char* buffer)
+    {
+        UINT32 value;
+        memcpy(&value, buffer, sizeof(value));
+        return value;
+    }
+
+    inline UINT32 bytewise(const UINT32 (&table)[16][256], UINT32 crc, const unsigned char* buffer, size_t len)
+    {
+        for (size_t i = 0; i < len; i++) {
+            crc = table[0][(crc ^ buffer[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    UINT32 slicing8(UINT32 crc, const unsigned char* buffer, size_t len)
+    {
+        const UINT32 (&t)[16][256] = sliceTables().table;
+
+        while (len >= 8) {
+            const UINT32 one = load32(buffer) ^ crc;
+            const UINT32 two = load32(buffer + 4);
+            crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+                t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+            buffer += 8;
+            len -= 8;
+        }
+
+        return bytewise(t, crc, buffer, len);
+    }
+
+    UINT32 slicing16(UINT32 crc, const unsigned char* buffer, size_t len)
+    {
+        const UINT32 (&t)[16][256] = sliceTables().table;
+
+        while (len >= 16) {
+            const UINT32 one = load32(buffer) ^ crc;
+            const UINT32 two = load32(buffer + 4);
+            const UINT32 three = load32(buffer + 8);
+            const UINT32 four = load32(buffer + 12);
+            crc = t[15][one & 0xFF] ^ t[14][(one >> 8) & 0xFF] ^ t[13][(one >> 16) & 0xFF] ^ t[12][one >> 24] ^
+                t[11][two & 0xFF] ^ t[10][(two >> 8) & 0xFF] ^ t[9][(two >> 16) & 0xFF] ^ t[8][two >> 24] ^
+                t[7][three & 0xFF] ^ t[6][(three >> 8) & 0xFF] ^ t[5][(three >> 16) & 0xFF] ^ t[4][three >> 24] ^
+                t[3][four & 0xFF] ^ t[2][(four >> 8) & 0xFF] ^ t[1][(four >> 16) & 0xFF] ^ t[0][four >> 24];
+            buffer += 16;
+            len -= 16;
+        }
+
+        return slicing8(crc, buffer, len);
+    }
+
+    // Folding constants for the reflected polynomial, as used by zlib/Chromium
+    alignas(16) const unsigned long long K1K2[2] = { 0x0154442bd4, 0x01c6e41596 };
+    alignas(16) const unsigned long long K3K4[2] = { 0x01751997d0, 0x00ccaa009e };
+    alignas(16) const unsigned long long K5K0[2] = { 0x0163cd6124, 0x0000000000 };
+    alignas(16) const unsigned long long POLY[2] = { 0x01db710641, 0x01f7011641 };
+
+    inline __m128i fold(__m128i accumulator, __m128i constants, __m128i data)
+    {
+        const __m128i low = _mm_clmulepi64_si128(accumulator, constants, 0x00);
+        const __m128i high = _mm_clmulepi64_si128(accumulator, constants, 0x11);
+        return _mm_xor_si128(_mm_xor_si128(high, low), data);
+    }
+
+    // len must be at least 64 and a multiple of 16
+    UINT32 carryless(UINT32 crc, const unsigned char* buffer, size_t len)
+    {
+        __m128i x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(buffer + 0x00)), _mm_cvtsi32_si128((int)crc));
+        __m128i x2 = _mm_loadu_si128((const __m128i*)(buffer + 0x10));
+        __m128i x3 = _mm_loadu_si128((const __m128i*)(buffer + 0x20));
+        __m128i x4 = _mm_loadu_si128((const __m128i*)(buffer + 0x30));
+        buffer += 64;
+        len -= 64;
+
+        // Fold 4 lanes in parallel
+        __m128i k = _mm_load_si128((const __m128i*)K1K2);
+        while (len >= 64) {
+            x1 = fold(x1, k, _mm_loadu_si128((const __m128i*)(buffer + 0x00)));
+            x2 = fold(x2, k, _mm_loadu_si128((const __m128i*)(buffer + 0x10)));
+            x3 = fold(x3, k, _mm_loadu_si128((const __m128i*)(buffer + 0x20)));
+            x4 = fold(x4, k, _mm_loadu_si128((const __m128i*)(buffer + 0x30)));
+            buffer += 64;
+            len -= 64;
+        }
+
+        // Fold lanes into one
+        k = _mm_load_si128((const __m128i*)K3K4);
+        x1 = fold(x1, k, x2);
+        x1 = fold(x1, k, x3);
+        x1 = fold(x1, k, x4);
+
+        // Remaining 16 byte blocks
+        while (len >= 16) {
+            x1 = fold(x1, k, _mm_loadu_si128((const __m128i*)buffer));
+            buffer += 16;
+            len -= 16;
+        }
+
+        // 128 to 64 bits
+        const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+        __m128i x0 = _mm_clmulepi64_si128(x1, k, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x0);
+
+        k = _mm_load_si128((const __m128i*)K5K0);
+        x0 = _mm_srli_si128(x1, 4);
+        x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00);
+        x1 = _mm_xor_si128(x1, x0);
+
+        // Barrett reduction to 32 bits
+        k = _mm_load_si128((const __m128i*)POLY);
+        x0 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+        x0 = _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), k, 0x00);
+        x1 = _mm_xor_si128(x1, x0);
+
+        return (UINT32)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+    }
+
+    typedef UINT32(*CrcKernel)(const unsigned char* buffer, size_t len);
+
+    CrcKernel selectKernel()
+    {
+        if (__DS5W::Cpu::hasPCLMUL())
+            return &__DS5W::CRC32::computeCarryless;
+
+        return &__DS5W::CRC32::computeSlicing16;
+    }
+}
+
 UINT32 __DS5W::CRC32::compute(unsigned char* buffer, size_t len) {
+    // Fastest kernel the CPU supports, picked once
+    static const CrcKernel kernel = selectKernel();
+    return kernel(buffer, len);
+}
+
+UINT32 __DS5W::CRC32::update(UINT32 previousCrc, const unsigned char* previous, const unsigned char* buffer, size_t len) {
+    if (len > MAX_UPDATE_LENGTH)
+        return compute(const_cast<unsigned char*>(buffer), len);
+
+    const UINT32 (&t)[MAX_UPDATE_LENGTH][256] = positionTables().table;
+    UINT32 crc = previousCrc;
+    size_t i = 0;
+
+    // Skip 8 equal bytes at a time, little endian so the low byte of the difference is the first byte
+    for (; i + 8 <= len; i += 8) {
+        unsigned long long difference = load64(previous + i) ^ load64(buffer + i);
+        for (size_t distance = len - 1 - i; difference; distance--) {
+            crc ^= t[distance][difference & 0xFF];
+            difference >>= 8;
+        }
+    }
+
+    for (; i < len; i++) {
+        crc ^= t[len - 1 - i][previous[i] ^ buffer[i]];
+    }
+
+    return crc;
+}
+
+UINT32 __DS5W::CRC32::computeBytewise(const unsigned char* buffer, size_t len) {
     // Start point
     UINT32 result = crcSeed;
     
@@ -52,3 +280,25 @@ UINT32 __DS5W::CRC32::compute(unsigned char* buffer, size_t len) {
     // Return result
     return result;
 }
+
+UINT32 __DS5W::CRC32::computeSlicing8(const unsigned char* buffer, size_t len) {
+    return ~slicing8(~crcSeed, buffer, len);
+}
+
+UINT32 __DS5W::CRC32::computeSlicing16(const unsigned char* buffer, size_t len) {
+    return ~slicing16(~crcSeed, buffer, len);
+}
+
+UINT32 __DS5W::CRC32::computeCarryless(const unsigned char* buffer, size_t len) {
+    UINT32 crc = ~crcSeed;
+
+    // Whole 16 byte blocks by folding, the rest with tables
+    if (len >= 64) {
+        const size_t folded = len & ~(size_t)15;
+        crc = carryless(crc, buffer, folded);
+        buffer += folded;
+        len -= folded;
+    }
+
+    return ~slicing16(crc, buffer, len);
+}
@@ -40,5 +40,54 @@ namespace __DS5W {
 		/// <param name="len">Length of buffer</param>
 		/// <returns>Computed crc value</returns>
 		static UINT32 compute(unsigned char* buffer, size_t len);
+
+		/// <summary>
+		/// Compute the CRC32 Hash one byte at a time with the seeded table, reference for the other kernels
+		/// </summary>
+		/// <param name="buffer">Input buffer</param>
+		/// <param name="len">Length of buffer</param>
+		/// <returns>Computed crc value</returns>
+		static UINT32 computeBytewise(const unsigned char* buffer, size_t len);
+
+		/// <summary>
+		/// Compute the CRC32 Hash 8 bytes at a time with slicing tables
+		/// </summary>
+		/// <param name="buffer">Input buffer</param>
+		/// <param name="len">Length of buffer</param>
+		/// <returns>Computed crc value</returns>
+		static UINT32 computeSlicing8(const unsigned char* buffer, size_t len);
+
+		/// <summary>
+		/// Compute the CRC32 Hash 16 bytes at a time with slicing tables
+		/// </summary>
+		/// <param name="buffer">Input buffer</param>
+		/// <param name="len">Length of buffer</param>
+		/// <returns>Computed crc value</returns>
+		static UINT32 computeSlicing16(const unsigned char* buffer, size_t len);
+
+		/// <summary>
+		/// Compute the CRC32 Hash by folding 64 bytes at a time with carry-less multiplication
+		/// Requires PCLMULQDQ, buffers shorter than 64 bytes use slicing tables
+		/// </summary>
+		/// <param name="buffer">Input buffer</param>
+		/// <param name="len">Length of buffer</param>
+		/// <returns>Computed crc value</returns>
+		static UINT32 computeCarryless(const unsigned char* buffer, size_t len);
+
+		/// <summary>
+		/// Longest buffer update can handle, the body of a BT output report
+		/// </summary>
+		static const size_t MAX_UPDATE_LENGTH = DS_OUTPUT_REPORT_BT_SIZE - sizeof(UINT32);
+
+		/// <summary>
+		/// Compute the CRC32 Hash of a buffer from the hash of a previous buffer of the same length
+		/// Only bytes that differ are hashed, each through a table of its contribution at that position
+		/// </summary>
+		/// <param name="previousCrc">Computed crc value of previous</param>
+		/// <param name="previous">Previous buffer</param>
+		/// <param name="buffer">Input buffer</param>
+		/// <param name="len">Length of both buffers, longer than MAX_UPDATE_LENGTH is hashed in full</param>
+		/// <returns>Computed crc value</returns>
+		static UINT32 update(UINT32 previousCrc, const unsigned char* previous, const unsigned char* buffer, size_t len);
 	};
 }
\ No newline at end of file
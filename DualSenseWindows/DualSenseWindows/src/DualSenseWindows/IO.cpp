@@ -12,9 +12,21 @@
 #include <DualSenseWindows/IO.h>
 #include <DualSenseWindows/DS_CRC32.h>
 #include <DualSenseWindows/DS5_Input.h>
+#include <DualSenseWindows/DS5_Motion.h>
+#include <DualSenseWindows/DS5_Clock.h>
+#include <DualSenseWindows/DS5_Touch.h>
+#include <DualSenseWindows/DS5_Conditioning.h>
 #include <DualSenseWindows/DS5_HID.h>
 #include <DualSenseWindows/DS5_Internal.h>
 #include <DualSenseWindows/DS5_Output.h>
+#include <DualSenseWindows/DS5_OutputWriter.h>
+#include <DualSenseWindows/DS5_Haptics.h>
+#include <DualSenseWindows/DS5_OutputTimeline.h>
+#include <DualSenseWindows/DS5_InputPipeline.h>
+#include <DualSenseWindows/DS5_InputMode.h>
+#include <DualSenseWindows/DS5_InputReader.h>
+#include <DualSenseWindows/DS5_LatestInput.h>
+#include <DualSenseWindows/DS5_ReportQueue.h>
 
 #include <MurmurHash3/MurmurHash3.h>
 
@@ -340,6 +352,59 @@ DS5W_API DS5W_ReturnValue DS5W::initDeviceContext(DS5W::DeviceEnumInfo* ptrEnumI
 	ptrContext->_internal.uniqueID = ptrEnumInfo->_internal.uniqueID;
 	wcscpy_s(ptrContext->_internal.devicePath, 260, ptrEnumInfo->_internal.path);
 
+	// default input event sensitivity
+	ptrContext->_internal.inputEvents.stickThreshold = 2;
+	ptrContext->_internal.inputEvents.triggerThreshold = 2;
+	__DS5W::Input::resetInputEvents(ptrContext);
+
+	// motion fusion is opt-in
+	ptrContext->_internal.motionFusion.enabled = false;
+	ptrContext->_internal.motionFusion.batched = false;
+	ptrContext->_internal.motionFusion.beta = __DS5W::Motion::DEFAULT_BETA;
+	__DS5W::Motion::resetFusion(ptrContext);
+
+	// first output state is always sent
+	__DS5W::Output::forgetLastOutput(ptrContext);
+	ptrContext->_internal.btOutputCrcValid = false;
+
+	// output is written on the calling thread until a writer is started
+	__DS5W::OutputWriter::init(ptrContext);
+
+	// haptics stream is opt-in
+	__DS5W::Haptics::init(ptrContext);
+
+	// output changes are applied when set until a timeline is started
+	__DS5W::OutputTimeline::init(ptrContext);
+
+	// input is read one report at a time until a pipeline depth is set
+	__DS5W::InputPipeline::init(ptrContext);
+
+	// reads flush the HID queue until another input mode is set
+	__DS5W::InputMode::init(ptrContext);
+
+	// input is read on the calling thread until a reader is started
+	__DS5W::InputReader::init(ptrContext);
+	ptrContext->_internal.inputEngine.engine = NULL;
+	ptrContext->_internal.inputEngine.stopRequested = FALSE;
+	ptrContext->_internal.inputEngine.deviceRemoved = FALSE;
+	ptrContext->_internal.latestInput.sequence = 0;
+
+	// only the latest state is kept until the report queue is enabled
+	__DS5W::ReportQueue::init(ptrContext);
+
+	// sticks and triggers are raw until conditioning is configured
+	ptrContext->_internal.conditioning.enabled = false;
+
+	// touch tracking is opt-in
+	__DS5W::Touch::init(ptrContext);
+
+	// clock mapping is built from the first report on
+	__DS5W::Clock::reset(ptrContext);
+
+	// count lost reports from the first report on
+	__DS5W::Input::resetReportStatistics(ptrContext);
+	__DS5W::Input::restartReportSequence(ptrContext);
+
 	// create overlapped structs for IO
 	memset(&(ptrContext->_internal.olRead), 0, sizeof(OVERLAPPED));
 	memset(&(ptrContext->_internal.olWrite), 0, sizeof(OVERLAPPED));
@@ -377,6 +442,19 @@ DS5W_API void DS5W::freeDeviceContext(DS5W::DeviceContext* ptrContext) {
 		shutdownDevice(ptrContext);
 	}
 
+	// Threads may have stopped themselves when the device was removed
+	// Timeline first, it hands reports to the writer
+	__DS5W::InputReader::stop(ptrContext);
+	__DS5W::OutputTimeline::stop(ptrContext);
+	__DS5W::OutputWriter::stop(ptrContext);
+	__DS5W::Haptics::stop(ptrContext);
+
+	// Reads were cancelled when the device was disconnected
+	__DS5W::InputPipeline::release(ptrContext);
+
+	// Reader is stopped, nothing waits on the queue
+	__DS5W::ReportQueue::release(ptrContext);
+
 	// Free Windows events for I/O
 	CloseHandle(ptrContext->_internal.olRead.hEvent);
 	CloseHandle(ptrContext->_internal.olWrite.hEvent);
@@ -396,6 +474,12 @@ DS5W_API void DS5W::shutdownDevice(DS5W::DeviceContext* ptrContext)
 	if (ptrContext->_internal.connected == false)
 		return;
 
+	// Write the last submitted state before turning everything off
+	__DS5W::InputReader::stop(ptrContext);
+	__DS5W::OutputTimeline::stop(ptrContext);
+	__DS5W::OutputWriter::stop(ptrContext);
+	__DS5W::Haptics::stop(ptrContext);
+
 	// Prevent further API IO calls by marking disconnected
 	// internal IO calls are still allowed
 	ptrContext->_internal.connected = false;
@@ -423,7 +507,7 @@ DS5W_API DS5W_ReturnValue DS5W::reconnectDevice(DS5W::DeviceContext* ptrContext)
 	}
 
 	// Connect to device
-	HANDLE deviceHandle = CreateFileW(ptrContext->_internal.devicePath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, NULL, NULL);
+	HANDLE deviceHandle = CreateFileW(ptrContext->_internal.devicePath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, NULL);
 	if (!deviceHandle || (deviceHandle == INVALID_HANDLE_VALUE)) {
 		return DS5W_E_DEVICE_REMOVED;
 	}
@@ -432,8 +516,35 @@ DS5W_API DS5W_ReturnValue DS5W::reconnectDevice(DS5W::DeviceContext* ptrContext)
 	ptrContext->_internal.connected = true;
 	ptrContext->_internal.deviceHandle = deviceHandle;
 
+	// input events, orientation and touch tracking restart from the first new report
+	__DS5W::Input::resetInputEvents(ptrContext);
+	__DS5W::Motion::resetFusion(ptrContext);
+	__DS5W::Touch::reset(ptrContext);
+
+	// device clock may have restarted, keep the drift estimate but take a new offset
+	__DS5W::Clock::reanchor(ptrContext);
+
+	// reports missed while disconnected are not lost reports
+	__DS5W::Input::restartReportSequence(ptrContext);
+
+	// device may have lost its output state
+	__DS5W::Output::forgetLastOutput(ptrContext);
+
+	// new handle has the system queue length
+	_DS5W_ReturnValue err = DS5W_OK;
+	if (!__DS5W::InputMode::flushesQueue(ptrContext)) {
+		err = __DS5W::InputMode::apply(ptrContext);
+	}
+
+	// post the reads of the pipeline on the new handle
+	if (DS5W_SUCCESS(err) && ptrContext->_internal.inputPipeline.depth) {
+		err = __DS5W::InputPipeline::restart(ptrContext);
+	}
+
 	// refresh previous timestamp
-	_DS5W_ReturnValue err = getInitialTimestamp(ptrContext);
+	if (DS5W_SUCCESS(err)) {
+		err = getInitialTimestamp(ptrContext);
+	}
 	if (!DS5W_SUCCESS(err))
 	{
 		// Close handle and set error state
@@ -446,6 +557,10 @@ DS5W_API DS5W_ReturnValue DS5W::reconnectDevice(DS5W::DeviceContext* ptrContext)
 }
 
 DS5W_API DS5W_ReturnValue DS5W::getDeviceInputState(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState) {
+	return getDeviceInputStateMasked(ptrContext, ptrInputState, DS5W_ISTATE_FIELD_ALL);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getDeviceInputStateMasked(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int fieldMask) {
 	// Check pointer
 	if (!ptrContext || !ptrInputState) {
 		return DS5W_E_INVALID_ARGS;
@@ -456,6 +571,11 @@ DS5W_API DS5W_ReturnValue DS5W::getDeviceInputState(DS5W::DeviceContext* ptrCont
 		return DS5W_E_DEVICE_REMOVED;
 	}
 
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
 	DS5W_ReturnValue err;
 
 	// Get device input
@@ -477,21 +597,19 @@ DS5W_API DS5W_ReturnValue DS5W::getDeviceInputState(DS5W::DeviceContext* ptrCont
 	}
 
 	// Evaluete input buffer
-	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
-		// Call bluetooth evaluator if connection is qual to BT
-		__DS5W::Input::evaluateHidInputBuffer(&ptrContext->_internal.hidInBuffer[2], ptrInputState, ptrContext);
-	} else {
-		// Else it is USB so call its evaluator
-		__DS5W::Input::evaluateHidInputBuffer(&ptrContext->_internal.hidInBuffer[1], ptrInputState, ptrContext);
-	}
+	__DS5W::Input::decodeReport(ptrContext, __DS5W::Input::heldReportBody(ptrContext), ptrInputState, fieldMask);
 	
 	// Return ok
 	return DS5W_OK;
 }
 
 DS5W_API DS5W_ReturnValue DS5W::setDeviceOutputState(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState) {
+	return setDeviceOutputStateMasked(ptrContext, ptrOutputState, DS5W_OSTATE_SUBSYSTEM_ALL);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setDeviceOutputStateMasked(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems) {
 	// Check pointer
-	if (!ptrContext || !ptrOutputState) {
+	if (!ptrContext || !ptrOutputState || (subsystems & ~DS5W_OSTATE_SUBSYSTEM_ALL)) {
 		return DS5W_E_INVALID_ARGS;
 	}
 
@@ -499,25 +617,95 @@ DS5W_API DS5W_ReturnValue DS5W::setDeviceOutputState(DS5W::DeviceContext* ptrCon
 	if (ptrContext->_internal.connected == false) {
 		return DS5W_E_DEVICE_REMOVED;
 	}
+
+	// Nothing changed
+	if (subsystems == 0) {
+		return DS5W_OK;
+	}
+
+	// Writer thread owns output while running
+	if (__DS5W::OutputWriter::submit(ptrContext, ptrOutputState, subsystems)) {
+		return DS5W_OK;
+	}
+
+	// Timeline thread writes without a writer, the change is applied with its next report
+	DS5W_RV scheduled = __DS5W::OutputTimeline::schedule(ptrContext, 0, ptrOutputState, subsystems);
+	if (scheduled != DS5W_E_CURRENTLY_NOT_SUPPORTED) {
+		return scheduled;
+	}
 	
 	// Fill internal buffer with correct HID report for connection type
-	int outputReportLength = __DS5W::Output::createHIDOutputReport(ptrContext, ptrOutputState);
+	int outputReportLength = __DS5W::Output::createHIDOutputReport(ptrContext, ptrOutputState, subsystems);
 
 	// Send report to controller
 	DS5W_RV err = setOutputReport(ptrContext, outputReportLength, IO_TIMEOUT_MILLISECONDS);
 
 	// error check
 	if (DS5W_FAILED(err)) {
+		// Unknown what the device has now
+		__DS5W::Output::forgetLastOutput(ptrContext);
+
 		if (err == DS5W_E_DEVICE_REMOVED) {
 			disconnectDevice(ptrContext);
 		}
 		return err;
 	}
 
+	// Subsystems not sent may differ from the state, the last report no longer says what the device has
+	if (subsystems == DS5W_OSTATE_SUBSYSTEM_ALL) {
+		__DS5W::Output::rememberLastOutput(ptrContext);
+	}
+	else {
+		__DS5W::Output::forgetLastOutput(ptrContext);
+	}
+
 	// OK 
 	return DS5W_OK;
 }
 
+DS5W_API DS5W_ReturnValue DS5W::updateDeviceOutputState(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState, bool* ptrWritten) {
+	// Check pointer
+	if (!ptrContext || !ptrOutputState) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	if (ptrWritten) {
+		*ptrWritten = false;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	// Writer thread owns output while running, it skips unchanged states itself
+	if (__DS5W::OutputWriter::submit(ptrContext, ptrOutputState, DS5W_OSTATE_SUBSYSTEM_ALL)) {
+		return DS5W_OK;
+	}
+
+	// Timeline thread writes without a writer, the device already has the state if nothing is pending
+	if (__DS5W::OutputTimeline::matchesLastOutput(ptrContext, ptrOutputState)) {
+		return DS5W_OK;
+	}
+
+	DS5W_RV scheduled = __DS5W::OutputTimeline::schedule(ptrContext, 0, ptrOutputState, DS5W_OSTATE_SUBSYSTEM_ALL);
+	if (scheduled != DS5W_E_CURRENTLY_NOT_SUPPORTED) {
+		return scheduled;
+	}
+
+	// Device already has this state
+	if (__DS5W::Output::matchesLastOutput(ptrContext, ptrOutputState)) {
+		return DS5W_OK;
+	}
+
+	DS5W_RV err = setDeviceOutputState(ptrContext, ptrOutputState);
+	if (DS5W_SUCCESS(err) && ptrWritten) {
+		*ptrWritten = true;
+	}
+
+	return err;
+}
+
 DS5W_API DS5W_ReturnValue DS5W::startInputRequest(DS5W::DeviceContext* ptrContext)
 {
 	// Check pointer
@@ -530,10 +718,19 @@ DS5W_API DS5W_ReturnValue DS5W::startInputRequest(DS5W::DeviceContext* ptrContex
 		return DS5W_E_DEVICE_REMOVED;
 	}
 
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
 	DS5W_ReturnValue err;
 
-	// Start request for device input
-	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
+	// Start request for device input, or check the oldest posted read
+	ptrContext->_internal.inputPipeline.taken = false;
+	if (ptrContext->_internal.inputPipeline.depth) {
+		err = __DS5W::InputPipeline::poll(ptrContext);
+	}
+	else if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
 		ptrContext->_internal.hidInBuffer[0] = DS_INPUT_REPORT_BT;
 		err = startInputRequest(ptrContext, DS_INPUT_REPORT_BT_SIZE);
 	}
@@ -550,6 +747,15 @@ DS5W_API DS5W_ReturnValue DS5W::startInputRequest(DS5W::DeviceContext* ptrContex
 		return err;
 	}
 
+	// Read finished without waiting
+	if (err == DS5W_OK) {
+		inputReportReceived(ptrContext);
+
+		// Report is in the input buffer already, like a read completing right away
+		if (ptrContext->_internal.inputPipeline.depth)
+			ptrContext->_internal.inputPipeline.taken = true;
+	}
+
 	// Return ok
 	return DS5W_OK;
 }
@@ -566,8 +772,25 @@ DS5W_API DS5W_ReturnValue DS5W::awaitInputRequest(DS5W::DeviceContext* ptrContex
 		return DS5W_E_DEVICE_REMOVED;
 	}
 
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Report startInputRequest() took is the one awaited
+	if (ptrContext->_internal.inputPipeline.taken) {
+		ptrContext->_internal.inputPipeline.taken = false;
+		return DS5W_OK;
+	}
+
 	// block thread here until request is fulfilled or timeout
-	DS5W_ReturnValue err = awaitIORequest(ptrContext, &ptrContext->_internal.olRead, IO_TIMEOUT_MILLISECONDS);
+	DS5W_ReturnValue err;
+	if (ptrContext->_internal.inputPipeline.depth) {
+		err = __DS5W::InputPipeline::take(ptrContext, IO_TIMEOUT_MILLISECONDS);
+	}
+	else {
+		err = awaitIORequest(ptrContext, &ptrContext->_internal.olRead, IO_TIMEOUT_MILLISECONDS);
+	}
 
 	// error check
 	if (!DS5W_SUCCESS(err)) {
@@ -577,24 +800,862 @@ DS5W_API DS5W_ReturnValue DS5W::awaitInputRequest(DS5W::DeviceContext* ptrContex
 		return err;
 	}
 
+	// Record arrival time of the report
+	inputReportReceived(ptrContext);
+
 	// Return ok
 	return DS5W_OK;
 }
 
 DS5W_API void DS5W::getHeldInputState(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState)
+{
+	getHeldInputStateMasked(ptrContext, ptrInputState, DS5W_ISTATE_FIELD_ALL);
+}
+
+DS5W_API void DS5W::getHeldInputStateMasked(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int fieldMask)
+{
+	// Check pointer
+	if (!ptrContext || !ptrInputState) {
+		return;
+	}
+
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return;
+	}
+
+	// Evaluete input buffer
+	__DS5W::Input::decodeReport(ptrContext, __DS5W::Input::heldReportBody(ptrContext), ptrInputState, fieldMask);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getDeviceInputStateF(DS5W::DeviceContext* ptrContext, DS5W::DS5InputStateF* ptrInputState)
+{
+	// Check pointer
+	if (!ptrContext || !ptrInputState) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	DS5W_ReturnValue err;
+
+	// Get device input
+	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
+		ptrContext->_internal.hidInBuffer[0] = DS_INPUT_REPORT_BT;
+		err = getInputReport(ptrContext, DS_INPUT_REPORT_BT_SIZE, IO_TIMEOUT_MILLISECONDS);
+	}
+	else {
+		ptrContext->_internal.hidInBuffer[0] = DS_INPUT_REPORT_USB;
+		err = getInputReport(ptrContext, DS_INPUT_REPORT_USB_SIZE, IO_TIMEOUT_MILLISECONDS);
+	}
+
+	// error check
+	if (DS5W_FAILED(err)) {
+		if (err == DS5W_E_DEVICE_REMOVED) {
+			disconnectDevice(ptrContext);
+		}
+		return err;
+	}
+
+	getHeldInputStateF(ptrContext, ptrInputState);
+
+	// Return ok
+	return DS5W_OK;
+}
+
+DS5W_API void DS5W::getHeldInputStateF(DS5W::DeviceContext* ptrContext, DS5W::DS5InputStateF* ptrInputState)
 {
 	// Check pointer
 	if (!ptrContext || !ptrInputState) {
 		return;
 	}
 
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return;
+	}
+
 	// Evaluete input buffer
+	__DS5W::Input::decodeReport(ptrContext, __DS5W::Input::heldReportBody(ptrContext), ptrInputState);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::decodeInputReportBatch(DS5W::DeviceContext* ptrContext, const unsigned char* reportBodies, unsigned int reportStride, unsigned int reportCount, DS5W::DS5InputBatch* ptrBatch)
+{
+	// Check pointers
+	if (!ptrContext || !reportBodies || !ptrBatch) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check every column is present
+	if (!ptrBatch->leftStickX || !ptrBatch->leftStickY || !ptrBatch->rightStickX || !ptrBatch->rightStickY ||
+		!ptrBatch->leftTrigger || !ptrBatch->rightTrigger || !ptrBatch->buttonMap ||
+		!ptrBatch->gyroscopeX || !ptrBatch->gyroscopeY || !ptrBatch->gyroscopeZ ||
+		!ptrBatch->accelerometerX || !ptrBatch->accelerometerY || !ptrBatch->accelerometerZ ||
+		!ptrBatch->touchPoint1 || !ptrBatch->touchPoint2 || !ptrBatch->currentTime || !ptrBatch->deltaTime) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reports must not overlap, USB bodies are the smallest
+	if (reportStride < DS_INPUT_REPORT_USB_SIZE - 1) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Input::evaluateHidInputBatch(reportBodies, reportStride, reportCount, ptrBatch, ptrContext);
+
+	// Return ok
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getDeviceInputEvents(DS5W::DeviceContext* ptrContext, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents, unsigned int* eventCount)
+{
+	// Check pointer
+	if (!ptrContext || !eventCount || (maxEvents && !ptrEvents)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	DS5W_ReturnValue err;
+
+	// Get device input
 	if (ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT) {
-		// bluetooth HID report is offset by 2
-		__DS5W::Input::evaluateHidInputBuffer(&ptrContext->_internal.hidInBuffer[2], ptrInputState, ptrContext);
+		ptrContext->_internal.hidInBuffer[0] = DS_INPUT_REPORT_BT;
+		err = getInputReport(ptrContext, DS_INPUT_REPORT_BT_SIZE, IO_TIMEOUT_MILLISECONDS);
 	}
 	else {
-		// usb HID report is offset by 1
-		__DS5W::Input::evaluateHidInputBuffer(&ptrContext->_internal.hidInBuffer[1], ptrInputState, ptrContext);
+		ptrContext->_internal.hidInBuffer[0] = DS_INPUT_REPORT_USB;
+		err = getInputReport(ptrContext, DS_INPUT_REPORT_USB_SIZE, IO_TIMEOUT_MILLISECONDS);
+	}
+
+	// error check
+	if (DS5W_FAILED(err)) {
+		if (err == DS5W_E_DEVICE_REMOVED) {
+			disconnectDevice(ptrContext);
+		}
+		return err;
+	}
+
+	return getHeldInputEvents(ptrContext, ptrEvents, maxEvents, eventCount);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getHeldInputEvents(DS5W::DeviceContext* ptrContext, DS5W::DS5InputEvent* ptrEvents, unsigned int maxEvents, unsigned int* eventCount)
+{
+	// Check pointer
+	if (!ptrContext || !eventCount || (maxEvents && !ptrEvents)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Compare input buffer against the last one
+	const unsigned int count = __DS5W::Input::decodeReportEvents(ptrContext, __DS5W::Input::heldReportBody(ptrContext), ptrEvents, maxEvents);
+
+	*eventCount = count;
+
+	// Check if array was sufficient
+	if (count > maxEvents) {
+		return DS5W_E_INSUFFICIENT_BUFFER;
+	}
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setInputEventThresholds(DS5W::DeviceContext* ptrContext, unsigned char stickThreshold, unsigned char triggerThreshold)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine decodes with this configuration
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	ptrContext->_internal.inputEvents.stickThreshold = stickThreshold;
+	ptrContext->_internal.inputEvents.triggerThreshold = triggerThreshold;
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setMotionFusion(DS5W::DeviceContext* ptrContext, bool enabled, float beta, bool batched)
+{
+	// Check pointer and gain (also rejects NaN)
+	if (!ptrContext || !(beta >= 0.0f)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine decodes with this configuration
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Start from the next accelerometer sample when turned on
+	if (enabled && !ptrContext->_internal.motionFusion.enabled) {
+		__DS5W::Motion::resetFusion(ptrContext);
+	}
+
+	ptrContext->_internal.motionFusion.enabled = enabled;
+	ptrContext->_internal.motionFusion.beta = beta;
+	ptrContext->_internal.motionFusion.batched = batched;
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::resetMotionFusion(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
 	}
-}
\ No newline at end of file
+
+	// Reader thread or input engine decodes with this configuration
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	__DS5W::Motion::resetFusion(ptrContext);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getMotionState(DS5W::DeviceContext* ptrContext, DS5W::DS5MotionState* ptrMotionState)
+{
+	// Check pointer
+	if (!ptrContext || !ptrMotionState) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Orientation is only tracked while fusion is on
+	if (!ptrContext->_internal.motionFusion.enabled) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Reader thread or input engine updates the orientation, take the copy published with the latest state
+	if (inputReadsOwned(ptrContext)) {
+		__DS5W::LatestInput::readMotion(ptrContext, ptrMotionState);
+	}
+	else {
+		__DS5W::Motion::getMotionState(ptrContext, ptrMotionState);
+	}
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::updateMotionFusionBatch(DS5W::DeviceContext** ptrContexts, unsigned int contextCount)
+{
+	// Check pointer
+	if (!ptrContexts && contextCount) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader threads and input engines decode into the held reports
+	for (unsigned int i = 0; i < contextCount; i++) {
+		if (ptrContexts[i] && inputReadsOwned(ptrContexts[i])) {
+			return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+		}
+	}
+
+	__DS5W::Motion::updateFusionBatch(ptrContexts, contextCount);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getClockSyncInfo(DS5W::DeviceContext* ptrContext, DS5W::DS5ClockSyncInfo* ptrInfo)
+{
+	// Check pointer
+	if (!ptrContext || !ptrInfo) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Clock::getInfo(ptrContext, ptrInfo);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::deviceToHostTime(DS5W::DeviceContext* ptrContext, unsigned int deviceTimestamp, long long* ptrHostTime)
+{
+	// Check pointer
+	if (!ptrContext || !ptrHostTime) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Nothing to map against before the first report
+	if (!ptrContext->_internal.clockSync.valid) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	*ptrHostTime = __DS5W::Clock::deviceToHost(ptrContext, deviceTimestamp);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getReportStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5ReportStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrContext || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Input::getReportStatistics(ptrContext, ptrStatistics);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::resetReportStatistics(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Input::resetReportStatistics(ptrContext);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setTouchTracking(DS5W::DeviceContext* ptrContext, bool enabled)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine decodes with this configuration
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Start without contacts when turned on
+	if (enabled && !ptrContext->_internal.touchTracker.enabled) {
+		__DS5W::Touch::reset(ptrContext);
+	}
+
+	ptrContext->_internal.touchTracker.enabled = enabled;
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getTouchState(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchState* ptrTouchState)
+{
+	// Check pointer
+	if (!ptrContext || !ptrTouchState) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Contacts are only tracked while tracking is on
+	if (!ptrContext->_internal.touchTracker.enabled) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Reader thread or input engine updates the contacts, take the copy published with the latest state
+	if (inputReadsOwned(ptrContext)) {
+		__DS5W::LatestInput::readTouch(ptrContext, ptrTouchState);
+	}
+	else {
+		__DS5W::Touch::getTouchState(ptrContext, ptrTouchState);
+	}
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getTouchGestures(DS5W::DeviceContext* ptrContext, DS5W::DS5TouchGesture* ptrGestures, unsigned int maxGestures, unsigned int* ptrGestureCount)
+{
+	// Check pointer
+	if (!ptrContext || !ptrGestureCount || (!ptrGestures && maxGestures)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Gestures are only recognized while tracking is on
+	if (!ptrContext->_internal.touchTracker.enabled) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	*ptrGestureCount = __DS5W::Touch::popGestures(ptrContext, ptrGestures, maxGestures);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setAnalogConditioning(DS5W::DeviceContext* ptrContext, const DS5W::DS5AnalogConditioning* ptrConditioning)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine decodes with this configuration
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// No configuration returns to raw values
+	if (!ptrConditioning) {
+		ptrContext->_internal.conditioning.enabled = false;
+		return DS5W_OK;
+	}
+
+	// Check configuration
+	if (!__DS5W::Conditioning::isValid(ptrConditioning)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Conditioning::compile(ptrConditioning, &ptrContext->_internal.conditioning);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::startOutputWriter(DS5W::DeviceContext* ptrContext, unsigned int rate)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	return __DS5W::OutputWriter::start(ptrContext, rate);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::submitOutputState(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputState* ptrOutputState)
+{
+	// Check pointer
+	if (!ptrContext || !ptrOutputState) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	if (__DS5W::OutputWriter::submit(ptrContext, ptrOutputState, DS5W_OSTATE_SUBSYSTEM_ALL)) {
+		return DS5W_OK;
+	}
+
+	// Writer exits on its own only when the device is gone
+	if (__DS5W::OutputWriter::deviceRemoved(ptrContext)) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::stopOutputWriter(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::OutputWriter::stop(ptrContext);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getOutputWriterStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputWriterStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrContext || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::OutputWriter::getStatistics(ptrContext, ptrStatistics);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::startHapticsStream(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	return __DS5W::Haptics::start(ptrContext);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::writeHapticsFrames(DS5W::DeviceContext* ptrContext, const short* ptrFrames, unsigned int frameCount, unsigned int sampleRate)
+{
+	// Check pointer
+	if (!ptrContext || (!ptrFrames && frameCount) || sampleRate == 0 || sampleRate > __DS5W::Haptics::MAX_INPUT_RATE) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	if (__DS5W::Haptics::write(ptrContext, ptrFrames, frameCount, sampleRate)) {
+		return DS5W_OK;
+	}
+
+	// Stream exits on its own only when the device is gone
+	if (__DS5W::Haptics::deviceRemoved(ptrContext)) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::stopHapticsStream(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Haptics::stop(ptrContext);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getHapticsStreamStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5HapticsStreamStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrContext || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Haptics::getStatistics(ptrContext, ptrStatistics);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::encodeHapticsReport(unsigned char sequence, const signed char* ptrSamples, unsigned char* ptrReport)
+{
+	// Check pointer
+	if (!ptrSamples || !ptrReport) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::Haptics::encodeReport(ptrReport, sequence, ptrSamples);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::startOutputTimeline(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	return __DS5W::OutputTimeline::start(ptrContext);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::scheduleOutputState(DS5W::DeviceContext* ptrContext, long long hostTime, DS5W::DS5OutputState* ptrOutputState, unsigned int subsystems)
+{
+	// Check pointer
+	if (!ptrContext || !ptrOutputState || (subsystems & ~DS5W_OSTATE_SUBSYSTEM_ALL)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Nothing changes
+	if (subsystems == 0) {
+		return DS5W_OK;
+	}
+
+	DS5W_RV err = __DS5W::OutputTimeline::schedule(ptrContext, hostTime, ptrOutputState, subsystems);
+
+	// Timeline exits on its own only when the device is gone
+	if (err == DS5W_E_CURRENTLY_NOT_SUPPORTED && __DS5W::OutputTimeline::deviceRemoved(ptrContext)) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	return err;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::clearOutputTimeline(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::OutputTimeline::clear(ptrContext);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::stopOutputTimeline(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::OutputTimeline::stop(ptrContext);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getOutputTimelineStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5OutputTimelineStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrContext || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::OutputTimeline::getStatistics(ptrContext, ptrStatistics);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setInputPipelineDepth(DS5W::DeviceContext* ptrContext, unsigned int depth)
+{
+	// Check pointer
+	if (!ptrContext || depth > DS5W_INPUT_PIPELINE_MAX_DEPTH) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	DS5W_ReturnValue err = __DS5W::InputPipeline::setDepth(ptrContext, depth);
+
+	// error check
+	if (err == DS5W_E_DEVICE_REMOVED) {
+		disconnectDevice(ptrContext);
+	}
+
+	return err;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getInputPipelineStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputPipelineStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrContext || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::InputPipeline::getStatistics(ptrContext, ptrStatistics);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setInputMode(DS5W::DeviceContext* ptrContext, DS5W::InputMode mode, unsigned int queueLength)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Posted pipeline reads take the reports in order, the mode would not apply to them
+	if (ptrContext->_internal.inputPipeline.depth) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	DS5W_ReturnValue err = __DS5W::InputMode::set(ptrContext, mode, queueLength);
+
+	// error check
+	if (err == DS5W_E_DEVICE_REMOVED) {
+		disconnectDevice(ptrContext);
+	}
+
+	return err;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::drainInputReports(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputStates, unsigned int maxStates, unsigned int* ptrStateCount)
+{
+	// Check pointer
+	if (!ptrContext || !ptrInputStates || !ptrStateCount || maxStates == 0) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	*ptrStateCount = 0;
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	// Reader thread or input engine owns input reads
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	const bool bt = ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT;
+	const USHORT reportLen = bt ? DS_INPUT_REPORT_BT_SIZE : DS_INPUT_REPORT_USB_SIZE;
+
+	// bluetooth HID report is offset by 2, usb by 1
+	unsigned char* report = &ptrContext->_internal.hidInBuffer[bt ? 2 : 1];
+
+	unsigned int count = 0;
+	DS5W_ReturnValue err = DS5W_OK;
+	while (count < maxStates) {
+		ptrContext->_internal.hidInBuffer[0] = bt ? DS_INPUT_REPORT_BT : DS_INPUT_REPORT_USB;
+
+		// Wait for the first report only, the rest must already be queued
+		if (count == 0) {
+			err = getInputReport(ptrContext, reportLen, IO_TIMEOUT_MILLISECONDS);
+		}
+		else if (__DS5W::InputMode::flushesQueue(ptrContext) && !ptrContext->_internal.inputPipeline.depth) {
+			// Reading again would flush the queue first, nothing is kept to drain
+			break;
+		}
+		else {
+			err = pollInputReport(ptrContext, reportLen);
+		}
+
+		if (DS5W_FAILED(err)) {
+			break;
+		}
+
+		// Every report moves orientation and touch tracking forward
+		__DS5W::Input::decodeReport(ptrContext, report, &ptrInputStates[count]);
+		count++;
+	}
+
+	*ptrStateCount = count;
+	__DS5W::InputMode::onDrain(ptrContext, count);
+
+	// Queue is empty or the array is full
+	if (count > 0 && (err == DS5W_OK || err == DS5W_E_IO_PENDING)) {
+		return DS5W_OK;
+	}
+
+	// error check
+	if (err == DS5W_E_DEVICE_REMOVED) {
+		disconnectDevice(ptrContext);
+	}
+
+	return err;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getInputModeStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5InputModeStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrContext || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::InputMode::getStatistics(ptrContext, ptrStatistics);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::startInputReader(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	// Input engine reads the device
+	if (ptrContext->_internal.inputEngine.engine) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	return __DS5W::InputReader::start(ptrContext);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getLatestInputState(DS5W::DeviceContext* ptrContext, DS5W::DS5InputState* ptrInputState, unsigned int* ptrVersion)
+{
+	// Check pointer
+	if (!ptrContext || !ptrInputState) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader exits and the engine drops the device on their own only when the device is gone
+	if (ptrContext->_internal.connected == false || __DS5W::InputReader::deviceRemoved(ptrContext) || ptrContext->_internal.inputEngine.deviceRemoved) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	if (inputReadsOwned(ptrContext)) {
+		return __DS5W::LatestInput::read(ptrContext, ptrInputState, ptrVersion) ? DS5W_OK : DS5W_E_IO_PENDING;
+	}
+
+	return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::stopInputReader(DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::InputReader::stop(ptrContext);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::setReportQueue(DS5W::DeviceContext* ptrContext, bool enabled, DS5W::ReportQueuePolicy policy)
+{
+	// Check pointer
+	if (!ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reader thread or input engine is the producer, it cannot run while the queue changes
+	if (inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	return __DS5W::ReportQueue::configure(ptrContext, enabled, policy);
+}
+
+DS5W_API DS5W_ReturnValue DS5W::popReports(DS5W::DeviceContext* ptrContext, DS5W::DS5QueuedReport* ptrReports, unsigned int maxReports, unsigned int* ptrReportCount)
+{
+	// Check pointer
+	if (!ptrContext || (!ptrReports && maxReports) || !ptrReportCount) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	*ptrReportCount = 0;
+
+	if (!ptrContext->_internal.reportQueue.enabled) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	*ptrReportCount = __DS5W::ReportQueue::pop(ptrContext, ptrReports, maxReports);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getReportQueueStatistics(DS5W::DeviceContext* ptrContext, DS5W::DS5ReportQueueStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrContext || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	__DS5W::ReportQueue::getStatistics(ptrContext, ptrStatistics);
+
+	return DS5W_OK;
+}
@@ -0,0 +1,532 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include <DualSenseWindows/InputEngine.h>
+#include <DualSenseWindows/DS5_Internal.h>
+#include <DualSenseWindows/DS5_Input.h>
+#include <DualSenseWindows/DS5_LatestInput.h>
+#include <DualSenseWindows/DS5_ReportQueue.h>
+
+#include <Windows.h>
+#include <string.h>
+
+namespace {
+	// Completion key telling a worker to exit, never a device slot
+	const ULONG_PTR STOP_KEY = (ULONG_PTR)-1;
+
+	void updateMax(volatile LONG64* max, LONG64 value)
+	{
+		LONG64 current = InterlockedExchangeAdd64(max, 0);
+		while (value > current) {
+			const LONG64 previous = InterlockedCompareExchange64(max, value, current);
+			if (previous == current)
+				break;
+			current = previous;
+		}
+	}
+
+	// Start one read of a device, device lock held
+	bool post(DS5W::InputEngineDevice& device, unsigned int read)
+	{
+		device.buffers[read][0] = device.context->_internal.connectionType == DS5W::DeviceConnection::BT ? DS_INPUT_REPORT_BT : DS_INPUT_REPORT_USB;
+
+		// Completion is queued on the port, the event is not waited on
+		memset(&device.overlapped[read], 0, sizeof(OVERLAPPED));
+		BOOL res = ReadFile(device.handle, device.buffers[read], device.reportLen, NULL, &device.overlapped[read]);
+		if (!res && GetLastError() != ERROR_IO_PENDING)
+			return false;
+
+		device.posted[read] = true;
+		return true;
+	}
+
+	// Decode the report copied to the context's input buffer, only called by the worker delivering the device
+	void dispatch(DS5W::DS5InputEngine* ptrEngine, DS5W::DeviceContext* ptrContext)
+	{
+		DS5W::inputReportReceived(ptrContext);
+
+		DS5W::DS5InputState state;
+		__DS5W::Input::decodeReport(ptrContext, __DS5W::Input::heldReportBody(ptrContext), &state);
+
+		__DS5W::LatestInput::publish(ptrContext, &state);
+		if (ptrContext->_internal.reportQueue.enabled)
+			__DS5W::ReportQueue::push(ptrContext, &state);
+
+		if (ptrEngine->_internal.callback)
+			ptrEngine->_internal.callback(ptrContext, &state, ptrEngine->_internal.userData);
+
+		InterlockedIncrement64(&ptrEngine->_internal.reports);
+	}
+
+	// Free the slot of a removed device once no read is outstanding, device lock held
+	// Only reached while the device is not being unregistered, the engine lock is not taken as unregistering waits on workers with it held
+	void drop(DS5W::DS5InputEngine* ptrEngine, DS5W::InputEngineDevice& device)
+	{
+		DS5W::DeviceContext* ptrContext = device.context;
+
+		CloseHandle(device.handle);
+		CloseHandle(device.idle);
+		device.handle = NULL;
+		device.idle = NULL;
+		device.context = NULL;
+
+		ptrContext->_internal.inputEngine.engine = NULL;
+		InterlockedDecrement(&ptrEngine->_internal.deviceCount);
+	}
+
+	// Handle the completed reads of a device in the order they were posted, device lock held on entry and return
+	// Different workers can take the completions of one device out of order, a completion may find its read already handled
+	// Reports are decoded and handed out without the lock, the delivering flag keeps other workers away meanwhile
+	void drain(DS5W::DS5InputEngine* ptrEngine, DS5W::InputEngineDevice& device, ULONG_PTR slot)
+	{
+		// Worker delivering the device looks for completed reads again before it lets go
+		if (device.delivering)
+			return;
+		device.delivering = true;
+
+		DS5W::DeviceContext* ptrContext = device.context;
+
+		// At most one round of reads, a device reporting faster than its callback returns must not keep the worker
+		unsigned int handled = 0;
+		while (device.posted[device.next] && HasOverlappedIoCompleted(&device.overlapped[device.next])) {
+			if (handled++ == DS5W_INPUT_ENGINE_READS) {
+				// Completions of the reads left were taken by workers that saw this one delivering, queue the device again
+				PostQueuedCompletionStatus(ptrEngine->_internal.port, 0, slot, &device.overlapped[device.next]);
+				break;
+			}
+
+			const unsigned int read = device.next;
+			device.next = (read + 1) % DS5W_INPUT_ENGINE_READS;
+			device.posted[read] = false;
+
+			bool decode = false;
+			DWORD bytes;
+			if (GetOverlappedResult(device.handle, &device.overlapped[read], &bytes, FALSE)) {
+				// Decoders read the context's input buffer, the read can be posted again right away
+				if (!device.closing && !device.removed) {
+					memcpy(ptrContext->_internal.hidInBuffer, device.buffers[read], device.reportLen);
+					decode = true;
+				}
+			}
+			else {
+				DWORD err = GetLastError();
+				if (err == ERROR_DEVICE_NOT_CONNECTED)
+					device.removed = true;
+				else if (err != ERROR_OPERATION_ABORTED)
+					InterlockedIncrement64(&ptrEngine->_internal.failed);
+			}
+
+			// HID reads only fail to start once the device is gone
+			if (device.closing || device.removed)
+				device.outstanding--;
+			else if (!post(device, read)) {
+				device.removed = true;
+				device.outstanding--;
+			}
+
+			if (decode) {
+				ReleaseSRWLockExclusive(&device.lock);
+				dispatch(ptrEngine, ptrContext);
+				AcquireSRWLockExclusive(&device.lock);
+			}
+		}
+
+		// Told once, reads of the device are not posted again
+		if (device.removed && !device.notified) {
+			device.notified = true;
+			InterlockedIncrement64(&ptrEngine->_internal.removed);
+			InterlockedExchange(&ptrContext->_internal.inputEngine.deviceRemoved, TRUE);
+
+			// Reads still posted complete right away, the last one lets the device be dropped
+			CancelIoEx(device.handle, NULL);
+
+			if (ptrEngine->_internal.callback && !device.closing) {
+				ReleaseSRWLockExclusive(&device.lock);
+				ptrEngine->_internal.callback(ptrContext, NULL, ptrEngine->_internal.userData);
+				AcquireSRWLockExclusive(&device.lock);
+			}
+		}
+
+		device.delivering = false;
+
+		// Unregistering waits for the last read and callback, a removed device is dropped by the worker handling its last read
+		if (device.outstanding == 0) {
+			if (device.closing)
+				SetEvent(device.idle);
+			else if (device.removed)
+				drop(ptrEngine, device);
+		}
+	}
+
+	DWORD WINAPI workerThread(LPVOID param)
+	{
+		DS5W::DS5InputEngine* ptrEngine = (DS5W::DS5InputEngine*)param;
+
+		for (;;) {
+			DWORD bytes;
+			ULONG_PTR key;
+			LPOVERLAPPED ol;
+			BOOL res = GetQueuedCompletionStatus(ptrEngine->_internal.port, &bytes, &key, &ol, INFINITE);
+
+			// No overlapped struct means no IO completed, either the stop packet or the port failed
+			if (!ol) {
+				if (key == STOP_KEY || !res)
+					break;
+				continue;
+			}
+
+			LARGE_INTEGER start, end;
+			QueryPerformanceCounter(&start);
+
+			DS5W::InputEngineDevice& device = ptrEngine->_internal.devices[key];
+
+			// Slot may have been freed since, completions of its last reads are then left over
+			AcquireSRWLockExclusive(&device.lock);
+			if (device.context)
+				drain(ptrEngine, device, key);
+			ReleaseSRWLockExclusive(&device.lock);
+
+			QueryPerformanceCounter(&end);
+
+			const LONG64 dispatchTime = end.QuadPart - start.QuadPart;
+			InterlockedIncrement64(&ptrEngine->_internal.completions);
+			InterlockedExchangeAdd64(&ptrEngine->_internal.dispatchTotal, dispatchTime);
+			updateMax(&ptrEngine->_internal.dispatchMax, dispatchTime);
+		}
+
+		return 0;
+	}
+
+	// Whether the calling thread is one of the engine's workers, so called from the engine callback
+	bool onWorker(DS5W::DS5InputEngine* ptrEngine)
+	{
+		const DWORD id = GetCurrentThreadId();
+		for (unsigned int i = 0; i < ptrEngine->_internal.workerCount; i++) {
+			if (ptrEngine->_internal.workerIds[i] == id)
+				return true;
+		}
+
+		return false;
+	}
+
+	// Cancel the reads of a device, wait until the workers handled all of them and free the slot, engine lock held
+	// Returns false if a worker dropped the removed device first
+	bool closeDevice(DS5W::InputEngineDevice& device, DS5W::DeviceContext* ptrContext)
+	{
+		AcquireSRWLockExclusive(&device.lock);
+		if (device.context != ptrContext) {
+			ReleaseSRWLockExclusive(&device.lock);
+			return false;
+		}
+
+		// A report queue blocking for room gives up
+		InterlockedExchange(&ptrContext->_internal.inputEngine.stopRequested, TRUE);
+
+		device.closing = true;
+		const bool idle = device.outstanding == 0 && !device.delivering;
+		ReleaseSRWLockExclusive(&device.lock);
+
+		// Cancelled reads still complete through the port, the last one drained signals the event
+		if (!idle) {
+			CancelIoEx(device.handle, NULL);
+			WaitForSingleObject(device.idle, INFINITE);
+		}
+
+		AcquireSRWLockExclusive(&device.lock);
+		CloseHandle(device.handle);
+		CloseHandle(device.idle);
+		device.handle = NULL;
+		device.idle = NULL;
+		device.context = NULL;
+		ReleaseSRWLockExclusive(&device.lock);
+
+		ptrContext->_internal.inputEngine.engine = NULL;
+		return true;
+	}
+
+	void stopWorkers(DS5W::DS5InputEngine* ptrEngine)
+	{
+		for (unsigned int i = 0; i < ptrEngine->_internal.workerCount; i++) {
+			PostQueuedCompletionStatus(ptrEngine->_internal.port, 0, STOP_KEY, NULL);
+		}
+
+		for (unsigned int i = 0; i < ptrEngine->_internal.workerCount; i++) {
+			WaitForSingleObject(ptrEngine->_internal.workers[i], INFINITE);
+			CloseHandle(ptrEngine->_internal.workers[i]);
+			ptrEngine->_internal.workers[i] = NULL;
+			ptrEngine->_internal.workerIds[i] = 0;
+		}
+
+		ptrEngine->_internal.workerCount = 0;
+	}
+}
+
+DS5W_API DS5W_ReturnValue DS5W::startInputEngine(DS5W::DS5InputEngine* ptrEngine, unsigned int workerCount, DS5W::DS5InputEngineCallback callback, void* userData)
+{
+	// Check pointer
+	if (!ptrEngine || workerCount > DS5W_INPUT_ENGINE_MAX_WORKERS) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Reads are short, more workers than processors only add switches
+	if (workerCount == 0) {
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		workerCount = info.dwNumberOfProcessors;
+		if (workerCount > DS5W_INPUT_ENGINE_MAX_WORKERS)
+			workerCount = DS5W_INPUT_ENGINE_MAX_WORKERS;
+		if (workerCount == 0)
+			workerCount = 1;
+	}
+
+	memset(&ptrEngine->_internal, 0, sizeof(ptrEngine->_internal));
+	InitializeSRWLock(&ptrEngine->_internal.lock);
+	for (unsigned int i = 0; i < DS5W_INPUT_ENGINE_MAX_DEVICES; i++) {
+		InitializeSRWLock(&ptrEngine->_internal.devices[i].lock);
+	}
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	ptrEngine->_internal.hostFrequency = frequency.QuadPart;
+	ptrEngine->_internal.callback = callback;
+	ptrEngine->_internal.userData = userData;
+
+	ptrEngine->_internal.port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, workerCount);
+	if (!ptrEngine->_internal.port) {
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	for (unsigned int i = 0; i < workerCount; i++) {
+		DWORD id;
+		HANDLE worker = CreateThread(NULL, 0, workerThread, ptrEngine, 0, &id);
+		if (!worker) {
+			stopWorkers(ptrEngine);
+			CloseHandle(ptrEngine->_internal.port);
+			ptrEngine->_internal.port = NULL;
+			return DS5W_E_EXTERNAL_WINAPI;
+		}
+
+		ptrEngine->_internal.workerIds[ptrEngine->_internal.workerCount] = id;
+		ptrEngine->_internal.workers[ptrEngine->_internal.workerCount++] = worker;
+	}
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::registerInputEngineDevice(DS5W::DS5InputEngine* ptrEngine, DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrEngine || !ptrContext) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Check for connection
+	if (ptrContext->_internal.connected == false) {
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	// Engine must run, and input must not be read elsewhere
+	if (!ptrEngine->_internal.port || inputReadsOwned(ptrContext)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Reads posted by the pipeline would take reports from the engine
+	if (ptrContext->_internal.inputPipeline.depth) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	AcquireSRWLockExclusive(&ptrEngine->_internal.lock);
+
+	unsigned int slot = 0;
+	while (slot < DS5W_INPUT_ENGINE_MAX_DEVICES && ptrEngine->_internal.devices[slot].context) {
+		slot++;
+	}
+	if (slot == DS5W_INPUT_ENGINE_MAX_DEVICES) {
+		ReleaseSRWLockExclusive(&ptrEngine->_internal.lock);
+		return DS5W_E_INSUFFICIENT_BUFFER;
+	}
+
+	// Own handle, the context's handle keeps completing on its events
+	HANDLE handle = CreateFileW(ptrContext->_internal.devicePath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, NULL);
+	if (!handle || handle == INVALID_HANDLE_VALUE) {
+		ReleaseSRWLockExclusive(&ptrEngine->_internal.lock);
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	// Manual reset, signalled once by the worker draining the last read on unregister
+	HANDLE idle = CreateEvent(NULL, TRUE, FALSE, NULL);
+	if (!idle || !CreateIoCompletionPort(handle, ptrEngine->_internal.port, (ULONG_PTR)slot, 0)) {
+		if (idle)
+			CloseHandle(idle);
+		CloseHandle(handle);
+		ReleaseSRWLockExclusive(&ptrEngine->_internal.lock);
+		return DS5W_E_EXTERNAL_WINAPI;
+	}
+
+	// Latest state starts with the engine's first report
+	ptrContext->_internal.inputEngine.engine = ptrEngine;
+	InterlockedExchange(&ptrContext->_internal.inputEngine.stopRequested, FALSE);
+	InterlockedExchange(&ptrContext->_internal.inputEngine.deviceRemoved, FALSE);
+	__DS5W::LatestInput::reset(ptrContext);
+
+	DS5W::InputEngineDevice& device = ptrEngine->_internal.devices[slot];
+
+	// Workers wait for the lock if a read completes while the others are posted
+	AcquireSRWLockExclusive(&device.lock);
+	device.context = ptrContext;
+	device.handle = handle;
+	device.idle = idle;
+	device.next = 0;
+	device.reportLen = ptrContext->_internal.connectionType == DS5W::DeviceConnection::BT ? DS_INPUT_REPORT_BT_SIZE : DS_INPUT_REPORT_USB_SIZE;
+	device.outstanding = 0;
+	device.closing = false;
+	device.removed = false;
+	device.notified = false;
+	device.delivering = false;
+
+	bool posted = true;
+	for (unsigned int i = 0; i < DS5W_INPUT_ENGINE_READS; i++) {
+		device.posted[i] = false;
+	}
+	for (unsigned int i = 0; i < DS5W_INPUT_ENGINE_READS && posted; i++) {
+		posted = post(device, i);
+		if (posted)
+			device.outstanding++;
+	}
+	ReleaseSRWLockExclusive(&device.lock);
+
+	if (!posted) {
+		closeDevice(device, ptrContext);
+		ReleaseSRWLockExclusive(&ptrEngine->_internal.lock);
+		return DS5W_E_DEVICE_REMOVED;
+	}
+
+	InterlockedIncrement(&ptrEngine->_internal.deviceCount);
+	ReleaseSRWLockExclusive(&ptrEngine->_internal.lock);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::unregisterInputEngineDevice(DS5W::DS5InputEngine* ptrEngine, DS5W::DeviceContext* ptrContext)
+{
+	// Check pointer
+	if (!ptrEngine || !ptrContext || ptrContext->_internal.inputEngine.engine != ptrEngine) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Worker would wait for its own callback to return
+	if (onWorker(ptrEngine)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	AcquireSRWLockExclusive(&ptrEngine->_internal.lock);
+
+	for (unsigned int slot = 0; slot < DS5W_INPUT_ENGINE_MAX_DEVICES; slot++) {
+		if (ptrEngine->_internal.devices[slot].context == ptrContext) {
+			if (closeDevice(ptrEngine->_internal.devices[slot], ptrContext))
+				InterlockedDecrement(&ptrEngine->_internal.deviceCount);
+			break;
+		}
+	}
+
+	ReleaseSRWLockExclusive(&ptrEngine->_internal.lock);
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::stopInputEngine(DS5W::DS5InputEngine* ptrEngine)
+{
+	// Check pointer
+	if (!ptrEngine) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	if (!ptrEngine->_internal.port) {
+		return DS5W_OK;
+	}
+
+	// Worker would wait for itself to exit
+	if (onWorker(ptrEngine)) {
+		return DS5W_E_CURRENTLY_NOT_SUPPORTED;
+	}
+
+	// Workers are still needed to handle the cancelled reads
+	AcquireSRWLockExclusive(&ptrEngine->_internal.lock);
+	for (unsigned int slot = 0; slot < DS5W_INPUT_ENGINE_MAX_DEVICES; slot++) {
+		DS5W::DeviceContext* ptrContext = ptrEngine->_internal.devices[slot].context;
+		if (ptrContext) {
+			closeDevice(ptrEngine->_internal.devices[slot], ptrContext);
+		}
+	}
+	InterlockedExchange(&ptrEngine->_internal.deviceCount, 0);
+	ReleaseSRWLockExclusive(&ptrEngine->_internal.lock);
+
+	stopWorkers(ptrEngine);
+
+	CloseHandle(ptrEngine->_internal.port);
+	ptrEngine->_internal.port = NULL;
+
+	return DS5W_OK;
+}
+
+DS5W_API DS5W_ReturnValue DS5W::getInputEngineStatistics(DS5W::DS5InputEngine* ptrEngine, DS5W::DS5InputEngineStatistics* ptrStatistics)
+{
+	// Check pointer
+	if (!ptrEngine || !ptrStatistics) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	const double microsecondsPerTick = ptrEngine->_internal.hostFrequency ? 1000000.0 / (double)ptrEngine->_internal.hostFrequency : 0.0;
+	const LONG64 completions = InterlockedExchangeAdd64(&ptrEngine->_internal.completions, 0);
+	const LONG64 dispatchTotal = InterlockedExchangeAdd64(&ptrEngine->_internal.dispatchTotal, 0);
+
+	ptrStatistics->reports = (unsigned long long)InterlockedExchangeAdd64(&ptrEngine->_internal.reports, 0);
+	ptrStatistics->failed = (unsigned long long)InterlockedExchangeAdd64(&ptrEngine->_internal.failed, 0);
+	ptrStatistics->removed = (unsigned long long)InterlockedExchangeAdd64(&ptrEngine->_internal.removed, 0);
+	ptrStatistics->completions = (unsigned long long)completions;
+	ptrStatistics->averageDispatchMicroseconds = completions ? (double)dispatchTotal / (double)completions * microsecondsPerTick : 0.0;
+	ptrStatistics->maxDispatchMicroseconds = (double)InterlockedExchangeAdd64(&ptrEngine->_internal.dispatchMax, 0) * microsecondsPerTick;
+
+	ptrStatistics->devices = (unsigned int)InterlockedExchangeAdd(&ptrEngine->_internal.deviceCount, 0);
+	ptrStatistics->workers = ptrEngine->_internal.workerCount;
+
+	return DS5W_OK;
+}
+
+void DS5W::detachInputEngine(DS5W::DeviceContext* ptrContext)
+{
+	DS5W::DS5InputEngine* ptrEngine = (DS5W::DS5InputEngine*)ptrContext->_internal.inputEngine.engine;
+	if (!ptrEngine) {
+		return;
+	}
+
+	if (!onWorker(ptrEngine)) {
+		unregisterInputEngineDevice(ptrEngine, ptrContext);
+		return;
+	}
+
+	// Unregistering from a worker would wait for the callback itself, the device is handled like a removed one instead
+	// No engine lock, a thread unregistering holds it while waiting on the workers
+	for (unsigned int slot = 0; slot < DS5W_INPUT_ENGINE_MAX_DEVICES; slot++) {
+		DS5W::InputEngineDevice& device = ptrEngine->_internal.devices[slot];
+		if (device.context != ptrContext)
+			continue;
+
+		AcquireSRWLockExclusive(&device.lock);
+		if (device.context == ptrContext && !device.closing && !device.removed) {
+			device.removed = true;
+
+			// A report queue blocking for room gives up
+			InterlockedExchange(&ptrContext->_internal.inputEngine.stopRequested, TRUE);
+
+			// Cancelled reads complete to the port, the worker handling them tells the callback and drops the device
+			CancelIoEx(device.handle, NULL);
+		}
+		ReleaseSRWLockExclusive(&device.lock);
+		break;
+	}
+}
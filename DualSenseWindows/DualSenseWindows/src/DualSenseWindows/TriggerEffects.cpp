@@ -0,0 +1,104 @@
+/*
+	DualSenseWindows API
+	https://github.com/mattdevv/DualSense-Windows
+
+	Licensed under the MIT License (To be found in repository root directory)
+*/
+
+#include <DualSenseWindows/TriggerEffects.h>
+
+#include <MurmurHash3/MurmurHash3.h>
+
+#include <Windows.h>
+#include <string.h>
+
+namespace {
+	// Direct mapped, a few effects per trigger switched between at report rate fit easily
+	const unsigned int CACHE_SIZE = 64;
+
+	struct CacheEntry {
+		DS5W::TriggerEffectDescription description;
+		DS5W::TriggerEffect effect;
+		bool valid;
+	};
+
+	CacheEntry cache[CACHE_SIZE];
+	SRWLOCK cacheLock = SRWLOCK_INIT;
+
+	bool pack(const DS5W::TriggerEffectDescription& description, DS5W::TriggerEffect* ptrEffect)
+	{
+		namespace TE = DS5W::TriggerEffects;
+
+		switch (description.mode) {
+			case DS5W::TriggerEffectMode::Off:
+				*ptrEffect = TE::off();
+				return true;
+
+			case DS5W::TriggerEffectMode::Feedback:
+				*ptrEffect = TE::feedback(description.startPosition, description.strength);
+				return TE::feedbackValid(description.startPosition, description.strength);
+
+			case DS5W::TriggerEffectMode::Weapon:
+				*ptrEffect = TE::weapon(description.startPosition, description.endPosition, description.strength);
+				return TE::weaponValid(description.startPosition, description.endPosition, description.strength);
+
+			case DS5W::TriggerEffectMode::Vibration:
+				*ptrEffect = TE::vibration(description.startPosition, description.strength, description.frequency);
+				return TE::vibrationValid(description.startPosition, description.strength);
+
+			case DS5W::TriggerEffectMode::MultiplePositionFeedback:
+				*ptrEffect = TE::multiplePositionFeedback(description.zones);
+				return TE::multiplePositionFeedbackValid(description.zones);
+
+			case DS5W::TriggerEffectMode::SlopeFeedback:
+				*ptrEffect = TE::slopeFeedback(description.startPosition, description.endPosition, description.strength, description.endStrength);
+				return TE::slopeFeedbackValid(description.startPosition, description.endPosition, description.strength, description.endStrength);
+
+			case DS5W::TriggerEffectMode::MultiplePositionVibration:
+				*ptrEffect = TE::multiplePositionVibration(description.frequency, description.zones);
+				return TE::multiplePositionVibrationValid(description.zones);
+
+			default:
+				return false;
+		}
+	}
+}
+
+DS5W_API DS5W_ReturnValue DS5W::compileTriggerEffect(const DS5W::TriggerEffectDescription* ptrDescription, DS5W::TriggerEffect* ptrEffect)
+{
+	// Check pointer
+	if (!ptrDescription || !ptrEffect) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	// Description is all bytes, no padding to hash
+	uint32_t hash;
+	MurmurHash3_x86_32(ptrDescription, sizeof(DS5W::TriggerEffectDescription), 0, &hash);
+	CacheEntry& entry = cache[hash % CACHE_SIZE];
+
+	// Hit costs one copy
+	AcquireSRWLockShared(&cacheLock);
+	const bool hit = entry.valid && memcmp(&entry.description, ptrDescription, sizeof(DS5W::TriggerEffectDescription)) == 0;
+	if (hit) {
+		*ptrEffect = entry.effect;
+	}
+	ReleaseSRWLockShared(&cacheLock);
+
+	if (hit) {
+		return DS5W_OK;
+	}
+
+	DS5W::TriggerEffect effect;
+	if (!pack(*ptrDescription, &effect)) {
+		return DS5W_E_INVALID_ARGS;
+	}
+
+	AcquireSRWLockExclusive(&cacheLock);
+	entry.description = *ptrDescription;
+	entry.effect = effect;
+	entry.valid = true;
+	ReleaseSRWLockExclusive(&cacheLock);
+
+	*ptrEffect = effect;
+	return DS5W_OK;
+}